@@ -0,0 +1,133 @@
+#include "bench/corpus.hh"
+
+#include "preprocess/base64.hh"
+
+#include <cmath>
+
+namespace bench {
+
+namespace {
+const char *const kSyllables[] = {"ka", "to", "ri", "en", "the", "an", "qu", "ion", "er", "ma", "lo", "st", "in", "ve", "sa", "di", "ch", "or", "un", "ba"};
+const char *const kForeign[] = {"при", "вет", "мир", "λόγ", "ος", "κό", "σμος", "世界", "你好", "東京", "日本語", "مرحبا", "سلام", "한국", "über", "señor", "façade"};
+const char *const kEntities[] = {"&amp;", "&lt;", "&gt;", "&quot;", "&#39;", "&eacute;", "&#x2014;", "&nbsp;"};
+const char *const kPunctuation[] = {".", ",", "!", "?", ";", ":", "\"", "(", ")"};
+const std::size_t kRecent = 1000;
+
+template <class T, std::size_t N> std::size_t Count(T (&)[N]) { return N; }
+} // namespace
+
+Generator::Generator(const CorpusOptions &options) : options_(options), random_(options.seed) {
+  words_.reserve(options_.vocabulary);
+  for (std::size_t i = 0; i < options_.vocabulary; ++i) {
+    std::string word;
+    std::size_t syllables = 1 + random_.Below(4);
+    for (std::size_t s = 0; s < syllables; ++s) {
+      word += kSyllables[random_.Below(Count(kSyllables))];
+    }
+    // Some words are capitalized, so truecasing has work to do.
+    if (random_.Chance(0.2)) word[0] = word[0] - 'a' + 'A';
+    words_.push_back(word);
+  }
+  for (std::size_t i = 0; i < options_.vocabulary / 10 + 1; ++i) {
+    foreign_.push_back(std::string(kForeign[random_.Below(Count(kForeign))]) + kForeign[random_.Below(Count(kForeign))]);
+  }
+}
+
+const std::string &Generator::Word() {
+  // Roughly Zipfian: log-uniform rank.
+  std::size_t rank = static_cast<std::size_t>(std::pow(static_cast<double>(words_.size()), random_.Uniform())) - 1;
+  if (random_.Chance(options_.non_latin)) return foreign_[rank % foreign_.size()];
+  return words_[rank];
+}
+
+void Generator::Sentence(std::string &out) {
+  out.clear();
+  if (!recent_.empty() && random_.Chance(options_.duplicates)) {
+    out = recent_[random_.Below(recent_.size())];
+    return;
+  }
+  double mean = random_.Chance(options_.long_lines) ? options_.mean_words * 100 : options_.mean_words;
+  // Geometric number of words, at least one.
+  std::size_t words = 1 + static_cast<std::size_t>(std::log(1.0 - random_.Uniform()) / std::log(1.0 - 1.0 / mean));
+  for (std::size_t i = 0; i < words; ++i) {
+    if (i) out += ' ';
+    if (random_.Chance(options_.entities)) {
+      out += kEntities[random_.Below(Count(kEntities))];
+    } else {
+      out += Word();
+    }
+    if (random_.Chance(0.05)) out += kPunctuation[random_.Below(Count(kPunctuation))];
+  }
+  if (random_.Chance(options_.invalid_utf8)) {
+    out.insert(random_.Below(out.size() + 1), 1, static_cast<char>(0xC0 | random_.Below(2)));
+  }
+  if (recent_.size() < kRecent) {
+    recent_.push_back(out);
+  } else {
+    recent_[random_.Below(kRecent)] = out;
+  }
+}
+
+void Generator::Text(util::FileStream &out) {
+  std::string line;
+  for (uint64_t i = 0; i < options_.lines; ++i) {
+    Sentence(line);
+    out << line << '\n';
+  }
+}
+
+void Generator::TruecaseModel(util::FileStream &out) {
+  for (std::vector<std::string>::const_iterator i = words_.begin(); i != words_.end(); ++i) {
+    std::string lower(*i), upper(*i);
+    lower[0] = (lower[0] >= 'A' && lower[0] <= 'Z') ? lower[0] - 'A' + 'a' : lower[0];
+    upper[0] = (upper[0] >= 'a' && upper[0] <= 'z') ? upper[0] - 'a' + 'A' : upper[0];
+    uint64_t lower_count = 1 + random_.Below(100), upper_count = 1 + random_.Below(100);
+    uint64_t total = lower_count + upper_count;
+    if (lower_count >= upper_count) {
+      out << lower << " (" << lower_count << '/' << total << ") " << upper << " (" << upper_count << '/' << total << ")\n";
+    } else {
+      out << upper << " (" << upper_count << '/' << total << ") " << lower << " (" << lower_count << '/' << total << ")\n";
+    }
+  }
+}
+
+void Generator::WARC(util::FileStream &out) {
+  std::string line, body;
+  uint64_t written = 0;
+  for (uint64_t record = 0; written < options_.lines; ++record) {
+    body = "HTTP/1.1 200 OK\r\nContent-Type: text/html; charset=utf-8\r\n\r\n<html><body>\n";
+    uint64_t paragraphs = 1 + random_.Below(40);
+    for (uint64_t p = 0; p < paragraphs; ++p) {
+      Sentence(line);
+      body += "<p>";
+      body += line;
+      body += "</p>\n";
+    }
+    body += "</body></html>\n";
+    written += paragraphs;
+    out << "WARC/1.0\r\n"
+      "WARC-Type: response\r\n"
+      "WARC-Target-URI: http://example.com/" << record << "\r\n"
+      "Content-Type: application/http; msgtype=response\r\n"
+      "Content-Length: " << body.size() << "\r\n\r\n" << body << "\r\n\r\n";
+  }
+}
+
+void Generator::Base64Documents(util::FileStream &out) {
+  std::string line, document, encoded;
+  uint64_t written = 0;
+  while (written < options_.lines) {
+    document.clear();
+    uint64_t lines = 1 + random_.Below(50);
+    for (uint64_t l = 0; l < lines; ++l) {
+      Sentence(line);
+      document += line;
+      document += '\n';
+    }
+    written += lines;
+    preprocess::base64_encode(document, encoded);
+    out << encoded << '\n';
+  }
+}
+
+} // namespace bench
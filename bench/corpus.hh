@@ -0,0 +1,90 @@
+#pragma once
+// Deterministic synthetic corpora for benchmarking the preprocess tools.
+
+#include "util/file_stream.hh"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+namespace bench {
+
+struct CorpusOptions {
+  uint64_t seed = 1;
+  uint64_t lines = 1000000;
+  // Words per line are geometric with this mean.
+  double mean_words = 20.0;
+  // Fraction of lines that are very long (thousands of bytes).
+  double long_lines = 0.001;
+  // Fraction of lines that repeat an earlier line.
+  double duplicates = 0.2;
+  // Fraction of words from non-Latin scripts: Cyrillic, Greek, CJK, Arabic.
+  double non_latin = 0.05;
+  // Fraction of lines containing invalid UTF-8.
+  double invalid_utf8 = 0.001;
+  // Fraction of words replaced by HTML entities.
+  double entities = 0.01;
+  // Distinct words in the vocabulary.
+  std::size_t vocabulary = 50000;
+};
+
+// Small, fast and, unlike std::*_distribution, identical on every platform.
+class Random {
+  public:
+    explicit Random(uint64_t seed) : state_(seed * 0x9E3779B97F4A7C15ULL + 1) {}
+
+    // splitmix64
+    uint64_t Next() {
+      uint64_t z = (state_ += 0x9E3779B97F4A7C15ULL);
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+      return z ^ (z >> 31);
+    }
+
+    // Uniform in [0, 1).
+    double Uniform() { return (Next() >> 11) * (1.0 / 9007199254740992.0); }
+
+    // Uniform in [0, bound).
+    uint64_t Below(uint64_t bound) { return Next() % bound; }
+
+    bool Chance(double probability) { return Uniform() < probability; }
+
+  private:
+    uint64_t state_;
+};
+
+class Generator {
+  public:
+    explicit Generator(const CorpusOptions &options);
+
+    // One sentence per line.
+    void Text(util::FileStream &out);
+
+    // Moses truecase model for the vocabulary.
+    void TruecaseModel(util::FileStream &out);
+
+    // WARC records with HTML bodies, records lines long in total.
+    void WARC(util::FileStream &out);
+
+    // One base64 encoded document per line, as read by b64filter.
+    void Base64Documents(util::FileStream &out);
+
+  private:
+    void Sentence(std::string &out);
+
+    const std::string &Word();
+
+    CorpusOptions options_;
+
+    Random random_;
+
+    std::vector<std::string> words_;
+    std::vector<std::string> foreign_;
+
+    // Recent lines to draw duplicates from.
+    std::vector<std::string> recent_;
+};
+
+} // namespace bench
@@ -0,0 +1,50 @@
+#include "bench/corpus.hh"
+
+#include "util/file_stream.hh"
+
+#include <iostream>
+#include <string>
+
+#include <boost/program_options.hpp>
+
+int main(int argc, char *argv[]) {
+  namespace po = boost::program_options;
+  bench::CorpusOptions options;
+  std::string kind;
+  po::options_description desc("Writes a deterministic synthetic corpus to stdout");
+  desc.add_options()
+    ("help,h", po::bool_switch(), "Show this help message")
+    ("kind,k", po::value(&kind)->default_value("text"), "text, truecase_model, warc, or base64")
+    ("lines,l", po::value(&options.lines)->default_value(options.lines), "Lines of text to generate")
+    ("seed,s", po::value(&options.seed)->default_value(options.seed), "Random seed")
+    ("mean-words", po::value(&options.mean_words)->default_value(options.mean_words), "Mean words per line")
+    ("long-lines", po::value(&options.long_lines)->default_value(options.long_lines), "Fraction of lines 100 times longer")
+    ("duplicates", po::value(&options.duplicates)->default_value(options.duplicates), "Fraction of lines repeating a recent line")
+    ("non-latin", po::value(&options.non_latin)->default_value(options.non_latin), "Fraction of words in other scripts")
+    ("invalid-utf8", po::value(&options.invalid_utf8)->default_value(options.invalid_utf8), "Fraction of lines with invalid UTF-8")
+    ("entities", po::value(&options.entities)->default_value(options.entities), "Fraction of words that are HTML entities")
+    ("vocabulary", po::value(&options.vocabulary)->default_value(options.vocabulary), "Distinct words");
+  po::variables_map vm;
+  po::store(po::parse_command_line(argc, argv, desc), vm);
+  if (vm["help"].as<bool>()) {
+    std::cerr << desc;
+    return 1;
+  }
+  po::notify(vm);
+
+  bench::Generator generator(options);
+  util::FileStream out(1, 1 << 20);
+  if (kind == "text") {
+    generator.Text(out);
+  } else if (kind == "truecase_model") {
+    generator.TruecaseModel(out);
+  } else if (kind == "warc") {
+    generator.WARC(out);
+  } else if (kind == "base64") {
+    generator.Base64Documents(out);
+  } else {
+    std::cerr << "Unknown kind " << kind << '\n' << desc;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,208 @@
+// Microbenchmarks for the primitives the preprocess tools spend their time in.
+// Run with --help for options.
+#include "preprocess/base64.hh"
+#include "util/compress.hh"
+#include "util/file.hh"
+#include "util/file_piece.hh"
+#include "util/file_stream.hh"
+#include "util/microbench.hh"
+#include "util/murmur_hash.hh"
+#include "util/pcqueue.hh"
+#include "util/probing_hash_table.hh"
+#include "util/string_piece.hh"
+#include "util/tokenize_piece.hh"
+#include "util/utf8.hh"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <stdint.h>
+
+namespace {
+
+using util::microbench::DoNotOptimize;
+
+// Lines of space-separated words with some accented letters, about size bytes.
+std::string Text(std::size_t size) {
+  static const char *const kWords[] = {"the", "Grüße", "Déjà", "vu", "ZEBRA", "naïve", "of", "Straße", "and", "Ωmega"};
+  std::string ret;
+  uint64_t state = 1;
+  std::size_t line = 0;
+  while (ret.size() < size) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    const char *word = kWords[(state >> 33) % (sizeof(kWords) / sizeof(const char*))];
+    ret += word;
+    if (++line % 12 == 0) {
+      ret += '\n';
+    } else {
+      ret += ' ';
+    }
+  }
+  // Truncate on a character boundary and end with a newline.
+  ret.resize(size);
+  while (!ret.empty() && (static_cast<unsigned char>(ret.back()) & 0xC0) == 0x80) ret.pop_back();
+  if (!ret.empty() && static_cast<unsigned char>(ret.back()) >= 0x80) ret.pop_back();
+  if (!ret.empty()) ret.back() = '\n';
+  return ret;
+}
+
+int TempWith(const std::string &contents) {
+  int fd = util::MakeTemp(util::DefaultTempDirectory());
+  util::WriteOrThrow(fd, contents.data(), contents.size());
+  return fd;
+}
+
+UTIL_MICROBENCH(file_piece_read_line) {
+  std::string text(Text(run.Size()));
+  util::scoped_fd file(TempWith(text));
+  while (run.Next()) {
+    util::SeekOrThrow(file.get(), 0);
+    util::FilePiece in(util::DupOrThrow(file.get()));
+    StringPiece line;
+    while (in.ReadLineOrEOF(line)) DoNotOptimize(line);
+  }
+}
+
+UTIL_MICROBENCH(file_stream_write) {
+  std::string text(Text(run.Size()));
+  std::vector<StringPiece> words;
+  for (util::TokenIter<util::SingleCharacter, true> i(text, ' '); i; ++i) words.push_back(*i);
+  util::scoped_fd null(util::CreateOrThrow("/dev/null"));
+  util::FileStream out(null.get());
+  while (run.Next()) {
+    for (const StringPiece &word : words) out << word;
+  }
+  out.flush();
+}
+
+UTIL_MICROBENCH(murmur_hash) {
+  std::string data(Text(run.Size()));
+  while (run.Next()) {
+    DoNotOptimize(util::MurmurHashNative(data.data(), data.size()));
+  }
+}
+
+struct HashEntry {
+  typedef uint64_t Key;
+  uint64_t key;
+  uint64_t GetKey() const { return key; }
+  void SetKey(uint64_t to) { key = to; }
+};
+
+// Size is the number of distinct keys; each iteration inserts or finds one.
+UTIL_MICROBENCH(probing_find_or_insert) {
+  std::vector<uint64_t> keys;
+  for (uint64_t i = 0; i < run.Size(); ++i) {
+    // Keys must be nonzero.
+    keys.push_back(util::MurmurHashNative(&i, sizeof(i)) | 1);
+  }
+  util::AutoProbing<HashEntry, util::IdentityHash> table;
+  HashEntry entry;
+  util::AutoProbing<HashEntry, util::IdentityHash>::MutableIterator it;
+  std::size_t index = 0;
+  run.SetBytes(sizeof(uint64_t));
+  while (run.Next()) {
+    entry.key = keys[index];
+    DoNotOptimize(table.FindOrInsert(entry, it));
+    if (++index == keys.size()) index = 0;
+  }
+}
+
+// Hand pointers from one thread to another through a queue of capacity size.
+UTIL_MICROBENCH(pcqueue) {
+  util::PCQueue<const char*> queue(run.Size());
+  const char data = 'x';
+  run.SetBytes(sizeof(const char*));
+  std::thread consumer([&queue] {
+    const char *got;
+    while (queue.Consume(got)) DoNotOptimize(*got);
+  });
+  while (run.Next()) queue.Produce(&data);
+  queue.Produce(NULL);
+  consumer.join();
+}
+
+UTIL_MICROBENCH(token_iter) {
+  std::string text(Text(run.Size()));
+  while (run.Next()) {
+    for (util::TokenIter<util::SingleCharacter, true> i(text, ' '); i; ++i) DoNotOptimize(*i);
+  }
+}
+
+UTIL_MICROBENCH(token_iter_spaces) {
+  std::string text(Text(run.Size()));
+  while (run.Next()) {
+    for (util::TokenIter<util::BoolCharacter, true> i(text, util::kSpaces); i; ++i) DoNotOptimize(*i);
+  }
+}
+
+UTIL_MICROBENCH(tokenize_bulk) {
+  std::string text(Text(run.Size()));
+  std::vector<StringPiece> tokens;
+  while (run.Next()) {
+    util::Tokenize(text, util::ByteSet::Spaces(), tokens);
+    DoNotOptimize(tokens.data());
+  }
+}
+
+UTIL_MICROBENCH(utf8_is_utf8) {
+  std::string text(Text(run.Size()));
+  while (run.Next()) DoNotOptimize(utf8::IsUTF8(text));
+}
+
+UTIL_MICROBENCH(utf8_to_lower) {
+  std::string text(Text(run.Size())), out;
+  while (run.Next()) {
+    utf8::ToLower(text, out);
+    DoNotOptimize(out);
+  }
+}
+
+UTIL_MICROBENCH(utf8_normalize) {
+  std::string text(Text(run.Size())), out;
+  while (run.Next()) {
+    utf8::Normalize(text, out);
+    DoNotOptimize(out);
+  }
+}
+
+UTIL_MICROBENCH(base64_encode) {
+  std::string text(Text(run.Size())), out;
+  while (run.Next()) {
+    preprocess::base64_encode(text, out);
+    DoNotOptimize(out);
+  }
+}
+
+UTIL_MICROBENCH(base64_decode) {
+  std::string encoded, out;
+  preprocess::base64_encode(Text(run.Size()), encoded);
+  run.SetBytes(encoded.size());
+  while (run.Next()) {
+    preprocess::base64_decode(encoded, out);
+    DoNotOptimize(out);
+  }
+}
+
+#ifdef HAVE_ZLIB
+// Bytes are uncompressed.
+UTIL_MICROBENCH(read_compressed_gzip) {
+  std::string text(Text(run.Size())), compressed;
+  util::GZCompress(text, compressed, 6);
+  util::scoped_fd file(TempWith(compressed));
+  std::vector<char> buffer(65536);
+  util::ReadCompressed in;
+  while (run.Next()) {
+    util::SeekOrThrow(file.get(), 0);
+    in.Reset(util::DupOrThrow(file.get()));
+    while (in.Read(&buffer[0], buffer.size())) {}
+  }
+}
+#endif
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  return util::microbench::Main(argc, argv);
+}
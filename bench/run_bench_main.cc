@@ -0,0 +1,218 @@
+// Runs the preprocess tools on synthetic corpora and reports throughput.
+#include "bench/corpus.hh"
+
+#include "util/file.hh"
+#include "util/file_stream.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <boost/program_options.hpp>
+
+namespace bench {
+namespace {
+
+struct Case {
+  const char *name;
+  // Corpus on stdin: text, valid_text (no invalid UTF-8), warc, or base64.
+  const char *input;
+  // {bin} and {work} are replaced by the directories.
+  std::vector<std::string> args;
+};
+
+const std::vector<Case> &Cases() {
+  static const std::vector<Case> cases = {
+    {"dedupe", "text", {"{bin}/dedupe"}},
+    {"shard", "text", {"{bin}/shard", "--prefix", "{work}/shard.", "--number", "16"}},
+    {"select_latin", "text", {"{bin}/select_latin"}},
+    {"remove_long_lines", "text", {"{bin}/remove_long_lines"}},
+    {"remove_invalid_utf8", "text", {"{bin}/remove_invalid_utf8"}},
+    {"filter", "text", {"{bin}/filter", "--utf8", "--max-length", "2000", "--latin", "--dedupe"}},
+    {"vocab", "text", {"{bin}/vocab"}},
+    {"unescape_html", "text", {"{bin}/unescape_html"}},
+    {"process_unicode", "valid_text", {"{bin}/process_unicode", "-l", "en", "--flatten", "--normalize", "--lower"}},
+    {"truecase", "text", {"{bin}/truecase", "--model", "{work}/truecase.model"}},
+    {"cache", "text", {"{bin}/cache", "cat"}},
+    {"foldfilter", "valid_text", {"{bin}/foldfilter", "-w", "80", "cat"}},
+    {"b64filter", "base64", {"{bin}/b64filter", "cat"}},
+    {"docenc", "base64", {"{bin}/docenc", "-d"}},
+    {"warc_parallel", "warc", {"{bin}/warc_parallel", "-j", "2", "--", "cat"}},
+  };
+  return cases;
+}
+
+std::string Substitute(std::string arg, const std::string &bin, const std::string &work) {
+  const std::pair<const char*, const std::string*> replacements[] = {{"{bin}", &bin}, {"{work}", &work}};
+  for (const auto &r : replacements) {
+    std::size_t found;
+    while ((found = arg.find(r.first)) != std::string::npos) {
+      arg.replace(found, strlen(r.first), *r.second);
+    }
+  }
+  return arg;
+}
+
+struct Corpus {
+  std::string path;
+  uint64_t bytes;
+  uint64_t lines;
+};
+
+Corpus Generate(CorpusOptions options, const std::string &work, const std::string &kind) {
+  Corpus ret;
+  ret.path = work + "/" + kind;
+  {
+    if (kind == "valid_text") options.invalid_utf8 = 0.0;
+    Generator generator(options);
+    util::FileStream out(util::CreateOrThrow(ret.path.c_str()), 1 << 20);
+    if (kind == "text" || kind == "valid_text") generator.Text(out);
+    if (kind == "warc") generator.WARC(out);
+    if (kind == "base64") generator.Base64Documents(out);
+    if (kind == "truecase.model") generator.TruecaseModel(out);
+  }
+  util::scoped_fd in(util::OpenReadOrThrow(ret.path.c_str()));
+  ret.bytes = 0;
+  ret.lines = 0;
+  std::vector<char> buf(1 << 20);
+  std::size_t got;
+  while ((got = util::ReadOrEOF(in.get(), &buf[0], buf.size()))) {
+    ret.bytes += got;
+    for (std::size_t i = 0; i < got; ++i) ret.lines += (buf[i] == '\n');
+  }
+  return ret;
+}
+
+struct Measurement {
+  double wall, user, system;
+  long max_rss_kb;
+  int status;
+};
+
+int OpenAppend(const std::string &name) {
+  int ret = open(name.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0666);
+  UTIL_THROW_IF(ret == -1, util::ErrnoException, "Opening " << name << " to append");
+  return ret;
+}
+
+Measurement Run(const std::vector<std::string> &args, const std::string &input, bool verbose) {
+  std::vector<char*> argv;
+  for (const std::string &a : args) argv.push_back(const_cast<char*>(a.c_str()));
+  argv.push_back(NULL);
+  util::scoped_fd in(util::OpenReadOrThrow(input.c_str()));
+  util::scoped_fd null_write(open("/dev/null", O_WRONLY));
+  UTIL_THROW_IF(null_write.get() == -1, util::ErrnoException, "Opening /dev/null");
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  pid_t pid = fork();
+  UTIL_THROW_IF(pid == -1, util::ErrnoException, "Fork failed");
+  if (pid == 0) {
+    dup2(in.get(), STDIN_FILENO);
+    dup2(null_write.get(), STDOUT_FILENO);
+    if (!verbose) dup2(null_write.get(), STDERR_FILENO);
+    execv(argv[0], &argv[0]);
+    _exit(127);
+  }
+  Measurement ret;
+  struct rusage usage;
+  int status;
+  UTIL_THROW_IF(-1 == wait4(pid, &status, 0, &usage), util::ErrnoException, "wait4 for " << args[0]);
+  ret.wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  ret.user = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6;
+  ret.system = usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+  ret.max_rss_kb = usage.ru_maxrss;
+  ret.status = WIFEXITED(status) ? WEXITSTATUS(status) : 256;
+  return ret;
+}
+
+} // namespace
+} // namespace bench
+
+int main(int argc, char *argv[]) {
+  namespace po = boost::program_options;
+  bench::CorpusOptions options;
+  std::string bin, work, json;
+  std::vector<std::string> only;
+  unsigned repeat;
+  bool verbose;
+  po::options_description desc("Benchmarks the preprocess tools on synthetic corpora");
+  desc.add_options()
+    ("help,h", po::bool_switch(), "Show this help message")
+    ("bin,b", po::value(&bin), "Directory with the tools.  Default: the directory containing this program")
+    ("work,w", po::value(&work)->default_value("bench_work"), "Directory for corpora and outputs")
+    ("json,o", po::value(&json), "Append results as JSON lines to this file.  Default: stdout")
+    ("lines,l", po::value(&options.lines)->default_value(options.lines), "Lines in each corpus")
+    ("seed,s", po::value(&options.seed)->default_value(options.seed), "Random seed for the corpora")
+    ("repeat,r", po::value(&repeat)->default_value(1), "Runs of each tool")
+    ("only", po::value(&only)->multitoken(), "Only run these cases")
+    ("verbose,v", po::bool_switch(&verbose), "Show the tools' stderr");
+  po::variables_map vm;
+  po::store(po::parse_command_line(argc, argv, desc), vm);
+  if (vm["help"].as<bool>()) {
+    std::cerr << desc;
+    return 1;
+  }
+  po::notify(vm);
+  if (bin.empty()) {
+    std::string self(argv[0]);
+    std::size_t slash = self.rfind('/');
+    bin = slash == std::string::npos ? "." : self.substr(0, slash);
+  }
+  mkdir(work.c_str(), 0777);
+
+  std::cerr << "Generating " << options.lines << " line corpora in " << work << std::endl;
+  std::map<std::string, bench::Corpus> corpora;
+  for (const char *kind : {"text", "valid_text", "warc", "base64", "truecase.model"}) {
+    corpora[kind] = bench::Generate(options, work, kind);
+  }
+
+  util::FileStream out(json.empty() ? 1 : bench::OpenAppend(json));
+  int failures = 0;
+  long now = static_cast<long>(std::time(NULL));
+  for (const bench::Case &c : bench::Cases()) {
+    if (!only.empty() && std::find(only.begin(), only.end(), c.name) == only.end()) continue;
+    std::vector<std::string> args;
+    for (const std::string &a : c.args) args.push_back(bench::Substitute(a, bin, work));
+    if (access(args[0].c_str(), X_OK)) {
+      std::cerr << c.name << ": " << args[0] << " not found, skipping" << std::endl;
+      continue;
+    }
+    const bench::Corpus &corpus = corpora[c.input];
+    for (unsigned r = 0; r < repeat; ++r) {
+      bench::Measurement m = bench::Run(args, corpus.path, verbose);
+      if (m.status) ++failures;
+      double mb = corpus.bytes / 1e6;
+      std::cerr << c.name << ": " << (mb / m.wall) << " MB/s, " << (corpus.lines / m.wall) << " lines/s, "
+        << (m.user + m.system) << " s CPU, " << (m.max_rss_kb / 1024) << " MiB peak RSS";
+      if (m.status) std::cerr << ", exit status " << m.status;
+      std::cerr << std::endl;
+      out << "{\"time\":" << now
+        << ",\"case\":\"" << c.name << '"'
+        << ",\"input\":\"" << c.input << '"'
+        << ",\"input_bytes\":" << corpus.bytes
+        << ",\"input_lines\":" << corpus.lines
+        << ",\"wall_seconds\":" << m.wall
+        << ",\"user_seconds\":" << m.user
+        << ",\"system_seconds\":" << m.system
+        << ",\"mb_per_second\":" << (mb / m.wall)
+        << ",\"lines_per_second\":" << (corpus.lines / m.wall)
+        << ",\"max_rss_kb\":" << m.max_rss_kb
+        << ",\"exit_status\":" << m.status << "}\n";
+      out.flush();
+    }
+  }
+  return failures ? 1 : 0;
+}
@@ -1,99 +1,94 @@
+#include "case_model.hh"
+#include "line_parallel.hh"
+
 #include "util/file_stream.hh"
 #include "util/file_piece.hh"
-#include "util/murmur_hash.hh"
-#include "util/mutable_vocab.hh"
+#include "util/string_to_integer.hh"
 #include "util/tokenize_piece.hh"
 #include "util/utf8.hh"
 
-#define BOOST_LEXICAL_CAST_ASSUME_C_LOCALE
-#include <boost/lexical_cast.hpp>
-#include <boost/unordered_map.hpp>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <stdlib.h>
+#include <string.h>
 
 namespace {
-void SplitLine(util::FilePiece &from, std::vector<StringPiece> &to) {
-  to.clear();
-  for (util::TokenIter<util::SingleCharacter, true> i(from.ReadLine(), ' '); i; ++i) {
-    to.push_back(*i);
-  }
+const util::ByteSet kSpace(" ");
+
+void SplitLine(StringPiece line, std::vector<StringPiece> &to) {
+  util::Tokenize(line, kSpace, to);
 }
 
-bool SameLine(util::FilePiece &f) {
-  while (true) {
-    switch(f.peek()) {
-      case '\n':
-        f.get();
-        return false;
-      case ' ':
-      case '\t':
-        f.get();
-        continue;
-      default:
-        return true;
-    }
-  }
+unsigned long ParseIndex(StringPiece token, std::size_t line) {
+  UTIL_THROW_IF2(token.empty(), "Expected number for alignment at line " << line);
+  uint64_t ret;
+  const char *end = token.data() + token.size();
+  UTIL_THROW_IF2(util::ParseDecimal(token.data(), end, ret) != end, "Expected number for alignment, not " << token << " at line " << line);
+  return ret;
 }
+
+// Per-thread state: recase the target side of source, target, alignment lines.
+class Recaser {
+  public:
+    explicit Recaser(const preprocess::CaseModel &model) : model_(model) {}
+
+    template <class Stream> void operator()(std::size_t line, const StringPiece *lines, Stream &out) {
+      SplitLine(lines[0], source_words_);
+      SplitLine(lines[1], target_words_);
+      util::TokenIter<util::BoolCharacter, true> token(lines[2], util::kSpaces);
+      ParseIndex(*token, line);
+      UTIL_THROW_IF2("|||" != *++token, "Expected |||");
+      for (++token; token; ++token) {
+        const char *dash = static_cast<const char*>(memchr(token->data(), '-', token->size()));
+        UTIL_THROW_IF2(!dash, "Bad alignment " << *token << " at line " << line);
+        unsigned long first = ParseIndex(StringPiece(token->data(), dash - token->data()), line);
+        unsigned long second = ParseIndex(StringPiece(dash + 1, token->data() + token->size() - dash - 1), line);
+        UTIL_THROW_IF2(first >= source_words_.size(), "Index " << first << " too high for source text at line " << line << " which has size " << source_words_.size());
+        UTIL_THROW_IF2(second >= target_words_.size(), "Index " << second << " too high for target text at line " << line << " which has size " << target_words_.size());
+        utf8::ToLower(target_words_[second], lowered_);
+        StringPiece best;
+        if (model_.Find(preprocess::CaseModelKey(source_words_[first], lowered_), best)) {
+          target_words_[second] = best;
+        }
+      }
+      for (std::vector<StringPiece>::const_iterator i = target_words_.begin(); i != target_words_.end(); ++i) {
+        if (i != target_words_.begin()) out << ' ';
+        out << *i;
+      }
+      out << '\n';
+    }
+
+  private:
+    const preprocess::CaseModel &model_;
+
+    std::vector<StringPiece> source_words_, target_words_;
+    std::string lowered_;
+};
 } // namespace
 
 int main(int argc, char *argv[]) {
+  std::size_t threads = 1;
+  if (argc == 7 && (!strcmp(argv[1], "-j") || !strcmp(argv[1], "--jobs"))) {
+    threads = strtoul(argv[2], NULL, 10);
+    argc -= 2;
+    argv += 2;
+  }
   if (argc != 5) {
-    std::cerr << argv[0] << " alignment source target model" << std::endl;
+    std::cerr << argv[0] << " [-j threads] alignment source target model" << std::endl;
+    std::cerr << "The model is the text or --binary output of train_case." << std::endl;
     return 1;
   }
-  util::FilePiece align(argv[1]), source_file(argv[2]), target_file(argv[3]), model(argv[4]);
-
-  util::MutableVocab vocab;
-  boost::unordered_map<uint64_t, uint32_t> best;
-  while (true) {
-    uint64_t key;
-    try {
-      key = model.ReadULong();
-    } catch (const util::EndOfFileException &e) { break; }
-    uint64_t max_count = 0;
-    StringPiece best_word;
-    for (util::TokenIter<util::SingleCharacter, true> pair(model.ReadLine(), '\t'); pair; ++pair) {
-      util::TokenIter<util::SingleCharacter> spaces(*pair, ' ');
-      StringPiece word(*spaces);
-      uint64_t count = boost::lexical_cast<uint64_t>(*++spaces);
-      if (count > max_count) {
-        max_count = count;
-        best_word = word;
-      }
-      best[key] = vocab.FindOrInsert(best_word);
-    }
-  }
+  util::FilePiece align(argv[1]), source_file(argv[2]), target_file(argv[3]);
+  preprocess::CaseModel model(argv[4]);
 
   std::cerr << "Read model." << std::endl;
 
-  std::vector<StringPiece> source_words, target_words;
-  std::string lowered;
+  std::vector<util::FilePiece*> files;
+  files.push_back(&source_file);
+  files.push_back(&target_file);
+  files.push_back(&align);
   util::FileStream out(1);
-  for (std::size_t line = 0; ; ++line) {
-    try {
-      SplitLine(source_file, source_words);
-    } catch (const util::EndOfFileException &e) { break; }
-    SplitLine(target_file, target_words);
-    align.ReadULong();
-    UTIL_THROW_IF2("|||" != align.ReadDelimited(), "Expected |||");
-    while (SameLine(align)) {
-      unsigned long first = align.ReadULong();
-      UTIL_THROW_IF2(align.get() != '-', "Bad alignment");
-      UTIL_THROW_IF2(align.peek() < '0' || align.peek() > '9', "Expected number for alignment, not " << align.peek());
-      unsigned long second = align.ReadULong();
-      UTIL_THROW_IF2(first >= source_words.size(), "Index " << first << " too high for source text at line " << line << " which has size " << source_words.size());
-      UTIL_THROW_IF2(second >= target_words.size(), "Index " << second << " too high for target text at line " << line << " which has size " << target_words.size());
-      utf8::ToLower(target_words[second], lowered);
-      StringPiece source(source_words[first]);
-      uint64_t key = util::MurmurHash64A(lowered.data(), lowered.size(), util::MurmurHash64A(source.data(), source.size()));
-      boost::unordered_map<uint64_t, uint32_t>::const_iterator found = best.find(key);
-      if (found != best.end()) {
-        target_words[second] = vocab.String(found->second);
-      }
-    }
-    std::vector<StringPiece>::const_iterator i = target_words.begin();
-    if (i != target_words.end()) out << *i;
-    for (++i; i != target_words.end(); ++i) {
-      out << ' ' << *i;
-    }
-    out << '\n';
-  }
+  preprocess::ParallelAlignedLines(files, out, Recaser(model), threads);
 }
@@ -7,6 +7,7 @@
 #include "util/murmur_hash.hh"
 #include "util/pcqueue.hh"
 #include "util/pool.hh"
+#include "util/stats.hh"
 #include "util/string_piece.hh"
 
 #include <string>
@@ -45,7 +46,12 @@ private:
   size_t hash;
 };
 
-void Input(util::UnboundedSingleQueue<QueueEntry> &queue, util::scoped_fd &process_input, std::unordered_map<uint64_t, StringPiece> &cache, std::size_t flush_rate, Options &options) {
+void Input(util::UnboundedSingleQueue<QueueEntry> &queue, util::scoped_fd &process_input, std::unordered_map<uint64_t, StringPiece> &cache, std::size_t flush_rate, Options &options, util::Stats &stats) {
+  util::LineCounters counters(stats);
+  util::StatsCounter &hits = stats.Counter("cache_hits"), &misses = stats.Counter("cache_misses");
+  util::StatsCounter &queued = stats.Counter("queued");
+  // Time spent blocked writing to the child because it is not keeping up.
+  util::StatsCounter &child_write_ns = stats.Counter("child_write_ns");
   QueueEntry q_entry;
   {
     util::FileStream process(process_input.get());
@@ -55,23 +61,31 @@ void Input(util::UnboundedSingleQueue<QueueEntry> &queue, util::scoped_fd &proce
     std::vector<FieldRange> indices;
     ParseFields(options.key.c_str(), indices);
     for (StringPiece l : util::FilePiece(STDIN_FILENO)) {
+      counters.Read(l);
       HashWithSeed callback= HashWithSeed();
       RangeFields(l, indices, options.field_separator, callback);
       entry.first = callback.get_hash();
       std::pair<std::unordered_map<uint64_t, StringPiece>::iterator, bool> res(cache.insert(entry));
       if (res.second) {
+        ++misses;
         // New entry.  Send to captive process.
+        util::StatsTimer timer(child_write_ns);
         process << l << '\n';
         // Guarantee we flush to process every so often.
         if (!--flush_count) {
           process.flush();
           flush_count = flush_rate;
         }
+      } else {
+        ++hits;
       }
       // Pointer to hash table entry.
       q_entry.value = &res.first->second;
+      ++queued;
       queue.Produce(q_entry);
     }
+    util::StatsTimer timer(child_write_ns);
+    process.flush();
   }
   process_input.reset();
   // Poison.
@@ -81,7 +95,12 @@ void Input(util::UnboundedSingleQueue<QueueEntry> &queue, util::scoped_fd &proce
 
 // Read from queue.  If it's not in the cache, read the result from the captive
 // process.
-void Output(util::UnboundedSingleQueue<QueueEntry> &queue, util::scoped_fd &process_output) {
+void Output(util::UnboundedSingleQueue<QueueEntry> &queue, util::scoped_fd &process_output, util::Stats &stats) {
+  util::LineCounters counters(stats);
+  util::StatsCounter &queued = stats.Counter("queued"), &queue_depth = stats.Counter("queue_depth");
+  // Time spent waiting for the child to produce output.
+  util::StatsCounter &child_read_ns = stats.Counter("child_read_ns");
+  uint64_t dequeued = 0;
   util::FileStream out(STDOUT_FILENO);
   util::FilePiece in(process_output.release());
   // We'll allocate the cached strings into a pool.
@@ -91,16 +110,22 @@ void Output(util::UnboundedSingleQueue<QueueEntry> &queue, util::scoped_fd &proc
   string_pool.Allocate(1);
   QueueEntry q;
   while (queue.Consume(q).value) {
+    queue_depth.Set(queued.Get() - ++dequeued);
     StringPiece &value = *q.value;
     if (!value.data()) {
       // New entry, not cached.
-      StringPiece got = in.ReadLine();
+      StringPiece got;
+      {
+        util::StatsTimer timer(child_read_ns);
+        got = in.ReadLine();
+      }
       // Allocate memory to store a copy of the line.
       char *copy_to = (char*)string_pool.Allocate(got.size());
       memcpy(copy_to, got.data(), got.size());
       value = StringPiece(copy_to, got.size());
     }
     out << value << '\n';
+    counters.Wrote(value);
   }
 }
 
@@ -132,14 +157,16 @@ int main(int argc, char *argv[]) {
   }
   ParseArgs(skip_args, argv, opt);
 
+  util::Stats stats;
+  stats.ReportFromEnvironment();
   util::scoped_fd in, out;
   pid_t child = Launch(argv + skip_args, in, out);
   util::UnboundedSingleQueue<QueueEntry> queue;
   // This cache has to be alive for Input and Output because Input passes pointers through the queue.
   std::unordered_map<uint64_t, StringPiece> cache;
   // Run Input and Output concurrently.  Arbitrarily, we'll do Output in the main thread.
-  std::thread input([&queue, &in, &cache, kFlushRate, &opt]{Input(queue, in, cache, kFlushRate, opt);});
-  Output(queue, out);
+  std::thread input([&queue, &in, &cache, kFlushRate, &opt, &stats]{Input(queue, in, cache, kFlushRate, opt, stats);});
+  Output(queue, out, stats);
   input.join();
   return Wait(child);
 }
@@ -2,6 +2,7 @@
 
 #include "util/exception.hh"
 #include "util/file.hh"
+#include "util/splice_writer.hh"
 
 #include <signal.h>
 #ifdef __linux__
@@ -28,6 +29,9 @@ pid_t Launch(char *argv[], util::scoped_fd &in, util::scoped_fd &out) {
   util::scoped_fd process_in, process_out;
   Pipe(process_in, in);
   Pipe(out, process_out);
+  // Larger pipes mean fewer context switches between parent and child.
+  util::SetPipeSize(in.get(), util::kPipeSize);
+  util::SetPipeSize(out.get(), util::kPipeSize);
   pid_t pid = fork();
   UTIL_THROW_IF(pid == -1, util::ErrnoException, "Fork failed");
   if (pid == 0) {
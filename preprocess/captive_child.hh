@@ -7,6 +7,7 @@ namespace util { class scoped_fd; }
 namespace preprocess {
 
 // Launch a child process.  The child's stdin and stdout pipes will be returned as in and out.
+// Both pipes are grown to util::kPipeSize where the platform allows.
 pid_t Launch(char *argv[], util::scoped_fd &in, util::scoped_fd &out);
 
 // Wait for a child to finish and return an appropriate status for it.
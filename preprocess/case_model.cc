@@ -0,0 +1,86 @@
+#include "preprocess/case_model.hh"
+
+#include "util/file.hh"
+#include "util/file_piece.hh"
+#include "util/string_stream.hh"
+#include "util/string_to_integer.hh"
+#include "util/tokenize_piece.hh"
+
+#include <string.h>
+
+namespace preprocess {
+
+const char kCaseModelMagic[8] = {'\0', 'c', 'a', 's', 'e', 'm', 'd', '1'};
+
+void CaseModelBuilder::Add(uint64_t key, StringPiece best) {
+  StringEntry string_entry;
+  string_entry.key = util::MurmurHashNative(best.data(), best.size());
+  string_entry.offset = strings_.size();
+  util::AutoProbing<StringEntry, util::IdentityHash>::MutableIterator found;
+  if (!dedupe_.FindOrInsert(string_entry, found)) {
+    strings_.append(best.data(), best.size());
+  }
+  CaseModelEntry entry;
+  entry.key = key;
+  entry.offset = found->offset;
+  entry.length = best.size();
+  table_.Insert(entry);
+}
+
+CaseModel::CaseModel(const char *file) {
+  util::scoped_fd fd(util::OpenReadOrThrow(file));
+  uint64_t size = util::SizeFile(fd.get());
+  CaseModelHeader header;
+  if (size != util::kBadSize && size >= sizeof(CaseModelHeader)) {
+    util::ReadOrThrow(fd.get(), &header, sizeof(CaseModelHeader));
+    if (!memcmp(header.magic, kCaseModelMagic, sizeof(kCaseModelMagic))) {
+      // Shared mapping so concurrent processes use the same page cache.
+      util::MapRead(util::POPULATE_OR_LAZY, fd.get(), 0, size, mapped_);
+      View(mapped_.begin(), size);
+      return;
+    }
+  }
+  // Text models can be compressed or piped, so let FilePiece reopen it.
+  LoadText(file);
+}
+
+void CaseModel::LoadText(const char *file) {
+  util::FilePiece model(file);
+  CaseModelBuilder builder;
+  while (true) {
+    uint64_t key;
+    try {
+      key = model.ReadULong();
+    } catch (const util::EndOfFileException &e) { break; }
+    uint64_t max_count = 0;
+    StringPiece best_word;
+    for (util::TokenIter<util::SingleCharacter, true> pair(model.ReadLine(), '\t'); pair; ++pair) {
+      util::TokenIter<util::SingleCharacter> spaces(*pair, ' ');
+      StringPiece word(*spaces);
+      StringPiece count_str(*++spaces);
+      uint64_t count;
+      const char *end = count_str.data() + count_str.size();
+      UTIL_THROW_IF2(count_str.empty() || util::ParseDecimal(count_str.data(), end, count) != end, "Bad count " << count_str << " in model " << file);
+      if (count > max_count) {
+        max_count = count;
+        best_word = word;
+      }
+    }
+    if (max_count) builder.Add(key, best_word);
+  }
+  util::StringStream image;
+  builder.Write(image);
+  image.swap(built_);
+  View(built_.data(), built_.size());
+}
+
+void CaseModel::View(const char *image, uint64_t size) {
+  CaseModelHeader header;
+  memcpy(&header, image, sizeof(CaseModelHeader));
+  UTIL_THROW_IF2(header.entry_size != sizeof(CaseModelEntry), "Binary case model was compiled on an incompatible platform.");
+  UTIL_THROW_IF2(sizeof(CaseModelHeader) + header.table_bytes + header.strings_bytes != size, "Binary case model has size " << size << " but the header implies " << (sizeof(CaseModelHeader) + header.table_bytes + header.strings_bytes) << "; is it truncated?");
+  table_ = Table(const_cast<char*>(image) + sizeof(CaseModelHeader), header.table_bytes);
+  strings_ = image + sizeof(CaseModelHeader) + header.table_bytes;
+}
+
+} // namespace preprocess
@@ -0,0 +1,122 @@
+#pragma once
+// Binary word-pair casing model written by train_case and read by apply_case.
+
+#include "util/file_stream.hh"
+#include "util/mmap.hh"
+#include "util/murmur_hash.hh"
+#include "util/probing_hash_table.hh"
+#include "util/string_piece.hh"
+
+#include <string>
+
+#include <string.h>
+
+#include <stdint.h>
+
+namespace preprocess {
+
+// Key for a cased source word aligned to a target word.
+inline uint64_t CaseModelKey(StringPiece source, StringPiece lowered_target) {
+  return util::MurmurHash64A(lowered_target.data(), lowered_target.size(), util::MurmurHash64A(source.data(), source.size()));
+}
+
+#pragma pack(push)
+#pragma pack(4)
+struct CaseModelEntry {
+  typedef uint64_t Key;
+  uint64_t GetKey() const { return key; }
+  void SetKey(uint64_t to) { key = to; }
+
+  uint64_t key;
+  // Location of the best cased target in the strings section.
+  uint64_t offset;
+  uint32_t length;
+};
+#pragma pack(pop)
+
+/* Binary layout: this header, the hash table buckets, then the strings.  The
+ * buckets use the same layout as util::AutoProbing so the file can be mapped
+ * and searched in place.  It is platform-specific.
+ */
+struct CaseModelHeader {
+  char magic[8];
+  // Guards against loading a model compiled on a different platform.
+  uint64_t entry_size;
+  uint64_t table_bytes;
+  uint64_t strings_bytes;
+};
+
+extern const char kCaseModelMagic[8];
+
+// Accumulate the best casing for each key, then write a binary model.
+class CaseModelBuilder {
+  public:
+    CaseModelBuilder() {}
+
+    // Each key should be added once.
+    void Add(uint64_t key, StringPiece best);
+
+    template <class Stream> void Write(Stream &out) const {
+      CaseModelHeader header;
+      memcpy(header.magic, kCaseModelMagic, sizeof(kCaseModelMagic));
+      header.entry_size = sizeof(CaseModelEntry);
+      header.table_bytes = (table_.RawEnd() - table_.RawBegin()) * sizeof(CaseModelEntry);
+      header.strings_bytes = strings_.size();
+      out.write(&header, sizeof(CaseModelHeader));
+      out.write(table_.RawBegin(), header.table_bytes);
+      out.write(strings_.data(), strings_.size());
+    }
+
+    void Write(int fd) const {
+      util::FileStream out(fd);
+      Write(out);
+    }
+
+  private:
+    typedef util::AutoProbing<CaseModelEntry, util::IdentityHash> Table;
+    Table table_;
+
+    // Many keys share the same best casing, so strings are stored once.
+    struct StringEntry {
+      typedef uint64_t Key;
+      uint64_t GetKey() const { return key; }
+      void SetKey(uint64_t to) { key = to; }
+
+      uint64_t key;
+      uint64_t offset;
+    };
+    util::AutoProbing<StringEntry, util::IdentityHash> dedupe_;
+
+    std::string strings_;
+};
+
+// Read-only model for apply_case.  Loads the text or binary output of train_case.
+class CaseModel {
+  public:
+    explicit CaseModel(const char *file);
+
+    // Returns false for unknown keys.
+    bool Find(uint64_t key, StringPiece &best) const {
+      const CaseModelEntry *entry;
+      if (!table_.Find(key, entry)) return false;
+      best = StringPiece(strings_ + entry->offset, entry->length);
+      return true;
+    }
+
+  private:
+    void LoadText(const char *file);
+
+    // Point table_ and strings_ into a complete binary image.
+    void View(const char *image, uint64_t size);
+
+    // Backing for text models: the binary image built in memory.
+    std::string built_;
+    // Backing for binary models.
+    util::scoped_memory mapped_;
+
+    typedef util::ProbingHashTable<CaseModelEntry, util::IdentityHash, std::equal_to<uint64_t>, util::Power2Mod> Table;
+    Table table_;
+    const char *strings_;
+};
+
+} // namespace preprocess
@@ -9,6 +9,7 @@
 #include "util/murmur_hash.hh"
 #include "util/probing_hash_table.hh"
 #include "util/scoped.hh"
+#include "util/stats.hh"
 #include "util/utf8.hh"
 
 #include <iostream>
@@ -55,6 +56,14 @@ int main(int argc, char *argv[]) {
     return 1;
   }
   try {
+    util::Stats stats;
+    util::LineCounters counters(stats);
+    util::StatsCounter &dropped_delimiter = stats.Counter("dropped_delimiter");
+    util::StatsCounter &dropped_duplicate = stats.Counter("dropped_duplicate");
+    util::StatsCounter &dropped_utf8 = stats.Counter("dropped_invalid_utf8");
+    util::StatsCounter &table_entries = stats.Counter("hash_table_entries");
+    stats.ReportFromEnvironment();
+
     Table table;
     StringPiece l;
 
@@ -71,14 +80,23 @@ int main(int argc, char *argv[]) {
     util::FileStream out(1);
     util::FilePiece in(0, "stdin", &std::cerr);
     while (in.ReadLineOrEOF(l)) {
+      counters.Read(l);
       l = StripSpaces(l);
       // A line passes if:
       // It does not begin with the magic document delimiter.
       // Its 64-bit hash has not been seen before.
       // and it is valid UTF-8.
-      if (!starts_with(l, remove_line) && IsNewLine(table, l) && utf8::IsUTF8(l)) {
+      if (starts_with(l, remove_line)) {
+        ++dropped_delimiter;
+      } else if (!IsNewLine(table, l)) {
+        ++dropped_duplicate;
+      } else if (!utf8::IsUTF8(l)) {
+        ++dropped_utf8;
+      } else {
         out << l << '\n';
+        counters.Wrote(l);
       }
+      table_entries.Set(table.Size());
     }
   } 
   catch (const std::exception &e) {
@@ -0,0 +1,19 @@
+#include "preprocess/nonbreaking_prefix.hh"
+#include "util/file.hh"
+#include "util/file_piece.hh"
+
+#include <iostream>
+
+// Compile a nonbreaking prefix list so NonbreakingPrefixes can map it.
+int main(int argc, char *argv[]) {
+  if (argc != 3) {
+    std::cerr << "Usage: " << argv[0] << " nonbreaking_prefix.xx nonbreaking_prefix.xx.bin\n"
+      "Compiles a Moses nonbreaking prefix list for constant-time lookup." << std::endl;
+    return 1;
+  }
+  preprocess::NonbreakingPrefixBuilder builder;
+  util::FilePiece in(argv[1]);
+  builder.AddText(in);
+  util::scoped_fd out(util::CreateOrThrow(argv[2]));
+  builder.Write(out.get());
+}
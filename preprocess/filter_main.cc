@@ -0,0 +1,302 @@
+#include "filters.hh"
+#include "parallel_corpus.hh"
+
+#include "util/file_piece.hh"
+#include "util/file_stream.hh"
+#include "util/fixed_array.hh"
+#include "util/pcqueue.hh"
+#include "util/stats.hh"
+#include "util/string_to_integer.hh"
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <stdint.h>
+#include <string.h>
+
+/* Runs a chain of line filters in one process instead of a pipeline like
+ * remove_invalid_utf8 |remove_long_lines |select_latin |dedupe
+ * Filters that only look at the line run on worker threads.  Deduplication
+ * depends on order, so workers only hash and lines are checked against the
+ * table in input order.
+ */
+
+namespace {
+
+enum PassType { kUTF8, kMaxLength, kLatin, kDedupe };
+
+struct Pass {
+  Pass(PassType type_in, std::size_t max_length_in = 0) : type(type_in), max_length(max_length_in), kept(0), dropped(0) {}
+
+  const char *Name() const {
+    switch (type) {
+      case kUTF8: return "--utf8";
+      case kMaxLength: return "--max-length";
+      case kLatin: return "--latin";
+      case kDedupe: return "--dedupe";
+    }
+    return "unknown";
+  }
+
+  // Suffix for statistics.
+  const char *StatName() const {
+    switch (type) {
+      case kUTF8: return "invalid_utf8";
+      case kMaxLength: return "too_long";
+      case kLatin: return "not_latin";
+      case kDedupe: return "duplicate";
+    }
+    return "unknown";
+  }
+
+  PassType type;
+  std::size_t max_length;
+  uint64_t kept, dropped;
+};
+
+// What the workers learned about a line.
+struct Verdict {
+  // Index of the first filter that rejected the line, or the number of filters.
+  std::size_t rejected_by;
+  // Dedupe::Key if the line reached the --dedupe filter.
+  uint64_t key;
+};
+
+// Evaluates the filters that only look at the line, stopping at the first rejection.
+class Evaluator {
+  public:
+    explicit Evaluator(const std::vector<Pass> &passes) : passes_(passes) {}
+
+    void operator()(const StringPiece &line, Verdict &verdict) const {
+      verdict.key = 0;
+      for (verdict.rejected_by = 0; verdict.rejected_by < passes_.size(); ++verdict.rejected_by) {
+        const Pass &pass = passes_[verdict.rejected_by];
+        switch (pass.type) {
+          case kUTF8:
+            if (!preprocess::UTF8Filter()(line)) return;
+            break;
+          case kMaxLength:
+            if (!preprocess::LengthFilter(pass.max_length)(line)) return;
+            break;
+          case kLatin:
+            if (!preprocess::SelectLatin()(line)) return;
+            break;
+          case kDedupe:
+            verdict.key = preprocess::Dedupe::Key(line);
+            break;
+        }
+      }
+    }
+
+  private:
+    const std::vector<Pass> &passes_;
+};
+
+// Applies verdicts in input order: deduplicates and counts.
+class Chain {
+  public:
+    Chain(std::vector<Pass> &passes, util::Stats &stats)
+      : passes_(passes), input_(0), output_(0),
+        counters_(stats),
+        dedupe_entries_(stats.Counter("hash_table_entries")) {
+      for (std::vector<Pass>::const_iterator i = passes_.begin(); i != passes_.end(); ++i) {
+        dropped_.push_back(&stats.Counter(std::string("dropped_") + i->StatName()));
+      }
+    }
+
+    bool Apply(const StringPiece &line, const Verdict &verdict) {
+      ++input_;
+      counters_.Read(line);
+      for (std::size_t i = 0; i < passes_.size(); ++i) {
+        bool keep;
+        if (passes_[i].type == kDedupe) {
+          keep = dedupe_.Insert(verdict.key);
+          dedupe_entries_.Set(dedupe_.Size());
+        } else {
+          keep = (verdict.rejected_by != i);
+        }
+        if (!keep) {
+          ++passes_[i].dropped;
+          ++*dropped_[i];
+          return false;
+        }
+        ++passes_[i].kept;
+      }
+      ++output_;
+      counters_.Wrote(line);
+      return true;
+    }
+
+    void Report(std::ostream &to) const {
+      for (std::vector<Pass>::const_iterator i = passes_.begin(); i != passes_.end(); ++i) {
+        to << i->Name() << " kept " << i->kept << " dropped " << i->dropped << '\n';
+      }
+      to << "Kept " << output_ << " / " << input_ << " = " << (static_cast<float>(output_) / static_cast<float>(input_)) << std::endl;
+    }
+
+  private:
+    std::vector<Pass> &passes_;
+    preprocess::Dedupe dedupe_;
+    uint64_t input_, output_;
+
+    util::LineCounters counters_;
+    util::StatsCounter &dedupe_entries_;
+    std::vector<util::StatsCounter*> dropped_;
+};
+
+struct FilterBatch {
+  FilterBatch() : done(0) {}
+  preprocess::CorpusBatch input;
+  std::vector<Verdict> verdicts;
+  // Posted by the worker once verdicts are complete.
+  util::Semaphore done;
+};
+
+void WorkerThread(const Evaluator *evaluator, util::PCQueue<FilterBatch*> *work) {
+  try {
+    FilterBatch *batch;
+    while (true) {
+      work->Consume(batch);
+      if (!batch) return;
+      batch->verdicts.resize(batch->input.records);
+      preprocess::CorpusBatchLines lines(batch->input);
+      for (std::size_t i = 0; i < batch->input.records; ++i) {
+        (*evaluator)(lines.Next(0), batch->verdicts[i]);
+      }
+      batch->done.post();
+    }
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    abort();
+  }
+}
+
+void WriterThread(Chain *chain, util::PCQueue<FilterBatch*> *ordered, util::FileStream *out, util::StatsCounter *batches_read, util::StatsCounter *in_flight) {
+  FilterBatch *batch;
+  uint64_t written = 0;
+  while (true) {
+    ordered->Consume(batch);
+    if (!batch) return;
+    std::unique_ptr<FilterBatch> owned(batch);
+    in_flight->Set(batches_read->Get() - ++written);
+    util::WaitSemaphore(batch->done);
+    preprocess::CorpusBatchLines lines(batch->input);
+    for (std::size_t i = 0; i < batch->input.records; ++i) {
+      StringPiece line(lines.Next(0));
+      if (chain->Apply(line, batch->verdicts[i])) {
+        *out << line << '\n';
+      }
+    }
+  }
+}
+
+void Run(util::FilePiece &in, util::FileStream &out, const Evaluator &evaluator, Chain &chain, std::size_t threads, util::Stats &stats) {
+  if (threads <= 1) {
+    StringPiece line;
+    Verdict verdict;
+    while (in.ReadLineOrEOF(line)) {
+      evaluator(line, verdict);
+      if (chain.Apply(line, verdict)) {
+        out << line << '\n';
+      }
+    }
+    return;
+  }
+  preprocess::ParallelCorpusReader reader(std::vector<util::FilePiece*>(1, &in));
+  util::PCQueue<FilterBatch*> work(threads * 2);
+  // Bounds the number of batches in flight.
+  util::PCQueue<FilterBatch*> ordered(threads * 4);
+  util::FixedArray<std::thread> workers(threads);
+  for (std::size_t i = 0; i < threads; ++i) {
+    workers.push_back(WorkerThread, &evaluator, &work);
+  }
+  util::StatsCounter &batches_read = stats.Counter("batches_read"), &in_flight = stats.Counter("batches_in_flight");
+  std::thread writer(WriterThread, &chain, &ordered, &out, &batches_read, &in_flight);
+
+  std::exception_ptr error;
+  try {
+    while (true) {
+      std::unique_ptr<FilterBatch> batch(new FilterBatch());
+      if (!reader.Next(batch->input)) break;
+      ++batches_read;
+      // Writer takes ownership.
+      ordered.Produce(batch.get());
+      work.Produce(batch.release());
+    }
+  } catch (...) {
+    // Finish what was already read, then report.
+    error = std::current_exception();
+  }
+  for (std::size_t i = 0; i < threads; ++i) {
+    work.Produce(NULL);
+  }
+  ordered.Produce(NULL);
+  for (std::thread &w : workers) {
+    w.join();
+  }
+  writer.join();
+  if (error) std::rethrow_exception(error);
+}
+
+void Usage(const char *name) {
+  std::cerr << name << " [-j threads] filters... <in >out\n"
+    "Filters, applied in the order given:\n"
+    "  --utf8              remove lines with invalid UTF-8 (remove_invalid_utf8)\n"
+    "  --max-length bytes  remove lines longer than this (remove_long_lines)\n"
+    "  --latin             keep mostly Latin lines (select_latin)\n"
+    "  --dedupe            keep the first instance of each line (dedupe)\n"
+    "Counts of kept and dropped lines for each filter go to stderr." << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::vector<Pass> passes;
+  std::size_t threads = 1;
+  bool dedupe = false;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--utf8")) {
+      passes.push_back(Pass(kUTF8));
+    } else if (i + 1 < argc && !strcmp(argv[i], "--max-length")) {
+      const char *arg = argv[++i];
+      const char *arg_end = arg + strlen(arg);
+      uint64_t limit;
+      // Rejects empty, signed, trailing garbage, and overflow alike.
+      const char *parsed = util::ParseDecimal(arg, arg_end, limit);
+      if (parsed == arg || parsed != arg_end) {
+        std::cerr << "--max-length expects a number of bytes, not \"" << arg << '"' << std::endl;
+        return 1;
+      }
+      passes.push_back(Pass(kMaxLength, limit));
+    } else if (!strcmp(argv[i], "--latin")) {
+      passes.push_back(Pass(kLatin));
+    } else if (!strcmp(argv[i], "--dedupe") && !dedupe) {
+      passes.push_back(Pass(kDedupe));
+      dedupe = true;
+    } else if (i + 1 < argc && (!strcmp(argv[i], "-j") || !strcmp(argv[i], "--jobs"))) {
+      threads = strtoul(argv[++i], NULL, 10);
+    } else {
+      Usage(argv[0]);
+      return 1;
+    }
+  }
+  if (passes.empty()) {
+    Usage(argv[0]);
+    return 1;
+  }
+  util::Stats stats;
+  util::FilePiece in(0, NULL, &std::cerr);
+  util::FileStream out(1);
+  Evaluator evaluator(passes);
+  Chain chain(passes, stats);
+  stats.ReportFromEnvironment();
+  Run(in, out, evaluator, chain, threads, stats);
+  out.flush();
+  chain.Report(std::cerr);
+  return 0;
+}
@@ -0,0 +1,97 @@
+#pragma once
+// Line filters shared by the single-purpose tools and the fused filter tool.
+
+#include "util/murmur_hash.hh"
+#include "util/probing_hash_table.hh"
+#include "util/string_piece.hh"
+#include "util/utf8.hh"
+
+#include <cstddef>
+#include <numeric>
+
+#include <stdint.h>
+#include <string.h>
+#include <unicode/uchar.h>
+#include <unicode/uscript.h>
+
+namespace preprocess {
+
+struct UTF8Filter {
+  bool operator()(const StringPiece &line) const {
+    return utf8::IsUTF8(line);
+  }
+};
+
+class LengthFilter {
+  public:
+    explicit LengthFilter(std::size_t limit) : limit_(limit) {}
+
+    bool operator()(const StringPiece &line) const {
+      return static_cast<std::size_t>(line.size()) <= limit_;
+    }
+
+  private:
+    std::size_t limit_;
+};
+
+struct SelectLatin {
+  bool operator()(const StringPiece &line) const {
+    int32_t offset = 0;
+    int32_t length = static_cast<int32_t>(line.size());
+    size_t counts[USCRIPT_CODE_LIMIT];
+    memset(counts, 0, sizeof(counts));
+    size_t angle = 0;
+    while (offset < length) {
+      UChar32 character;
+      U8_NEXT(line.data(), offset, length, character);
+      // Avoid bad unicode and control characters
+      if (character < 32) return false;
+      UErrorCode err = U_ZERO_ERROR;
+      UScriptCode script = uscript_getScript(character, &err);
+      if (U_FAILURE(err) || script == USCRIPT_INVALID_CODE) return false;
+      ++counts[script];
+      if (character == '<' || character == '>') ++angle;
+    }
+    float total = static_cast<float>(std::accumulate(counts, counts + USCRIPT_CODE_LIMIT, 0));
+    if (static_cast<float>(counts[USCRIPT_LATIN] + counts[USCRIPT_INHERITED] + counts[USCRIPT_COMMON] - angle) < total * 0.9) return false;
+    if (static_cast<float>(counts[USCRIPT_LATIN]) < total * 0.5) return false;
+    return true;
+  }
+};
+
+// Keeps the first instance of each line.
+class Dedupe {
+  public:
+    // Hashing is thread safe, so callers may compute keys in parallel then Insert in order.
+    static uint64_t Key(const StringPiece &line) {
+      // 0 is reserved for empty buckets.
+      return util::MurmurHashNative(line.data(), line.size()) + 1;
+    }
+
+    // Returns true if the key is new.
+    bool Insert(uint64_t key) {
+      Entry entry;
+      entry.key = key;
+      Table::MutableIterator it;
+      return !table_.FindOrInsert(entry, it);
+    }
+
+    bool operator()(const StringPiece &line) {
+      return Insert(Key(line));
+    }
+
+    std::size_t Size() const { return table_.Size(); }
+
+  private:
+    struct Entry {
+      typedef uint64_t Key;
+      uint64_t key;
+      uint64_t GetKey() const { return key; }
+      void SetKey(uint64_t to) { key = to; }
+    };
+
+    typedef util::AutoProbing<Entry, util::IdentityHash> Table;
+    Table table_;
+};
+
+} // namespace preprocess
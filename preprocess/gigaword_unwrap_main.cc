@@ -1,17 +1,28 @@
 #include "util/file_piece.hh"
+#include "util/file_stream.hh"
+#include "util/fixed_array.hh"
+#include "util/murmur_hash.hh"
+#include "util/pcqueue.hh"
 #include "util/string_piece.hh"
-#include "util/string_piece_hash.hh"
-
-#include <boost/unordered_map.hpp>
+#include "util/string_stream.hh"
 
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <strings.h>
 
 /* This extracts data from gigaword XML files.  It puts each <P>, <HEADLINE>,
  * and <DATELINE> on a line with a <P> after it.  This output format is
  * intended for split-sentences.pl.  
  */
 
+namespace {
+
 const char *nyt_parentheses[] = {
   "(MORE)",
   "(PICTURE)",
@@ -96,119 +107,297 @@ const char *nyt_parentheses[] = {
   "(STORY CAN END HERE. OPTIONAL 3RD TAKE FOLLOWS.)"
 };
 
-boost::unordered_map<StringPiece, const char *> nyt_parentheses_set;
+// Perfect hash over the NYT parentheticals: the seed is chosen so no two collide.
+class ParenthesesTable {
+  public:
+    ParenthesesTable() {
+      std::vector<std::pair<StringPiece, const char *> > entries;
+      for (const char **i = nyt_parentheses; i != nyt_parentheses + sizeof(nyt_parentheses) / sizeof(const char*); ++i) {
+        entries.push_back(std::make_pair(StringPiece(*i), ""));
+      }
+      Set(entries, "(BEGIN BRACKET)", "[");
+      Set(entries, "(END BRACKET)", "]");
+      Set(entries, "(UNDERSCORE)", "_");
+      Set(entries, "(TILDE)", "~");
+      Set(entries, "(ASTERISK)", "*");
+      Set(entries, "(AT SIGN)", "@");
+      Set(entries, "(AT)", "@");
+      Set(entries, "(EQUALS)", "=");
+      for (seed_ = 0; !TryFill(entries); ++seed_) {}
+    }
 
-void CheckReplaceEntity(std::string &line, size_t pos, const char *pattern, char with) {
-  if (!strncasecmp(line.c_str() + pos, pattern, strlen(pattern))) {
-    line.replace(pos, strlen(pattern), 1, with);
-  }
-}
+    // Returns the replacement or NULL if str is not in the table.
+    const char *Find(StringPiece str) const {
+      const Slot &slot = slots_[Index(str)];
+      return slot.key == str ? slot.value : NULL;
+    }
 
-void MungeLine(std::string &line) {
-  boost::unordered_map<StringPiece, const char *>::const_iterator found;
-  // Parenthesized stuff
-  for (size_t pos = line.find('('); pos != std::string::npos;) {
-    size_t right = line.find(')', pos + 1);
-    if (right != std::string::npos) {
-      // Include ')' in range [pos, end)
-      size_t end = right + 1;
-      if (nyt_parentheses_set.end() != (found = nyt_parentheses_set.find(StringPiece(line.c_str() + pos, end - pos)))) {
-        line.replace(pos, end - pos, found->second);
-        pos = line.find('(', pos);
-      } else if(!strncmp(line.c_str() + pos + 1, "BC-", 3)) {
-        line.erase(pos, end - pos);
-        pos = line.find('(', pos);
-      } else {
-        pos = line.find('(', pos + 1);
+  private:
+    static void Set(std::vector<std::pair<StringPiece, const char *> > &entries, StringPiece key, const char *value) {
+      for (std::vector<std::pair<StringPiece, const char *> >::iterator i = entries.begin(); i != entries.end(); ++i) {
+        if (i->first == key) {
+          i->second = value;
+          return;
+        }
       }
-    } else {
-      pos = line.find('(', pos + 1);
+      entries.push_back(std::make_pair(key, value));
     }
-  }
 
+    std::size_t Index(StringPiece str) const {
+      return util::MurmurHash64A(str.data(), str.size(), seed_) & (kSize - 1);
+    }
 
-  for (size_t pos = line.find("``"); pos != std::string::npos; pos = line.find("``", pos + 1)) {
-    line.replace(pos, 2, 1, '"');
+    bool TryFill(const std::vector<std::pair<StringPiece, const char *> > &entries) {
+      for (std::size_t i = 0; i < kSize; ++i) {
+        slots_[i].key = StringPiece();
+        slots_[i].value = NULL;
+      }
+      for (std::vector<std::pair<StringPiece, const char *> >::const_iterator i = entries.begin(); i != entries.end(); ++i) {
+        Slot &slot = slots_[Index(i->first)];
+        if (slot.value) return false;
+        slot.key = i->first;
+        slot.value = i->second;
+      }
+      return true;
+    }
+
+    static const std::size_t kSize = 1024;
+
+    struct Slot {
+      StringPiece key;
+      const char *value;
+    };
+
+    uint64_t seed_;
+    Slot slots_[kSize];
+};
+
+bool StartsWithCase(const char *from, const char *end, const char *pattern, std::size_t length) {
+  return static_cast<std::size_t>(end - from) >= length && !strncasecmp(from, pattern, length);
+}
+
+/* If [amp, end) begins with an XML entity, sets with to the character it
+ * stands for and returns the number of bytes consumed.  Otherwise returns 0.
+ */
+std::size_t MatchEntity(const char *amp, const char *end, char &with) {
+  const char *name = amp + 1;
+  if (StartsWithCase(name, end, "lt;", 3)) {
+    with = '<';
+    return 4;
   }
-  for (size_t pos = line.find("''"); pos != std::string::npos; pos = line.find("''", pos + 1)) {
-    line.replace(pos, 2, 1, '"');
+  if (StartsWithCase(name, end, "gt;", 3)) {
+    with = '>';
+    return 4;
   }
-
-  // XML entities: these always produce at least one character.
-  for (size_t pos = line.find('&'); pos != std::string::npos; pos = line.find('&', pos + 1)) {
-    size_t right = line.find(';', pos + 1);
-    if (right != std::string::npos) {
-      // Not the most efficient way, but these are rare.  
-      CheckReplaceEntity(line, pos, "&lt;", '<');
-      CheckReplaceEntity(line, pos, "&gt;", '>');
-      CheckReplaceEntity(line, pos, "&amp;", '&');
-      CheckReplaceEntity(line, pos, "&apos;", '\'');
-      CheckReplaceEntity(line, pos, "&quot;", '"');
+  if (StartsWithCase(name, end, "amp;", 4)) {
+    // Entities used to be replaced in place, so the resulting & was tested for &apos; and &quot; too.
+    if (StartsWithCase(amp + 5, end, "apos;", 5)) {
+      with = '\'';
+      return 10;
     }
+    if (StartsWithCase(amp + 5, end, "quot;", 5)) {
+      with = '"';
+      return 10;
+    }
+    with = '&';
+    return 5;
+  }
+  if (StartsWithCase(name, end, "apos;", 5)) {
+    with = '\'';
+    return 6;
+  }
+  if (StartsWithCase(name, end, "quot;", 5)) {
+    with = '"';
+    return 6;
   }
+  return 0;
 }
 
-void ProcessText(util::FilePiece &in, const std::string &close, std::ostream &out, std::string &dupe_detect) {
+// Per-thread scratch space for cleaning lines.
+class Munger {
+  public:
+    explicit Munger(const ParenthesesTable &table) : table_(table) {}
+
+    // The return value is valid until the next call.
+    StringPiece operator()(StringPiece line) {
+      StringPiece text = Parentheses(line);
+      const char *const end = text.data() + text.size();
+      // Everything before copied has been appended to out_.
+      const char *copied = text.data();
+      out_.clear();
+      for (const char *i = text.data(); i != end;) {
+        std::size_t consumed = 0;
+        char with;
+        if ((*i == '`' || *i == '\'') && i + 1 != end && i[1] == *i) {
+          // `` and '' become "
+          consumed = 2;
+          with = '"';
+        } else if (*i == '&') {
+          consumed = MatchEntity(i, end, with);
+        }
+        if (consumed) {
+          out_.append(copied, i - copied);
+          out_.push_back(with);
+          i += consumed;
+          copied = i;
+        } else {
+          ++i;
+        }
+      }
+      if (copied == text.data()) return text;
+      out_.append(copied, end - copied);
+      return out_;
+    }
+
+  private:
+    // Replace or remove NYT parentheticals.  Returns line itself if there were none.
+    StringPiece Parentheses(StringPiece line) {
+      const char *const end = line.data() + line.size();
+      const char *copied = line.data();
+      parentheses_.clear();
+      for (const char *i = line.data(); const char *open = static_cast<const char*>(memchr(i, '(', end - i));) {
+        const char *close = static_cast<const char*>(memchr(open + 1, ')', end - open - 1));
+        if (!close) break;
+        StringPiece span(open, close + 1 - open);
+        const char *replacement = table_.Find(span);
+        if (!replacement && span.size() > 4 && !memcmp(open + 1, "BC-", 3)) replacement = "";
+        if (replacement) {
+          parentheses_.append(copied, open - copied);
+          parentheses_.append(replacement);
+          i = copied = close + 1;
+        } else {
+          i = open + 1;
+        }
+      }
+      if (copied == line.data()) return line;
+      parentheses_.append(copied, end - copied);
+      return parentheses_;
+    }
+
+    const ParenthesesTable &table_;
+
+    std::string parentheses_, out_;
+};
+
+template <class Stream> void ProcessText(util::FilePiece &in, StringPiece close, Munger &munger, Stream &out, std::string &dupe_detect) {
   bool content = false;
-  std::string line;
   StringPiece l;
-  while (true) {
-    try {
-      l = in.ReadLine();
-    } catch (const util::EndOfFileException &) { break; }
+  while (in.ReadLineOrEOF(l)) {
     if (l == close) break;
     if (l.empty() || (l.data()[0] != '<') || (l.data()[l.size() - 1] != '>')) {
-      line.assign(l.data(), l.size());
-      MungeLine(line);
+      StringPiece line = munger(l);
       if (!line.empty()) content = true;
-      if (dupe_detect != line) {
+      if (StringPiece(dupe_detect) != line) {
         out << line;
       }
-      if (!line.empty() && line[line.size() - 1] != '-') {
+      if (!line.empty() && line.data()[line.size() - 1] != '-') {
         out << ' ';
       }
-      std::swap(line, dupe_detect);
+      dupe_detect.assign(line.data(), line.size());
     }
   }
   // Why two lines?  This is intended to be piped to the sentence breaker.  
   if (content) out << "\n<P>\n";
 }
 
-void ProcessGigaword(util::FilePiece &in, std::ostream &out) {
-  const std::string head_close("</HEADLINE>"), p_close("</P>"), date_close("</DATELINE>"), text_close("</TEXT>");
+template <class Stream> void ProcessGigaword(util::FilePiece &in, Munger &munger, Stream &out) {
   StringPiece line;
   std::string dupe_detect;
-  while (true) {
-    try {
-      line = in.ReadLine();
-    } catch (const util::EndOfFileException &) { return; }
+  while (in.ReadLineOrEOF(line)) {
     if (line == "<HEADLINE>") {
-      ProcessText(in, head_close, out, dupe_detect);
+      ProcessText(in, "</HEADLINE>", munger, out, dupe_detect);
     } else if (line == "<P>") {
-      ProcessText(in, p_close, out, dupe_detect);
+      ProcessText(in, "</P>", munger, out, dupe_detect);
     } else if (line == "<DATELINE>") {
-      ProcessText(in, date_close, out, dupe_detect);
+      ProcessText(in, "</DATELINE>", munger, out, dupe_detect);
     } else if (line == "<TEXT>") {
-      ProcessText(in, text_close, out, dupe_detect);
+      ProcessText(in, "</TEXT>", munger, out, dupe_detect);
     }
   }
 }
 
-int main() {
-  for (const char **i = nyt_parentheses; i != nyt_parentheses + sizeof(nyt_parentheses) / sizeof(const char*); ++i) {
-    nyt_parentheses_set.insert(std::make_pair(*i, ""));
+struct FileJob {
+  FileJob() : done(0) {}
+  const char *name;
+  util::StringStream output;
+  // Posted by the worker once output is complete.
+  util::Semaphore done;
+};
+
+void FileWorker(const ParenthesesTable *table, util::FixedArray<FileJob> *jobs, util::PCQueue<std::size_t> *work, util::Semaphore *slots) {
+  try {
+    Munger munger(*table);
+    while (true) {
+      // Acquire a slot before taking a file so the oldest unwritten file always has one.
+      util::WaitSemaphore(*slots);
+      std::size_t index;
+      work->Consume(index);
+      if (index == jobs->size()) return;
+      FileJob &job = (*jobs)[index];
+      util::FilePiece in(job.name);
+      ProcessGigaword(in, munger, job.output);
+      job.done.post();
+    }
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    abort();
+  }
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::size_t threads = 1;
+  if (argc >= 3 && (!strcmp(argv[1], "-j") || !strcmp(argv[1], "--jobs"))) {
+    threads = strtoul(argv[2], NULL, 10);
+    argc -= 2;
+    argv += 2;
+  }
+  if (argc >= 2 && argv[1][0] == '-') {
+    std::cerr << argv[0] << " [-j threads] [file ...]\n"
+      "Unwraps gigaword XML from the files, which may be compressed, or stdin.\n"
+      "Files are processed on multiple threads and output in order." << std::endl;
+    return 1;
   }
-  nyt_parentheses_set["(BEGIN BRACKET)"] = "[";
-  nyt_parentheses_set["(END BRACKET)"] = "]";
-  nyt_parentheses_set["(UNDERSCORE)"] = "_";
-  nyt_parentheses_set["(TILDE)"] = "~";
-  nyt_parentheses_set["(ASTERISK)"] = "*";
-  nyt_parentheses_set["(AT SIGN)"] = "@";
-  nyt_parentheses_set["(AT)"] = "@";
-  nyt_parentheses_set["(EQUALS)"] = "=";
+  ParenthesesTable table;
+  util::FileStream out(1);
 
-  util::FilePiece in(0, NULL, &std::cerr);
+  if (argc == 1) {
+    util::FilePiece in(0, NULL, &std::cerr);
+    Munger munger(table);
+    ProcessGigaword(in, munger, out);
+    return 0;
+  }
 
-  ProcessGigaword(in, std::cout);
+  std::size_t files = argc - 1;
+  if (threads < 1) threads = 1;
+  util::FixedArray<FileJob> jobs(files);
+  util::PCQueue<std::size_t> work(files + threads);
+  for (std::size_t i = 0; i < files; ++i) {
+    jobs.push_back();
+    jobs.back().name = argv[i + 1];
+    work.Produce(i);
+  }
+  for (std::size_t i = 0; i < threads; ++i) {
+    // Poison.
+    work.Produce(files);
+  }
+  // Bounds the number of files held in memory.
+  util::Semaphore slots(threads * 2);
+  util::FixedArray<std::thread> workers(threads);
+  for (std::size_t i = 0; i < threads; ++i) {
+    workers.push_back(FileWorker, &table, &jobs, &work, &slots);
+  }
+  for (std::size_t i = 0; i < files; ++i) {
+    util::WaitSemaphore(jobs[i].done);
+    out << jobs[i].output.str();
+    // Free the memory.
+    std::string empty;
+    jobs[i].output.swap(empty);
+    slots.post();
+  }
+  for (std::thread &w : workers) {
+    w.join();
+  }
   return 0;
 }
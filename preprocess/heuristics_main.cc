@@ -0,0 +1,105 @@
+#include "line_parallel.hh"
+
+#include "util/file_piece.hh"
+#include "util/file_stream.hh"
+#include "util/rewrite_rules.hh"
+
+#include <iostream>
+#include <string>
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace {
+
+/* The substitutions of heuristics.perl in order.  That script compares the
+ * language with ==, which is numeric, so the French and English rules apply
+ * to every language and the rule removing long words never does.  The same
+ * is done here to produce the same output.
+ */
+const char *const kRules[] = {
+  // Normalize long chains of underscores to just two.
+  R"(s/_\s*_[\s_]*/ __ /g)",
+  R"(s/\*\s*\*[\s\*]*/ * /g)",
+  R"(s/#+//g)",
+  R"(s/[\!]+/!/g)",
+  R"(s/!([^ ])/! $1/g)",
+  R"(s/\.([^\s\d.])/. $1/g)",
+  R"(s/\+(\D)/+ $1/g)",
+  R"(s/(\D)\+/$1 +/g)",
+  R"(s/,(\D)/, $1/g)",
+  R"(s/(\s)-([^\s\d\-])/$1- $2/g)",
+  R"(s/^ *-- *//g)",
+  // Gigaword apw does this.
+  R"(s/ dlrs / \$ /g)",
+  // French
+  R"(s/([^ -]+)-t-(je|j'|tu|il|elle|on|nous|vous|ils|elles|me|m'|te|t'|le|l'|la|les|lui|leur|moi|toi|eux|elles|ce|c'|ça|ceci|cela|qui|ci|là) /\1 -t-\2 /gi)",
+  R"(s/([^ -]+)-(je|j'|tu|il|elle|on|nous|vous|ils|elles|me|m'|te|t'|le|l'|la|les|lui|leur|moi|toi|eux|elles|ce|c'|ça|ceci|cela|qui|ci|là) /\1 -\2 /gi)",
+  R"(s/\s+(qu|c|d|l|j|s|n|m|lorsqu|puisqu)\s+'\s+/ \1' /gi)",
+  R"(s/\s+aujourd\s*'\s*hui\s+/ aujourd'hui /gi)",
+  // English
+  R"(s/ élite / elite /gi)",
+  R"(s/ (s|at) & (t|p) / $1&$2 /ig)",
+  R"(s/ (full|half|part) - (time) / $1-$2 /ig)",
+  R"(s/ (vis|viz) - (.|..) - (vis|viz) / vis-à-vis /ig)",
+  R"(s/ (short|long|medium|one|half|two|on|off|in|post|ex|multi|de|mid|co|inter|intra|anti|re|pre|e|non|pro|self) - / $1- /ig)",
+  R"(s/ (ca|are|do|could|did|does|do|had|has|have|is|must|need|should|was|were|wo|would)n 't / \1n't /gi)",
+  R"(s/ ([AaEe][Ll]) - / \1-/g)",
+  R"(s/\.\s*\.\s*\.\s*[\.\s]*/ ... /g)",
+  R"(s/!\s*![!\s]*/ ! /g)",
+  R"(s/\?\s*\?[\?\s]*/ ? /g)",
+  R"(s/ ' s / 's /g)",
+  // Cut multiple hyphens down to one and space separate it.
+  R"(s/([^-])--+([^-])/$1 - $2/g)",
+  // Delete excess spaces.
+  R"(s/\s+/ /g)",
+  R"(s/^\s+//)",
+  R"(s/\s+$//)",
+};
+
+class Heuristics {
+  public:
+    explicit Heuristics(const util::RewriteRules &rules) : rules_(rules) {}
+
+    template <class Stream> void operator()(StringPiece line, Stream &out) {
+      text_.assign(" ");
+      text_.append(line.data(), line.size());
+      text_ += ' ';
+      rules_.Apply(text_, scratch_);
+      out << text_ << '\n';
+    }
+
+  private:
+    const util::RewriteRules &rules_;
+    std::string text_, scratch_;
+};
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::size_t threads = 1;
+  for (int i = 1; i < argc; ++i) {
+    if (i + 1 < argc && (!strcmp(argv[i], "-j") || !strcmp(argv[i], "--jobs"))) {
+      threads = strtoul(argv[++i], NULL, 10);
+    } else if (i + 1 < argc && !strcmp(argv[i], "-l")) {
+      // Accepted for compatibility; see kRules.
+      ++i;
+    } else {
+      std::cerr << argv[0] << " [-l language] [-j threads] <in >out\n"
+        "Applies the substitutions of heuristics.perl.  Like that script, the rules are\n"
+        "the same for every language.  The output matches the script except that\n"
+        "case-insensitive rules skip Perl's multi-character case folds, so lines with\n"
+        "characters like \u00DF or \u0130 can differ." << std::endl;
+      return 1;
+    }
+  }
+  util::RewriteRules rules(util::RewriteRules::kUnicode);
+  for (const char *rule : kRules) {
+    rules.Add(rule);
+  }
+  util::FilePiece in(0);
+  util::FileStream out(1);
+  // The carriage return, which chomp keeps, can block matches.
+  preprocess::ParallelLines(in, out, Heuristics(rules), threads, false);
+  return 0;
+}
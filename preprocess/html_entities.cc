@@ -0,0 +1,186 @@
+#include "preprocess/html_entities.hh"
+
+#include <algorithm>
+#include <cstring>
+
+#include <stdint.h>
+
+namespace preprocess {
+namespace {
+
+const char kByteOrderMark[3] = {'\xEF', '\xBB', '\xBF'};
+
+// What browsers make of &#128; through &#159;: the Windows-1252 character.
+const uint32_t kWindows1252[32] = {
+  0x20AC, 0x81, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021,
+  0x02C6, 0x2030, 0x0160, 0x2039, 0x0152, 0x8D, 0x017D, 0x8F,
+  0x90, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+  0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0x9D, 0x017E, 0x0178
+};
+
+bool EntityLess(const detail::HTMLEntity &entity, StringPiece name) {
+  std::size_t size = name.size();
+  int cmp = memcmp(entity.name, name.data(), std::min(entity.length, size));
+  return cmp < 0 || (cmp == 0 && entity.length < size);
+}
+
+const char *FindEntity(StringPiece name) {
+  const detail::HTMLEntity *end = detail::kHTMLEntities + detail::kHTMLEntitiesSize;
+  const detail::HTMLEntity *found = std::lower_bound(detail::kHTMLEntities, end, name, EntityLess);
+  if (found == end || found->length != static_cast<std::size_t>(name.size()) || memcmp(found->name, name.data(), name.size())) return NULL;
+  return found->value;
+}
+
+void AppendUTF8(uint32_t code, std::string &out) {
+  if (code < 0x80) {
+    out.push_back(static_cast<char>(code));
+  } else if (code < 0x800) {
+    out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+    out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+  } else if (code < 0x10000) {
+    out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+    out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+  } else {
+    out.push_back(static_cast<char>(0xF0 | (code >> 18)));
+    out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+  }
+}
+
+// Code points that a numeric reference silently drops.
+bool DroppedCodePoint(uint32_t code) {
+  return (code >= 0x1 && code <= 0x8) || code == 0xB || (code >= 0xE && code <= 0x1F) ||
+    (code >= 0x7F && code <= 0x9F) || (code >= 0xFDD0 && code <= 0xFDEF) || (code & 0xFFFE) == 0xFFFE;
+}
+
+void AppendNumeric(uint32_t code, std::string &out) {
+  if (code == 0) {
+    code = 0xFFFD;
+  } else if (code == 0xD) {
+    // Carriage return is allowed even though other controls are dropped.
+  } else if (code >= 0x80 && code <= 0x9F) {
+    code = kWindows1252[code - 0x80];
+  } else if ((code >= 0xD800 && code <= 0xDFFF) || code > 0x10FFFF) {
+    code = 0xFFFD;
+  } else if (DroppedCodePoint(code)) {
+    return;
+  }
+  if (code == 0xFEFF) {
+    out.push_back(' ');
+  } else {
+    AppendUTF8(code, out);
+  }
+}
+
+const char *Find(const char *from, const char *end, char c) {
+  return static_cast<const char*>(memchr(from, c, end - from));
+}
+
+int HexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+/* Decode &#123; or &#x7B; with the ; optional.  Returns a pointer past the
+ * reference or NULL if there are no digits.
+ */
+const char *DecodeNumeric(const char *hash, const char *end, std::string &out) {
+  const char *i = hash + 1;
+  unsigned int base = 10;
+  if (i != end && (*i == 'x' || *i == 'X')) {
+    base = 16;
+    ++i;
+  }
+  const char *digits = i;
+  uint32_t code = 0;
+  for (int value; i != end && (value = (base == 16 ? HexValue(*i) : (*i >= '0' && *i <= '9' ? *i - '0' : -1))) >= 0; ++i) {
+    // Saturate above the largest code point.
+    code = std::min<uint32_t>(code * base + value, 0x110000);
+  }
+  if (i == digits) return NULL;
+  if (i != end && *i == ';') ++i;
+  AppendNumeric(code, out);
+  return i;
+}
+
+bool NameCharacter(char c) {
+  switch (c) {
+    case '\t':
+    case '\n':
+    case '\f':
+    case ' ':
+    case '<':
+    case '&':
+    case '#':
+    case ';':
+      return false;
+    default:
+      return true;
+  }
+}
+
+// Decode a named reference after &.  Returns a pointer past what was consumed.
+const char *DecodeNamed(const char *name, const char *end, std::string &out) {
+  const char *i = name;
+  while (i != end && NameCharacter(*i)) ++i;
+  if (i != end && *i == ';') ++i;
+  const char *value = FindEntity(StringPiece(name, i - name));
+  if (value) {
+    out.append(value);
+    return i;
+  }
+  // Legacy references like &amp may be followed directly by text.
+  for (std::size_t length = std::min<std::size_t>(i - name - 1, detail::kLongestLegacyEntity); length > 1; --length) {
+    if ((value = FindEntity(StringPiece(name, length)))) {
+      out.append(value);
+      return name + length;
+    }
+  }
+  out.push_back('&');
+  return name;
+}
+
+} // namespace
+
+StringPiece UnescapeHTML(StringPiece text, std::string &buffer) {
+  const char *const end = text.data() + text.size();
+  // memchr is vectorized by the C library.
+  const char *amp = static_cast<const char*>(memchr(text.data(), '&', text.size()));
+  const char *bom = static_cast<const char*>(memmem(text.data(), text.size(), kByteOrderMark, sizeof(kByteOrderMark)));
+  if (!amp && !bom) return text;
+  const char *i = (amp && bom) ? std::min(amp, bom) : (amp ? amp : bom);
+  buffer.assign(text.data(), i - text.data());
+  const char *lead = i;
+  while (i != end) {
+    if (*i == '&') {
+      const char *next = NULL;
+      if (i + 1 != end && i[1] == '#') next = DecodeNumeric(i + 1, end, buffer);
+      if (next) {
+        i = next;
+      } else if (i + 1 != end && NameCharacter(i[1])) {
+        i = DecodeNamed(i + 1, end, buffer);
+      } else {
+        buffer.push_back('&');
+        ++i;
+      }
+    } else if (static_cast<std::size_t>(end - i) >= sizeof(kByteOrderMark) && !memcmp(i, kByteOrderMark, sizeof(kByteOrderMark))) {
+      buffer.push_back(' ');
+      i += sizeof(kByteOrderMark);
+    } else {
+      // Copy up to the next & or possible byte order mark.  Each is found
+      // with memchr and only searched for again once passed.
+      if (amp && amp <= i) amp = Find(i + 1, end, '&');
+      if (lead && lead <= i) lead = Find(i + 1, end, kByteOrderMark[0]);
+      const char *stop = std::min(amp ? amp : end, lead ? lead : end);
+      buffer.append(i, stop - i);
+      i = stop;
+    }
+  }
+  return buffer;
+}
+
+} // namespace preprocess
@@ -0,0 +1,35 @@
+#pragma once
+// Decoding of HTML character references, following Python's html.unescape.
+
+#include "util/string_piece.hh"
+
+#include <cstddef>
+#include <string>
+
+namespace preprocess {
+
+/* Decodes named (all of HTML5, including the legacy ones without ;) and
+ * numeric character references in text.  Byte order marks (U+FEFF), whether
+ * literal or encoded, become spaces.  Returns text itself if nothing changed;
+ * otherwise the result is in buffer.
+ */
+StringPiece UnescapeHTML(StringPiece text, std::string &buffer);
+
+namespace detail {
+
+struct HTMLEntity {
+  // Without the leading &, including any trailing ;
+  const char *name;
+  std::size_t length;
+  // UTF-8
+  const char *value;
+};
+
+// Sorted by name.  Defined in html_entity_table.cc, which is generated.
+extern const HTMLEntity kHTMLEntities[];
+extern const std::size_t kHTMLEntitiesSize;
+// Longest name that is recognized without a trailing ;
+extern const std::size_t kLongestLegacyEntity;
+
+} // namespace detail
+} // namespace preprocess
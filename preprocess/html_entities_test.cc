@@ -0,0 +1,103 @@
+#define BOOST_TEST_MODULE HTMLEntitiesTest
+#include "preprocess/html_entities.hh"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+namespace preprocess { namespace {
+
+std::string Unescape(StringPiece text) {
+  std::string buffer;
+  StringPiece out = UnescapeHTML(text, buffer);
+  return std::string(out.data(), out.size());
+}
+
+BOOST_AUTO_TEST_CASE(Unchanged) {
+  std::string buffer;
+  StringPiece text("no references here");
+  StringPiece out = UnescapeHTML(text, buffer);
+  BOOST_CHECK_EQUAL(text.data(), out.data());
+  BOOST_CHECK_EQUAL("& x", Unescape("& x"));
+  BOOST_CHECK_EQUAL("&bogus;", Unescape("&bogus;"));
+  BOOST_CHECK_EQUAL("&#;", Unescape("&#;"));
+  BOOST_CHECK_EQUAL("&#x;", Unescape("&#x;"));
+  BOOST_CHECK_EQUAL("trailing &", Unescape("trailing &"));
+}
+
+BOOST_AUTO_TEST_CASE(Named) {
+  BOOST_CHECK_EQUAL("a < b & c", Unescape("a &lt; b &amp; c"));
+  BOOST_CHECK_EQUAL("\xE2\x80\x94", Unescape("&mdash;"));
+}
+
+BOOST_AUTO_TEST_CASE(LegacyWithoutSemicolon) {
+  BOOST_CHECK_EQUAL("<", Unescape("&lt"));
+  BOOST_CHECK_EQUAL("&foo", Unescape("&ampfoo"));
+  BOOST_CHECK_EQUAL("\xC2\xAC" "it;", Unescape("&notit;"));
+  // Only the legacy names work without ;
+  BOOST_CHECK_EQUAL("&mdash", Unescape("&mdash"));
+}
+
+BOOST_AUTO_TEST_CASE(Numeric) {
+  BOOST_CHECK_EQUAL("A", Unescape("&#65;"));
+  BOOST_CHECK_EQUAL("A", Unescape("&#65"));
+  BOOST_CHECK_EQUAL("Ag", Unescape("&#x41g"));
+  BOOST_CHECK_EQUAL("\xF0\x9F\x98\x80", Unescape("&#x1F600;"));
+  BOOST_CHECK_EQUAL("\r", Unescape("&#13;"));
+}
+
+BOOST_AUTO_TEST_CASE(Windows1252) {
+  BOOST_CHECK_EQUAL("\xE2\x82\xAC", Unescape("&#128;"));
+  BOOST_CHECK_EQUAL("\xE2\x80\x93", Unescape("&#150;"));
+  BOOST_CHECK_EQUAL("\xC5\xB8", Unescape("&#159;"));
+  // Undefined in Windows-1252 so kept as the C1 control.
+  BOOST_CHECK_EQUAL("a\xC2\x81" "b", Unescape("a&#129;b"));
+}
+
+BOOST_AUTO_TEST_CASE(DroppedControls) {
+  BOOST_CHECK_EQUAL("ab", Unescape("a&#1;b"));
+  BOOST_CHECK_EQUAL("ab", Unescape("a&#x0B;b"));
+  BOOST_CHECK_EQUAL("ab", Unescape("a&#127;b"));
+  BOOST_CHECK_EQUAL("ab", Unescape("a&#xFFFE;b"));
+}
+
+BOOST_AUTO_TEST_CASE(Replacement) {
+  BOOST_CHECK_EQUAL("\xEF\xBF\xBD", Unescape("&#0;"));
+  BOOST_CHECK_EQUAL("\xEF\xBF\xBD", Unescape("&#xD800;"));
+  BOOST_CHECK_EQUAL("\xEF\xBF\xBD", Unescape("&#x110000;"));
+  // Saturates rather than wrapping around to a valid code point.
+  BOOST_CHECK_EQUAL("\xEF\xBF\xBD", Unescape("&#xFFFFFFFFFF;"));
+  BOOST_CHECK_EQUAL("\xEF\xBF\xBD", Unescape("&#99999999999999999999;"));
+  BOOST_CHECK_EQUAL("\xEF\xBF\xBD", Unescape("&#x100000041;"));
+}
+
+BOOST_AUTO_TEST_CASE(CarriageReturn) {
+  BOOST_CHECK_EQUAL("plain\r", Unescape("plain\r"));
+  BOOST_CHECK_EQUAL("&\r", Unescape("&amp;\r"));
+  BOOST_CHECK_EQUAL("&\r", Unescape("&amp\r"));
+  BOOST_CHECK_EQUAL("<\r>\r", Unescape("&lt;\r&gt;\r"));
+}
+
+BOOST_AUTO_TEST_CASE(LongRuns) {
+  std::string text(1000, 'a');
+  text += "&amp;";
+  text.append(1000, '\xEF');
+  text += "\xEF\xBB\xBF&lt";
+  text.append(1000, 'b');
+  std::string expected(1000, 'a');
+  expected += "&";
+  expected.append(1000, '\xEF');
+  expected += " <";
+  expected.append(1000, 'b');
+  BOOST_CHECK_EQUAL(expected, Unescape(text));
+}
+
+BOOST_AUTO_TEST_CASE(ByteOrderMark) {
+  BOOST_CHECK_EQUAL("a b", Unescape("a\xEF\xBB\xBF" "b"));
+  BOOST_CHECK_EQUAL("a b", Unescape("a&#xFEFF;b"));
+  BOOST_CHECK_EQUAL(" &", Unescape("\xEF\xBB\xBF&amp;"));
+  // A lone lead byte is copied through.
+  BOOST_CHECK_EQUAL("\xEF\xBB", Unescape("\xEF\xBB"));
+}
+
+}} // namespaces
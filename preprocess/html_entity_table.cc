@@ -0,0 +1,2246 @@
+// Generated by html_entity_table.py.  Do not edit.
+#include "preprocess/html_entities.hh"
+
+namespace preprocess {
+namespace detail {
+
+const HTMLEntity kHTMLEntities[] = {
+  {"AElig", 5, "\303\206"},
+  {"AElig;", 6, "\303\206"},
+  {"AMP", 3, "&"},
+  {"AMP;", 4, "&"},
+  {"Aacute", 6, "\303\201"},
+  {"Aacute;", 7, "\303\201"},
+  {"Abreve;", 7, "\304\202"},
+  {"Acirc", 5, "\303\202"},
+  {"Acirc;", 6, "\303\202"},
+  {"Acy;", 4, "\320\220"},
+  {"Afr;", 4, "\360\235\224\204"},
+  {"Agrave", 6, "\303\200"},
+  {"Agrave;", 7, "\303\200"},
+  {"Alpha;", 6, "\316\221"},
+  {"Amacr;", 6, "\304\200"},
+  {"And;", 4, "\342\251\223"},
+  {"Aogon;", 6, "\304\204"},
+  {"Aopf;", 5, "\360\235\224\270"},
+  {"ApplyFunction;", 14, "\342\201\241"},
+  {"Aring", 5, "\303\205"},
+  {"Aring;", 6, "\303\205"},
+  {"Ascr;", 5, "\360\235\222\234"},
+  {"Assign;", 7, "\342\211\224"},
+  {"Atilde", 6, "\303\203"},
+  {"Atilde;", 7, "\303\203"},
+  {"Auml", 4, "\303\204"},
+  {"Auml;", 5, "\303\204"},
+  {"Backslash;", 10, "\342\210\226"},
+  {"Barv;", 5, "\342\253\247"},
+  {"Barwed;", 7, "\342\214\206"},
+  {"Bcy;", 4, "\320\221"},
+  {"Because;", 8, "\342\210\265"},
+  {"Bernoullis;", 11, "\342\204\254"},
+  {"Beta;", 5, "\316\222"},
+  {"Bfr;", 4, "\360\235\224\205"},
+  {"Bopf;", 5, "\360\235\224\271"},
+  {"Breve;", 6, "\313\230"},
+  {"Bscr;", 5, "\342\204\254"},
+  {"Bumpeq;", 7, "\342\211\216"},
+  {"CHcy;", 5, "\320\247"},
+  {"COPY", 4, "\302\251"},
+  {"COPY;", 5, "\302\251"},
+  {"Cacute;", 7, "\304\206"},
+  {"Cap;", 4, "\342\213\222"},
+  {"CapitalDifferentialD;", 21, "\342\205\205"},
+  {"Cayleys;", 8, "\342\204\255"},
+  {"Ccaron;", 7, "\304\214"},
+  {"Ccedil", 6, "\303\207"},
+  {"Ccedil;", 7, "\303\207"},
+  {"Ccirc;", 6, "\304\210"},
+  {"Cconint;", 8, "\342\210\260"},
+  {"Cdot;", 5, "\304\212"},
+  {"Cedilla;", 8, "\302\270"},
+  {"CenterDot;", 10, "\302\267"},
+  {"Cfr;", 4, "\342\204\255"},
+  {"Chi;", 4, "\316\247"},
+  {"CircleDot;", 10, "\342\212\231"},
+  {"CircleMinus;", 12, "\342\212\226"},
+  {"CirclePlus;", 11, "\342\212\225"},
+  {"CircleTimes;", 12, "\342\212\227"},
+  {"ClockwiseContourIntegral;", 25, "\342\210\262"},
+  {"CloseCurlyDoubleQuote;", 22, "\342\200\235"},
+  {"CloseCurlyQuote;", 16, "\342\200\231"},
+  {"Colon;", 6, "\342\210\267"},
+  {"Colone;", 7, "\342\251\264"},
+  {"Congruent;", 10, "\342\211\241"},
+  {"Conint;", 7, "\342\210\257"},
+  {"ContourIntegral;", 16, "\342\210\256"},
+  {"Copf;", 5, "\342\204\202"},
+  {"Coproduct;", 10, "\342\210\220"},
+  {"CounterClockwiseContourIntegral;", 32, "\342\210\263"},
+  {"Cross;", 6, "\342\250\257"},
+  {"Cscr;", 5, "\360\235\222\236"},
+  {"Cup;", 4, "\342\213\223"},
+  {"CupCap;", 7, "\342\211\215"},
+  {"DD;", 3, "\342\205\205"},
+  {"DDotrahd;", 9, "\342\244\221"},
+  {"DJcy;", 5, "\320\202"},
+  {"DScy;", 5, "\320\205"},
+  {"DZcy;", 5, "\320\217"},
+  {"Dagger;", 7, "\342\200\241"},
+  {"Darr;", 5, "\342\206\241"},
+  {"Dashv;", 6, "\342\253\244"},
+  {"Dcaron;", 7, "\304\216"},
+  {"Dcy;", 4, "\320\224"},
+  {"Del;", 4, "\342\210\207"},
+  {"Delta;", 6, "\316\224"},
+  {"Dfr;", 4, "\360\235\224\207"},
+  {"DiacriticalAcute;", 17, "\302\264"},
+  {"DiacriticalDot;", 15, "\313\231"},
+  {"DiacriticalDoubleAcute;", 23, "\313\235"},
+  {"DiacriticalGrave;", 17, "`"},
+  {"DiacriticalTilde;", 17, "\313\234"},
+  {"Diamond;", 8, "\342\213\204"},
+  {"DifferentialD;", 14, "\342\205\206"},
+  {"Dopf;", 5, "\360\235\224\273"},
+  {"Dot;", 4, "\302\250"},
+  {"DotDot;", 7, "\342\203\234"},
+  {"DotEqual;", 9, "\342\211\220"},
+  {"DoubleContourIntegral;", 22, "\342\210\257"},
+  {"DoubleDot;", 10, "\302\250"},
+  {"DoubleDownArrow;", 16, "\342\207\223"},
+  {"DoubleLeftArrow;", 16, "\342\207\220"},
+  {"DoubleLeftRightArrow;", 21, "\342\207\224"},
+  {"DoubleLeftTee;", 14, "\342\253\244"},
+  {"DoubleLongLeftArrow;", 20, "\342\237\270"},
+  {"DoubleLongLeftRightArrow;", 25, "\342\237\272"},
+  {"DoubleLongRightArrow;", 21, "\342\237\271"},
+  {"DoubleRightArrow;", 17, "\342\207\222"},
+  {"DoubleRightTee;", 15, "\342\212\250"},
+  {"DoubleUpArrow;", 14, "\342\207\221"},
+  {"DoubleUpDownArrow;", 18, "\342\207\225"},
+  {"DoubleVerticalBar;", 18, "\342\210\245"},
+  {"DownArrow;", 10, "\342\206\223"},
+  {"DownArrowBar;", 13, "\342\244\223"},
+  {"DownArrowUpArrow;", 17, "\342\207\265"},
+  {"DownBreve;", 10, "\314\221"},
+  {"DownLeftRightVector;", 20, "\342\245\220"},
+  {"DownLeftTeeVector;", 18, "\342\245\236"},
+  {"DownLeftVector;", 15, "\342\206\275"},
+  {"DownLeftVectorBar;", 18, "\342\245\226"},
+  {"DownRightTeeVector;", 19, "\342\245\237"},
+  {"DownRightVector;", 16, "\342\207\201"},
+  {"DownRightVectorBar;", 19, "\342\245\227"},
+  {"DownTee;", 8, "\342\212\244"},
+  {"DownTeeArrow;", 13, "\342\206\247"},
+  {"Downarrow;", 10, "\342\207\223"},
+  {"Dscr;", 5, "\360\235\222\237"},
+  {"Dstrok;", 7, "\304\220"},
+  {"ENG;", 4, "\305\212"},
+  {"ETH", 3, "\303\220"},
+  {"ETH;", 4, "\303\220"},
+  {"Eacute", 6, "\303\211"},
+  {"Eacute;", 7, "\303\211"},
+  {"Ecaron;", 7, "\304\232"},
+  {"Ecirc", 5, "\303\212"},
+  {"Ecirc;", 6, "\303\212"},
+  {"Ecy;", 4, "\320\255"},
+  {"Edot;", 5, "\304\226"},
+  {"Efr;", 4, "\360\235\224\210"},
+  {"Egrave", 6, "\303\210"},
+  {"Egrave;", 7, "\303\210"},
+  {"Element;", 8, "\342\210\210"},
+  {"Emacr;", 6, "\304\222"},
+  {"EmptySmallSquare;", 17, "\342\227\273"},
+  {"EmptyVerySmallSquare;", 21, "\342\226\253"},
+  {"Eogon;", 6, "\304\230"},
+  {"Eopf;", 5, "\360\235\224\274"},
+  {"Epsilon;", 8, "\316\225"},
+  {"Equal;", 6, "\342\251\265"},
+  {"EqualTilde;", 11, "\342\211\202"},
+  {"Equilibrium;", 12, "\342\207\214"},
+  {"Escr;", 5, "\342\204\260"},
+  {"Esim;", 5, "\342\251\263"},
+  {"Eta;", 4, "\316\227"},
+  {"Euml", 4, "\303\213"},
+  {"Euml;", 5, "\303\213"},
+  {"Exists;", 7, "\342\210\203"},
+  {"ExponentialE;", 13, "\342\205\207"},
+  {"Fcy;", 4, "\320\244"},
+  {"Ffr;", 4, "\360\235\224\211"},
+  {"FilledSmallSquare;", 18, "\342\227\274"},
+  {"FilledVerySmallSquare;", 22, "\342\226\252"},
+  {"Fopf;", 5, "\360\235\224\275"},
+  {"ForAll;", 7, "\342\210\200"},
+  {"Fouriertrf;", 11, "\342\204\261"},
+  {"Fscr;", 5, "\342\204\261"},
+  {"GJcy;", 5, "\320\203"},
+  {"GT", 2, ">"},
+  {"GT;", 3, ">"},
+  {"Gamma;", 6, "\316\223"},
+  {"Gammad;", 7, "\317\234"},
+  {"Gbreve;", 7, "\304\236"},
+  {"Gcedil;", 7, "\304\242"},
+  {"Gcirc;", 6, "\304\234"},
+  {"Gcy;", 4, "\320\223"},
+  {"Gdot;", 5, "\304\240"},
+  {"Gfr;", 4, "\360\235\224\212"},
+  {"Gg;", 3, "\342\213\231"},
+  {"Gopf;", 5, "\360\235\224\276"},
+  {"GreaterEqual;", 13, "\342\211\245"},
+  {"GreaterEqualLess;", 17, "\342\213\233"},
+  {"GreaterFullEqual;", 17, "\342\211\247"},
+  {"GreaterGreater;", 15, "\342\252\242"},
+  {"GreaterLess;", 12, "\342\211\267"},
+  {"GreaterSlantEqual;", 18, "\342\251\276"},
+  {"GreaterTilde;", 13, "\342\211\263"},
+  {"Gscr;", 5, "\360\235\222\242"},
+  {"Gt;", 3, "\342\211\253"},
+  {"HARDcy;", 7, "\320\252"},
+  {"Hacek;", 6, "\313\207"},
+  {"Hat;", 4, "^"},
+  {"Hcirc;", 6, "\304\244"},
+  {"Hfr;", 4, "\342\204\214"},
+  {"HilbertSpace;", 13, "\342\204\213"},
+  {"Hopf;", 5, "\342\204\215"},
+  {"HorizontalLine;", 15, "\342\224\200"},
+  {"Hscr;", 5, "\342\204\213"},
+  {"Hstrok;", 7, "\304\246"},
+  {"HumpDownHump;", 13, "\342\211\216"},
+  {"HumpEqual;", 10, "\342\211\217"},
+  {"IEcy;", 5, "\320\225"},
+  {"IJlig;", 6, "\304\262"},
+  {"IOcy;", 5, "\320\201"},
+  {"Iacute", 6, "\303\215"},
+  {"Iacute;", 7, "\303\215"},
+  {"Icirc", 5, "\303\216"},
+  {"Icirc;", 6, "\303\216"},
+  {"Icy;", 4, "\320\230"},
+  {"Idot;", 5, "\304\260"},
+  {"Ifr;", 4, "\342\204\221"},
+  {"Igrave", 6, "\303\214"},
+  {"Igrave;", 7, "\303\214"},
+  {"Im;", 3, "\342\204\221"},
+  {"Imacr;", 6, "\304\252"},
+  {"ImaginaryI;", 11, "\342\205\210"},
+  {"Implies;", 8, "\342\207\222"},
+  {"Int;", 4, "\342\210\254"},
+  {"Integral;", 9, "\342\210\253"},
+  {"Intersection;", 13, "\342\213\202"},
+  {"InvisibleComma;", 15, "\342\201\243"},
+  {"InvisibleTimes;", 15, "\342\201\242"},
+  {"Iogon;", 6, "\304\256"},
+  {"Iopf;", 5, "\360\235\225\200"},
+  {"Iota;", 5, "\316\231"},
+  {"Iscr;", 5, "\342\204\220"},
+  {"Itilde;", 7, "\304\250"},
+  {"Iukcy;", 6, "\320\206"},
+  {"Iuml", 4, "\303\217"},
+  {"Iuml;", 5, "\303\217"},
+  {"Jcirc;", 6, "\304\264"},
+  {"Jcy;", 4, "\320\231"},
+  {"Jfr;", 4, "\360\235\224\215"},
+  {"Jopf;", 5, "\360\235\225\201"},
+  {"Jscr;", 5, "\360\235\222\245"},
+  {"Jsercy;", 7, "\320\210"},
+  {"Jukcy;", 6, "\320\204"},
+  {"KHcy;", 5, "\320\245"},
+  {"KJcy;", 5, "\320\214"},
+  {"Kappa;", 6, "\316\232"},
+  {"Kcedil;", 7, "\304\266"},
+  {"Kcy;", 4, "\320\232"},
+  {"Kfr;", 4, "\360\235\224\216"},
+  {"Kopf;", 5, "\360\235\225\202"},
+  {"Kscr;", 5, "\360\235\222\246"},
+  {"LJcy;", 5, "\320\211"},
+  {"LT", 2, "<"},
+  {"LT;", 3, "<"},
+  {"Lacute;", 7, "\304\271"},
+  {"Lambda;", 7, "\316\233"},
+  {"Lang;", 5, "\342\237\252"},
+  {"Laplacetrf;", 11, "\342\204\222"},
+  {"Larr;", 5, "\342\206\236"},
+  {"Lcaron;", 7, "\304\275"},
+  {"Lcedil;", 7, "\304\273"},
+  {"Lcy;", 4, "\320\233"},
+  {"LeftAngleBracket;", 17, "\342\237\250"},
+  {"LeftArrow;", 10, "\342\206\220"},
+  {"LeftArrowBar;", 13, "\342\207\244"},
+  {"LeftArrowRightArrow;", 20, "\342\207\206"},
+  {"LeftCeiling;", 12, "\342\214\210"},
+  {"LeftDoubleBracket;", 18, "\342\237\246"},
+  {"LeftDownTeeVector;", 18, "\342\245\241"},
+  {"LeftDownVector;", 15, "\342\207\203"},
+  {"LeftDownVectorBar;", 18, "\342\245\231"},
+  {"LeftFloor;", 10, "\342\214\212"},
+  {"LeftRightArrow;", 15, "\342\206\224"},
+  {"LeftRightVector;", 16, "\342\245\216"},
+  {"LeftTee;", 8, "\342\212\243"},
+  {"LeftTeeArrow;", 13, "\342\206\244"},
+  {"LeftTeeVector;", 14, "\342\245\232"},
+  {"LeftTriangle;", 13, "\342\212\262"},
+  {"LeftTriangleBar;", 16, "\342\247\217"},
+  {"LeftTriangleEqual;", 18, "\342\212\264"},
+  {"LeftUpDownVector;", 17, "\342\245\221"},
+  {"LeftUpTeeVector;", 16, "\342\245\240"},
+  {"LeftUpVector;", 13, "\342\206\277"},
+  {"LeftUpVectorBar;", 16, "\342\245\230"},
+  {"LeftVector;", 11, "\342\206\274"},
+  {"LeftVectorBar;", 14, "\342\245\222"},
+  {"Leftarrow;", 10, "\342\207\220"},
+  {"Leftrightarrow;", 15, "\342\207\224"},
+  {"LessEqualGreater;", 17, "\342\213\232"},
+  {"LessFullEqual;", 14, "\342\211\246"},
+  {"LessGreater;", 12, "\342\211\266"},
+  {"LessLess;", 9, "\342\252\241"},
+  {"LessSlantEqual;", 15, "\342\251\275"},
+  {"LessTilde;", 10, "\342\211\262"},
+  {"Lfr;", 4, "\360\235\224\217"},
+  {"Ll;", 3, "\342\213\230"},
+  {"Lleftarrow;", 11, "\342\207\232"},
+  {"Lmidot;", 7, "\304\277"},
+  {"LongLeftArrow;", 14, "\342\237\265"},
+  {"LongLeftRightArrow;", 19, "\342\237\267"},
+  {"LongRightArrow;", 15, "\342\237\266"},
+  {"Longleftarrow;", 14, "\342\237\270"},
+  {"Longleftrightarrow;", 19, "\342\237\272"},
+  {"Longrightarrow;", 15, "\342\237\271"},
+  {"Lopf;", 5, "\360\235\225\203"},
+  {"LowerLeftArrow;", 15, "\342\206\231"},
+  {"LowerRightArrow;", 16, "\342\206\230"},
+  {"Lscr;", 5, "\342\204\222"},
+  {"Lsh;", 4, "\342\206\260"},
+  {"Lstrok;", 7, "\305\201"},
+  {"Lt;", 3, "\342\211\252"},
+  {"Map;", 4, "\342\244\205"},
+  {"Mcy;", 4, "\320\234"},
+  {"MediumSpace;", 12, "\342\201\237"},
+  {"Mellintrf;", 10, "\342\204\263"},
+  {"Mfr;", 4, "\360\235\224\220"},
+  {"MinusPlus;", 10, "\342\210\223"},
+  {"Mopf;", 5, "\360\235\225\204"},
+  {"Mscr;", 5, "\342\204\263"},
+  {"Mu;", 3, "\316\234"},
+  {"NJcy;", 5, "\320\212"},
+  {"Nacute;", 7, "\305\203"},
+  {"Ncaron;", 7, "\305\207"},
+  {"Ncedil;", 7, "\305\205"},
+  {"Ncy;", 4, "\320\235"},
+  {"NegativeMediumSpace;", 20, "\342\200\213"},
+  {"NegativeThickSpace;", 19, "\342\200\213"},
+  {"NegativeThinSpace;", 18, "\342\200\213"},
+  {"NegativeVeryThinSpace;", 22, "\342\200\213"},
+  {"NestedGreaterGreater;", 21, "\342\211\253"},
+  {"NestedLessLess;", 15, "\342\211\252"},
+  {"NewLine;", 8, "\012"},
+  {"Nfr;", 4, "\360\235\224\221"},
+  {"NoBreak;", 8, "\342\201\240"},
+  {"NonBreakingSpace;", 17, "\302\240"},
+  {"Nopf;", 5, "\342\204\225"},
+  {"Not;", 4, "\342\253\254"},
+  {"NotCongruent;", 13, "\342\211\242"},
+  {"NotCupCap;", 10, "\342\211\255"},
+  {"NotDoubleVerticalBar;", 21, "\342\210\246"},
+  {"NotElement;", 11, "\342\210\211"},
+  {"NotEqual;", 9, "\342\211\240"},
+  {"NotEqualTilde;", 14, "\342\211\202\314\270"},
+  {"NotExists;", 10, "\342\210\204"},
+  {"NotGreater;", 11, "\342\211\257"},
+  {"NotGreaterEqual;", 16, "\342\211\261"},
+  {"NotGreaterFullEqual;", 20, "\342\211\247\314\270"},
+  {"NotGreaterGreater;", 18, "\342\211\253\314\270"},
+  {"NotGreaterLess;", 15, "\342\211\271"},
+  {"NotGreaterSlantEqual;", 21, "\342\251\276\314\270"},
+  {"NotGreaterTilde;", 16, "\342\211\265"},
+  {"NotHumpDownHump;", 16, "\342\211\216\314\270"},
+  {"NotHumpEqual;", 13, "\342\211\217\314\270"},
+  {"NotLeftTriangle;", 16, "\342\213\252"},
+  {"NotLeftTriangleBar;", 19, "\342\247\217\314\270"},
+  {"NotLeftTriangleEqual;", 21, "\342\213\254"},
+  {"NotLess;", 8, "\342\211\256"},
+  {"NotLessEqual;", 13, "\342\211\260"},
+  {"NotLessGreater;", 15, "\342\211\270"},
+  {"NotLessLess;", 12, "\342\211\252\314\270"},
+  {"NotLessSlantEqual;", 18, "\342\251\275\314\270"},
+  {"NotLessTilde;", 13, "\342\211\264"},
+  {"NotNestedGreaterGreater;", 24, "\342\252\242\314\270"},
+  {"NotNestedLessLess;", 18, "\342\252\241\314\270"},
+  {"NotPrecedes;", 12, "\342\212\200"},
+  {"NotPrecedesEqual;", 17, "\342\252\257\314\270"},
+  {"NotPrecedesSlantEqual;", 22, "\342\213\240"},
+  {"NotReverseElement;", 18, "\342\210\214"},
+  {"NotRightTriangle;", 17, "\342\213\253"},
+  {"NotRightTriangleBar;", 20, "\342\247\220\314\270"},
+  {"NotRightTriangleEqual;", 22, "\342\213\255"},
+  {"NotSquareSubset;", 16, "\342\212\217\314\270"},
+  {"NotSquareSubsetEqual;", 21, "\342\213\242"},
+  {"NotSquareSuperset;", 18, "\342\212\220\314\270"},
+  {"NotSquareSupersetEqual;", 23, "\342\213\243"},
+  {"NotSubset;", 10, "\342\212\202\342\203\222"},
+  {"NotSubsetEqual;", 15, "\342\212\210"},
+  {"NotSucceeds;", 12, "\342\212\201"},
+  {"NotSucceedsEqual;", 17, "\342\252\260\314\270"},
+  {"NotSucceedsSlantEqual;", 22, "\342\213\241"},
+  {"NotSucceedsTilde;", 17, "\342\211\277\314\270"},
+  {"NotSuperset;", 12, "\342\212\203\342\203\222"},
+  {"NotSupersetEqual;", 17, "\342\212\211"},
+  {"NotTilde;", 9, "\342\211\201"},
+  {"NotTildeEqual;", 14, "\342\211\204"},
+  {"NotTildeFullEqual;", 18, "\342\211\207"},
+  {"NotTildeTilde;", 14, "\342\211\211"},
+  {"NotVerticalBar;", 15, "\342\210\244"},
+  {"Nscr;", 5, "\360\235\222\251"},
+  {"Ntilde", 6, "\303\221"},
+  {"Ntilde;", 7, "\303\221"},
+  {"Nu;", 3, "\316\235"},
+  {"OElig;", 6, "\305\222"},
+  {"Oacute", 6, "\303\223"},
+  {"Oacute;", 7, "\303\223"},
+  {"Ocirc", 5, "\303\224"},
+  {"Ocirc;", 6, "\303\224"},
+  {"Ocy;", 4, "\320\236"},
+  {"Odblac;", 7, "\305\220"},
+  {"Ofr;", 4, "\360\235\224\222"},
+  {"Ograve", 6, "\303\222"},
+  {"Ograve;", 7, "\303\222"},
+  {"Omacr;", 6, "\305\214"},
+  {"Omega;", 6, "\316\251"},
+  {"Omicron;", 8, "\316\237"},
+  {"Oopf;", 5, "\360\235\225\206"},
+  {"OpenCurlyDoubleQuote;", 21, "\342\200\234"},
+  {"OpenCurlyQuote;", 15, "\342\200\230"},
+  {"Or;", 3, "\342\251\224"},
+  {"Oscr;", 5, "\360\235\222\252"},
+  {"Oslash", 6, "\303\230"},
+  {"Oslash;", 7, "\303\230"},
+  {"Otilde", 6, "\303\225"},
+  {"Otilde;", 7, "\303\225"},
+  {"Otimes;", 7, "\342\250\267"},
+  {"Ouml", 4, "\303\226"},
+  {"Ouml;", 5, "\303\226"},
+  {"OverBar;", 8, "\342\200\276"},
+  {"OverBrace;", 10, "\342\217\236"},
+  {"OverBracket;", 12, "\342\216\264"},
+  {"OverParenthesis;", 16, "\342\217\234"},
+  {"PartialD;", 9, "\342\210\202"},
+  {"Pcy;", 4, "\320\237"},
+  {"Pfr;", 4, "\360\235\224\223"},
+  {"Phi;", 4, "\316\246"},
+  {"Pi;", 3, "\316\240"},
+  {"PlusMinus;", 10, "\302\261"},
+  {"Poincareplane;", 14, "\342\204\214"},
+  {"Popf;", 5, "\342\204\231"},
+  {"Pr;", 3, "\342\252\273"},
+  {"Precedes;", 9, "\342\211\272"},
+  {"PrecedesEqual;", 14, "\342\252\257"},
+  {"PrecedesSlantEqual;", 19, "\342\211\274"},
+  {"PrecedesTilde;", 14, "\342\211\276"},
+  {"Prime;", 6, "\342\200\263"},
+  {"Product;", 8, "\342\210\217"},
+  {"Proportion;", 11, "\342\210\267"},
+  {"Proportional;", 13, "\342\210\235"},
+  {"Pscr;", 5, "\360\235\222\253"},
+  {"Psi;", 4, "\316\250"},
+  {"QUOT", 4, "\042"},
+  {"QUOT;", 5, "\042"},
+  {"Qfr;", 4, "\360\235\224\224"},
+  {"Qopf;", 5, "\342\204\232"},
+  {"Qscr;", 5, "\360\235\222\254"},
+  {"RBarr;", 6, "\342\244\220"},
+  {"REG", 3, "\302\256"},
+  {"REG;", 4, "\302\256"},
+  {"Racute;", 7, "\305\224"},
+  {"Rang;", 5, "\342\237\253"},
+  {"Rarr;", 5, "\342\206\240"},
+  {"Rarrtl;", 7, "\342\244\226"},
+  {"Rcaron;", 7, "\305\230"},
+  {"Rcedil;", 7, "\305\226"},
+  {"Rcy;", 4, "\320\240"},
+  {"Re;", 3, "\342\204\234"},
+  {"ReverseElement;", 15, "\342\210\213"},
+  {"ReverseEquilibrium;", 19, "\342\207\213"},
+  {"ReverseUpEquilibrium;", 21, "\342\245\257"},
+  {"Rfr;", 4, "\342\204\234"},
+  {"Rho;", 4, "\316\241"},
+  {"RightAngleBracket;", 18, "\342\237\251"},
+  {"RightArrow;", 11, "\342\206\222"},
+  {"RightArrowBar;", 14, "\342\207\245"},
+  {"RightArrowLeftArrow;", 20, "\342\207\204"},
+  {"RightCeiling;", 13, "\342\214\211"},
+  {"RightDoubleBracket;", 19, "\342\237\247"},
+  {"RightDownTeeVector;", 19, "\342\245\235"},
+  {"RightDownVector;", 16, "\342\207\202"},
+  {"RightDownVectorBar;", 19, "\342\245\225"},
+  {"RightFloor;", 11, "\342\214\213"},
+  {"RightTee;", 9, "\342\212\242"},
+  {"RightTeeArrow;", 14, "\342\206\246"},
+  {"RightTeeVector;", 15, "\342\245\233"},
+  {"RightTriangle;", 14, "\342\212\263"},
+  {"RightTriangleBar;", 17, "\342\247\220"},
+  {"RightTriangleEqual;", 19, "\342\212\265"},
+  {"RightUpDownVector;", 18, "\342\245\217"},
+  {"RightUpTeeVector;", 17, "\342\245\234"},
+  {"RightUpVector;", 14, "\342\206\276"},
+  {"RightUpVectorBar;", 17, "\342\245\224"},
+  {"RightVector;", 12, "\342\207\200"},
+  {"RightVectorBar;", 15, "\342\245\223"},
+  {"Rightarrow;", 11, "\342\207\222"},
+  {"Ropf;", 5, "\342\204\235"},
+  {"RoundImplies;", 13, "\342\245\260"},
+  {"Rrightarrow;", 12, "\342\207\233"},
+  {"Rscr;", 5, "\342\204\233"},
+  {"Rsh;", 4, "\342\206\261"},
+  {"RuleDelayed;", 12, "\342\247\264"},
+  {"SHCHcy;", 7, "\320\251"},
+  {"SHcy;", 5, "\320\250"},
+  {"SOFTcy;", 7, "\320\254"},
+  {"Sacute;", 7, "\305\232"},
+  {"Sc;", 3, "\342\252\274"},
+  {"Scaron;", 7, "\305\240"},
+  {"Scedil;", 7, "\305\236"},
+  {"Scirc;", 6, "\305\234"},
+  {"Scy;", 4, "\320\241"},
+  {"Sfr;", 4, "\360\235\224\226"},
+  {"ShortDownArrow;", 15, "\342\206\223"},
+  {"ShortLeftArrow;", 15, "\342\206\220"},
+  {"ShortRightArrow;", 16, "\342\206\222"},
+  {"ShortUpArrow;", 13, "\342\206\221"},
+  {"Sigma;", 6, "\316\243"},
+  {"SmallCircle;", 12, "\342\210\230"},
+  {"Sopf;", 5, "\360\235\225\212"},
+  {"Sqrt;", 5, "\342\210\232"},
+  {"Square;", 7, "\342\226\241"},
+  {"SquareIntersection;", 19, "\342\212\223"},
+  {"SquareSubset;", 13, "\342\212\217"},
+  {"SquareSubsetEqual;", 18, "\342\212\221"},
+  {"SquareSuperset;", 15, "\342\212\220"},
+  {"SquareSupersetEqual;", 20, "\342\212\222"},
+  {"SquareUnion;", 12, "\342\212\224"},
+  {"Sscr;", 5, "\360\235\222\256"},
+  {"Star;", 5, "\342\213\206"},
+  {"Sub;", 4, "\342\213\220"},
+  {"Subset;", 7, "\342\213\220"},
+  {"SubsetEqual;", 12, "\342\212\206"},
+  {"Succeeds;", 9, "\342\211\273"},
+  {"SucceedsEqual;", 14, "\342\252\260"},
+  {"SucceedsSlantEqual;", 19, "\342\211\275"},
+  {"SucceedsTilde;", 14, "\342\211\277"},
+  {"SuchThat;", 9, "\342\210\213"},
+  {"Sum;", 4, "\342\210\221"},
+  {"Sup;", 4, "\342\213\221"},
+  {"Superset;", 9, "\342\212\203"},
+  {"SupersetEqual;", 14, "\342\212\207"},
+  {"Supset;", 7, "\342\213\221"},
+  {"THORN", 5, "\303\236"},
+  {"THORN;", 6, "\303\236"},
+  {"TRADE;", 6, "\342\204\242"},
+  {"TSHcy;", 6, "\320\213"},
+  {"TScy;", 5, "\320\246"},
+  {"Tab;", 4, "\011"},
+  {"Tau;", 4, "\316\244"},
+  {"Tcaron;", 7, "\305\244"},
+  {"Tcedil;", 7, "\305\242"},
+  {"Tcy;", 4, "\320\242"},
+  {"Tfr;", 4, "\360\235\224\227"},
+  {"Therefore;", 10, "\342\210\264"},
+  {"Theta;", 6, "\316\230"},
+  {"ThickSpace;", 11, "\342\201\237\342\200\212"},
+  {"ThinSpace;", 10, "\342\200\211"},
+  {"Tilde;", 6, "\342\210\274"},
+  {"TildeEqual;", 11, "\342\211\203"},
+  {"TildeFullEqual;", 15, "\342\211\205"},
+  {"TildeTilde;", 11, "\342\211\210"},
+  {"Topf;", 5, "\360\235\225\213"},
+  {"TripleDot;", 10, "\342\203\233"},
+  {"Tscr;", 5, "\360\235\222\257"},
+  {"Tstrok;", 7, "\305\246"},
+  {"Uacute", 6, "\303\232"},
+  {"Uacute;", 7, "\303\232"},
+  {"Uarr;", 5, "\342\206\237"},
+  {"Uarrocir;", 9, "\342\245\211"},
+  {"Ubrcy;", 6, "\320\216"},
+  {"Ubreve;", 7, "\305\254"},
+  {"Ucirc", 5, "\303\233"},
+  {"Ucirc;", 6, "\303\233"},
+  {"Ucy;", 4, "\320\243"},
+  {"Udblac;", 7, "\305\260"},
+  {"Ufr;", 4, "\360\235\224\230"},
+  {"Ugrave", 6, "\303\231"},
+  {"Ugrave;", 7, "\303\231"},
+  {"Umacr;", 6, "\305\252"},
+  {"UnderBar;", 9, "_"},
+  {"UnderBrace;", 11, "\342\217\237"},
+  {"UnderBracket;", 13, "\342\216\265"},
+  {"UnderParenthesis;", 17, "\342\217\235"},
+  {"Union;", 6, "\342\213\203"},
+  {"UnionPlus;", 10, "\342\212\216"},
+  {"Uogon;", 6, "\305\262"},
+  {"Uopf;", 5, "\360\235\225\214"},
+  {"UpArrow;", 8, "\342\206\221"},
+  {"UpArrowBar;", 11, "\342\244\222"},
+  {"UpArrowDownArrow;", 17, "\342\207\205"},
+  {"UpDownArrow;", 12, "\342\206\225"},
+  {"UpEquilibrium;", 14, "\342\245\256"},
+  {"UpTee;", 6, "\342\212\245"},
+  {"UpTeeArrow;", 11, "\342\206\245"},
+  {"Uparrow;", 8, "\342\207\221"},
+  {"Updownarrow;", 12, "\342\207\225"},
+  {"UpperLeftArrow;", 15, "\342\206\226"},
+  {"UpperRightArrow;", 16, "\342\206\227"},
+  {"Upsi;", 5, "\317\222"},
+  {"Upsilon;", 8, "\316\245"},
+  {"Uring;", 6, "\305\256"},
+  {"Uscr;", 5, "\360\235\222\260"},
+  {"Utilde;", 7, "\305\250"},
+  {"Uuml", 4, "\303\234"},
+  {"Uuml;", 5, "\303\234"},
+  {"VDash;", 6, "\342\212\253"},
+  {"Vbar;", 5, "\342\253\253"},
+  {"Vcy;", 4, "\320\222"},
+  {"Vdash;", 6, "\342\212\251"},
+  {"Vdashl;", 7, "\342\253\246"},
+  {"Vee;", 4, "\342\213\201"},
+  {"Verbar;", 7, "\342\200\226"},
+  {"Vert;", 5, "\342\200\226"},
+  {"VerticalBar;", 12, "\342\210\243"},
+  {"VerticalLine;", 13, "|"},
+  {"VerticalSeparator;", 18, "\342\235\230"},
+  {"VerticalTilde;", 14, "\342\211\200"},
+  {"VeryThinSpace;", 14, "\342\200\212"},
+  {"Vfr;", 4, "\360\235\224\231"},
+  {"Vopf;", 5, "\360\235\225\215"},
+  {"Vscr;", 5, "\360\235\222\261"},
+  {"Vvdash;", 7, "\342\212\252"},
+  {"Wcirc;", 6, "\305\264"},
+  {"Wedge;", 6, "\342\213\200"},
+  {"Wfr;", 4, "\360\235\224\232"},
+  {"Wopf;", 5, "\360\235\225\216"},
+  {"Wscr;", 5, "\360\235\222\262"},
+  {"Xfr;", 4, "\360\235\224\233"},
+  {"Xi;", 3, "\316\236"},
+  {"Xopf;", 5, "\360\235\225\217"},
+  {"Xscr;", 5, "\360\235\222\263"},
+  {"YAcy;", 5, "\320\257"},
+  {"YIcy;", 5, "\320\207"},
+  {"YUcy;", 5, "\320\256"},
+  {"Yacute", 6, "\303\235"},
+  {"Yacute;", 7, "\303\235"},
+  {"Ycirc;", 6, "\305\266"},
+  {"Ycy;", 4, "\320\253"},
+  {"Yfr;", 4, "\360\235\224\234"},
+  {"Yopf;", 5, "\360\235\225\220"},
+  {"Yscr;", 5, "\360\235\222\264"},
+  {"Yuml;", 5, "\305\270"},
+  {"ZHcy;", 5, "\320\226"},
+  {"Zacute;", 7, "\305\271"},
+  {"Zcaron;", 7, "\305\275"},
+  {"Zcy;", 4, "\320\227"},
+  {"Zdot;", 5, "\305\273"},
+  {"ZeroWidthSpace;", 15, "\342\200\213"},
+  {"Zeta;", 5, "\316\226"},
+  {"Zfr;", 4, "\342\204\250"},
+  {"Zopf;", 5, "\342\204\244"},
+  {"Zscr;", 5, "\360\235\222\265"},
+  {"aacute", 6, "\303\241"},
+  {"aacute;", 7, "\303\241"},
+  {"abreve;", 7, "\304\203"},
+  {"ac;", 3, "\342\210\276"},
+  {"acE;", 4, "\342\210\276\314\263"},
+  {"acd;", 4, "\342\210\277"},
+  {"acirc", 5, "\303\242"},
+  {"acirc;", 6, "\303\242"},
+  {"acute", 5, "\302\264"},
+  {"acute;", 6, "\302\264"},
+  {"acy;", 4, "\320\260"},
+  {"aelig", 5, "\303\246"},
+  {"aelig;", 6, "\303\246"},
+  {"af;", 3, "\342\201\241"},
+  {"afr;", 4, "\360\235\224\236"},
+  {"agrave", 6, "\303\240"},
+  {"agrave;", 7, "\303\240"},
+  {"alefsym;", 8, "\342\204\265"},
+  {"aleph;", 6, "\342\204\265"},
+  {"alpha;", 6, "\316\261"},
+  {"amacr;", 6, "\304\201"},
+  {"amalg;", 6, "\342\250\277"},
+  {"amp", 3, "&"},
+  {"amp;", 4, "&"},
+  {"and;", 4, "\342\210\247"},
+  {"andand;", 7, "\342\251\225"},
+  {"andd;", 5, "\342\251\234"},
+  {"andslope;", 9, "\342\251\230"},
+  {"andv;", 5, "\342\251\232"},
+  {"ang;", 4, "\342\210\240"},
+  {"ange;", 5, "\342\246\244"},
+  {"angle;", 6, "\342\210\240"},
+  {"angmsd;", 7, "\342\210\241"},
+  {"angmsdaa;", 9, "\342\246\250"},
+  {"angmsdab;", 9, "\342\246\251"},
+  {"angmsdac;", 9, "\342\246\252"},
+  {"angmsdad;", 9, "\342\246\253"},
+  {"angmsdae;", 9, "\342\246\254"},
+  {"angmsdaf;", 9, "\342\246\255"},
+  {"angmsdag;", 9, "\342\246\256"},
+  {"angmsdah;", 9, "\342\246\257"},
+  {"angrt;", 6, "\342\210\237"},
+  {"angrtvb;", 8, "\342\212\276"},
+  {"angrtvbd;", 9, "\342\246\235"},
+  {"angsph;", 7, "\342\210\242"},
+  {"angst;", 6, "\303\205"},
+  {"angzarr;", 8, "\342\215\274"},
+  {"aogon;", 6, "\304\205"},
+  {"aopf;", 5, "\360\235\225\222"},
+  {"ap;", 3, "\342\211\210"},
+  {"apE;", 4, "\342\251\260"},
+  {"apacir;", 7, "\342\251\257"},
+  {"ape;", 4, "\342\211\212"},
+  {"apid;", 5, "\342\211\213"},
+  {"apos;", 5, "'"},
+  {"approx;", 7, "\342\211\210"},
+  {"approxeq;", 9, "\342\211\212"},
+  {"aring", 5, "\303\245"},
+  {"aring;", 6, "\303\245"},
+  {"ascr;", 5, "\360\235\222\266"},
+  {"ast;", 4, "*"},
+  {"asymp;", 6, "\342\211\210"},
+  {"asympeq;", 8, "\342\211\215"},
+  {"atilde", 6, "\303\243"},
+  {"atilde;", 7, "\303\243"},
+  {"auml", 4, "\303\244"},
+  {"auml;", 5, "\303\244"},
+  {"awconint;", 9, "\342\210\263"},
+  {"awint;", 6, "\342\250\221"},
+  {"bNot;", 5, "\342\253\255"},
+  {"backcong;", 9, "\342\211\214"},
+  {"backepsilon;", 12, "\317\266"},
+  {"backprime;", 10, "\342\200\265"},
+  {"backsim;", 8, "\342\210\275"},
+  {"backsimeq;", 10, "\342\213\215"},
+  {"barvee;", 7, "\342\212\275"},
+  {"barwed;", 7, "\342\214\205"},
+  {"barwedge;", 9, "\342\214\205"},
+  {"bbrk;", 5, "\342\216\265"},
+  {"bbrktbrk;", 9, "\342\216\266"},
+  {"bcong;", 6, "\342\211\214"},
+  {"bcy;", 4, "\320\261"},
+  {"bdquo;", 6, "\342\200\236"},
+  {"becaus;", 7, "\342\210\265"},
+  {"because;", 8, "\342\210\265"},
+  {"bemptyv;", 8, "\342\246\260"},
+  {"bepsi;", 6, "\317\266"},
+  {"bernou;", 7, "\342\204\254"},
+  {"beta;", 5, "\316\262"},
+  {"beth;", 5, "\342\204\266"},
+  {"between;", 8, "\342\211\254"},
+  {"bfr;", 4, "\360\235\224\237"},
+  {"bigcap;", 7, "\342\213\202"},
+  {"bigcirc;", 8, "\342\227\257"},
+  {"bigcup;", 7, "\342\213\203"},
+  {"bigodot;", 8, "\342\250\200"},
+  {"bigoplus;", 9, "\342\250\201"},
+  {"bigotimes;", 10, "\342\250\202"},
+  {"bigsqcup;", 9, "\342\250\206"},
+  {"bigstar;", 8, "\342\230\205"},
+  {"bigtriangledown;", 16, "\342\226\275"},
+  {"bigtriangleup;", 14, "\342\226\263"},
+  {"biguplus;", 9, "\342\250\204"},
+  {"bigvee;", 7, "\342\213\201"},
+  {"bigwedge;", 9, "\342\213\200"},
+  {"bkarow;", 7, "\342\244\215"},
+  {"blacklozenge;", 13, "\342\247\253"},
+  {"blacksquare;", 12, "\342\226\252"},
+  {"blacktriangle;", 14, "\342\226\264"},
+  {"blacktriangledown;", 18, "\342\226\276"},
+  {"blacktriangleleft;", 18, "\342\227\202"},
+  {"blacktriangleright;", 19, "\342\226\270"},
+  {"blank;", 6, "\342\220\243"},
+  {"blk12;", 6, "\342\226\222"},
+  {"blk14;", 6, "\342\226\221"},
+  {"blk34;", 6, "\342\226\223"},
+  {"block;", 6, "\342\226\210"},
+  {"bne;", 4, "=\342\203\245"},
+  {"bnequiv;", 8, "\342\211\241\342\203\245"},
+  {"bnot;", 5, "\342\214\220"},
+  {"bopf;", 5, "\360\235\225\223"},
+  {"bot;", 4, "\342\212\245"},
+  {"bottom;", 7, "\342\212\245"},
+  {"bowtie;", 7, "\342\213\210"},
+  {"boxDL;", 6, "\342\225\227"},
+  {"boxDR;", 6, "\342\225\224"},
+  {"boxDl;", 6, "\342\225\226"},
+  {"boxDr;", 6, "\342\225\223"},
+  {"boxH;", 5, "\342\225\220"},
+  {"boxHD;", 6, "\342\225\246"},
+  {"boxHU;", 6, "\342\225\251"},
+  {"boxHd;", 6, "\342\225\244"},
+  {"boxHu;", 6, "\342\225\247"},
+  {"boxUL;", 6, "\342\225\235"},
+  {"boxUR;", 6, "\342\225\232"},
+  {"boxUl;", 6, "\342\225\234"},
+  {"boxUr;", 6, "\342\225\231"},
+  {"boxV;", 5, "\342\225\221"},
+  {"boxVH;", 6, "\342\225\254"},
+  {"boxVL;", 6, "\342\225\243"},
+  {"boxVR;", 6, "\342\225\240"},
+  {"boxVh;", 6, "\342\225\253"},
+  {"boxVl;", 6, "\342\225\242"},
+  {"boxVr;", 6, "\342\225\237"},
+  {"boxbox;", 7, "\342\247\211"},
+  {"boxdL;", 6, "\342\225\225"},
+  {"boxdR;", 6, "\342\225\222"},
+  {"boxdl;", 6, "\342\224\220"},
+  {"boxdr;", 6, "\342\224\214"},
+  {"boxh;", 5, "\342\224\200"},
+  {"boxhD;", 6, "\342\225\245"},
+  {"boxhU;", 6, "\342\225\250"},
+  {"boxhd;", 6, "\342\224\254"},
+  {"boxhu;", 6, "\342\224\264"},
+  {"boxminus;", 9, "\342\212\237"},
+  {"boxplus;", 8, "\342\212\236"},
+  {"boxtimes;", 9, "\342\212\240"},
+  {"boxuL;", 6, "\342\225\233"},
+  {"boxuR;", 6, "\342\225\230"},
+  {"boxul;", 6, "\342\224\230"},
+  {"boxur;", 6, "\342\224\224"},
+  {"boxv;", 5, "\342\224\202"},
+  {"boxvH;", 6, "\342\225\252"},
+  {"boxvL;", 6, "\342\225\241"},
+  {"boxvR;", 6, "\342\225\236"},
+  {"boxvh;", 6, "\342\224\274"},
+  {"boxvl;", 6, "\342\224\244"},
+  {"boxvr;", 6, "\342\224\234"},
+  {"bprime;", 7, "\342\200\265"},
+  {"breve;", 6, "\313\230"},
+  {"brvbar", 6, "\302\246"},
+  {"brvbar;", 7, "\302\246"},
+  {"bscr;", 5, "\360\235\222\267"},
+  {"bsemi;", 6, "\342\201\217"},
+  {"bsim;", 5, "\342\210\275"},
+  {"bsime;", 6, "\342\213\215"},
+  {"bsol;", 5, "\134"},
+  {"bsolb;", 6, "\342\247\205"},
+  {"bsolhsub;", 9, "\342\237\210"},
+  {"bull;", 5, "\342\200\242"},
+  {"bullet;", 7, "\342\200\242"},
+  {"bump;", 5, "\342\211\216"},
+  {"bumpE;", 6, "\342\252\256"},
+  {"bumpe;", 6, "\342\211\217"},
+  {"bumpeq;", 7, "\342\211\217"},
+  {"cacute;", 7, "\304\207"},
+  {"cap;", 4, "\342\210\251"},
+  {"capand;", 7, "\342\251\204"},
+  {"capbrcup;", 9, "\342\251\211"},
+  {"capcap;", 7, "\342\251\213"},
+  {"capcup;", 7, "\342\251\207"},
+  {"capdot;", 7, "\342\251\200"},
+  {"caps;", 5, "\342\210\251\357\270\200"},
+  {"caret;", 6, "\342\201\201"},
+  {"caron;", 6, "\313\207"},
+  {"ccaps;", 6, "\342\251\215"},
+  {"ccaron;", 7, "\304\215"},
+  {"ccedil", 6, "\303\247"},
+  {"ccedil;", 7, "\303\247"},
+  {"ccirc;", 6, "\304\211"},
+  {"ccups;", 6, "\342\251\214"},
+  {"ccupssm;", 8, "\342\251\220"},
+  {"cdot;", 5, "\304\213"},
+  {"cedil", 5, "\302\270"},
+  {"cedil;", 6, "\302\270"},
+  {"cemptyv;", 8, "\342\246\262"},
+  {"cent", 4, "\302\242"},
+  {"cent;", 5, "\302\242"},
+  {"centerdot;", 10, "\302\267"},
+  {"cfr;", 4, "\360\235\224\240"},
+  {"chcy;", 5, "\321\207"},
+  {"check;", 6, "\342\234\223"},
+  {"checkmark;", 10, "\342\234\223"},
+  {"chi;", 4, "\317\207"},
+  {"cir;", 4, "\342\227\213"},
+  {"cirE;", 5, "\342\247\203"},
+  {"circ;", 5, "\313\206"},
+  {"circeq;", 7, "\342\211\227"},
+  {"circlearrowleft;", 16, "\342\206\272"},
+  {"circlearrowright;", 17, "\342\206\273"},
+  {"circledR;", 9, "\302\256"},
+  {"circledS;", 9, "\342\223\210"},
+  {"circledast;", 11, "\342\212\233"},
+  {"circledcirc;", 12, "\342\212\232"},
+  {"circleddash;", 12, "\342\212\235"},
+  {"cire;", 5, "\342\211\227"},
+  {"cirfnint;", 9, "\342\250\220"},
+  {"cirmid;", 7, "\342\253\257"},
+  {"cirscir;", 8, "\342\247\202"},
+  {"clubs;", 6, "\342\231\243"},
+  {"clubsuit;", 9, "\342\231\243"},
+  {"colon;", 6, ":"},
+  {"colone;", 7, "\342\211\224"},
+  {"coloneq;", 8, "\342\211\224"},
+  {"comma;", 6, ","},
+  {"commat;", 7, "@"},
+  {"comp;", 5, "\342\210\201"},
+  {"compfn;", 7, "\342\210\230"},
+  {"complement;", 11, "\342\210\201"},
+  {"complexes;", 10, "\342\204\202"},
+  {"cong;", 5, "\342\211\205"},
+  {"congdot;", 8, "\342\251\255"},
+  {"conint;", 7, "\342\210\256"},
+  {"copf;", 5, "\360\235\225\224"},
+  {"coprod;", 7, "\342\210\220"},
+  {"copy", 4, "\302\251"},
+  {"copy;", 5, "\302\251"},
+  {"copysr;", 7, "\342\204\227"},
+  {"crarr;", 6, "\342\206\265"},
+  {"cross;", 6, "\342\234\227"},
+  {"cscr;", 5, "\360\235\222\270"},
+  {"csub;", 5, "\342\253\217"},
+  {"csube;", 6, "\342\253\221"},
+  {"csup;", 5, "\342\253\220"},
+  {"csupe;", 6, "\342\253\222"},
+  {"ctdot;", 6, "\342\213\257"},
+  {"cudarrl;", 8, "\342\244\270"},
+  {"cudarrr;", 8, "\342\244\265"},
+  {"cuepr;", 6, "\342\213\236"},
+  {"cuesc;", 6, "\342\213\237"},
+  {"cularr;", 7, "\342\206\266"},
+  {"cularrp;", 8, "\342\244\275"},
+  {"cup;", 4, "\342\210\252"},
+  {"cupbrcap;", 9, "\342\251\210"},
+  {"cupcap;", 7, "\342\251\206"},
+  {"cupcup;", 7, "\342\251\212"},
+  {"cupdot;", 7, "\342\212\215"},
+  {"cupor;", 6, "\342\251\205"},
+  {"cups;", 5, "\342\210\252\357\270\200"},
+  {"curarr;", 7, "\342\206\267"},
+  {"curarrm;", 8, "\342\244\274"},
+  {"curlyeqprec;", 12, "\342\213\236"},
+  {"curlyeqsucc;", 12, "\342\213\237"},
+  {"curlyvee;", 9, "\342\213\216"},
+  {"curlywedge;", 11, "\342\213\217"},
+  {"curren", 6, "\302\244"},
+  {"curren;", 7, "\302\244"},
+  {"curvearrowleft;", 15, "\342\206\266"},
+  {"curvearrowright;", 16, "\342\206\267"},
+  {"cuvee;", 6, "\342\213\216"},
+  {"cuwed;", 6, "\342\213\217"},
+  {"cwconint;", 9, "\342\210\262"},
+  {"cwint;", 6, "\342\210\261"},
+  {"cylcty;", 7, "\342\214\255"},
+  {"dArr;", 5, "\342\207\223"},
+  {"dHar;", 5, "\342\245\245"},
+  {"dagger;", 7, "\342\200\240"},
+  {"daleth;", 7, "\342\204\270"},
+  {"darr;", 5, "\342\206\223"},
+  {"dash;", 5, "\342\200\220"},
+  {"dashv;", 6, "\342\212\243"},
+  {"dbkarow;", 8, "\342\244\217"},
+  {"dblac;", 6, "\313\235"},
+  {"dcaron;", 7, "\304\217"},
+  {"dcy;", 4, "\320\264"},
+  {"dd;", 3, "\342\205\206"},
+  {"ddagger;", 8, "\342\200\241"},
+  {"ddarr;", 6, "\342\207\212"},
+  {"ddotseq;", 8, "\342\251\267"},
+  {"deg", 3, "\302\260"},
+  {"deg;", 4, "\302\260"},
+  {"delta;", 6, "\316\264"},
+  {"demptyv;", 8, "\342\246\261"},
+  {"dfisht;", 7, "\342\245\277"},
+  {"dfr;", 4, "\360\235\224\241"},
+  {"dharl;", 6, "\342\207\203"},
+  {"dharr;", 6, "\342\207\202"},
+  {"diam;", 5, "\342\213\204"},
+  {"diamond;", 8, "\342\213\204"},
+  {"diamondsuit;", 12, "\342\231\246"},
+  {"diams;", 6, "\342\231\246"},
+  {"die;", 4, "\302\250"},
+  {"digamma;", 8, "\317\235"},
+  {"disin;", 6, "\342\213\262"},
+  {"div;", 4, "\303\267"},
+  {"divide", 6, "\303\267"},
+  {"divide;", 7, "\303\267"},
+  {"divideontimes;", 14, "\342\213\207"},
+  {"divonx;", 7, "\342\213\207"},
+  {"djcy;", 5, "\321\222"},
+  {"dlcorn;", 7, "\342\214\236"},
+  {"dlcrop;", 7, "\342\214\215"},
+  {"dollar;", 7, "$"},
+  {"dopf;", 5, "\360\235\225\225"},
+  {"dot;", 4, "\313\231"},
+  {"doteq;", 6, "\342\211\220"},
+  {"doteqdot;", 9, "\342\211\221"},
+  {"dotminus;", 9, "\342\210\270"},
+  {"dotplus;", 8, "\342\210\224"},
+  {"dotsquare;", 10, "\342\212\241"},
+  {"doublebarwedge;", 15, "\342\214\206"},
+  {"downarrow;", 10, "\342\206\223"},
+  {"downdownarrows;", 15, "\342\207\212"},
+  {"downharpoonleft;", 16, "\342\207\203"},
+  {"downharpoonright;", 17, "\342\207\202"},
+  {"drbkarow;", 9, "\342\244\220"},
+  {"drcorn;", 7, "\342\214\237"},
+  {"drcrop;", 7, "\342\214\214"},
+  {"dscr;", 5, "\360\235\222\271"},
+  {"dscy;", 5, "\321\225"},
+  {"dsol;", 5, "\342\247\266"},
+  {"dstrok;", 7, "\304\221"},
+  {"dtdot;", 6, "\342\213\261"},
+  {"dtri;", 5, "\342\226\277"},
+  {"dtrif;", 6, "\342\226\276"},
+  {"duarr;", 6, "\342\207\265"},
+  {"duhar;", 6, "\342\245\257"},
+  {"dwangle;", 8, "\342\246\246"},
+  {"dzcy;", 5, "\321\237"},
+  {"dzigrarr;", 9, "\342\237\277"},
+  {"eDDot;", 6, "\342\251\267"},
+  {"eDot;", 5, "\342\211\221"},
+  {"eacute", 6, "\303\251"},
+  {"eacute;", 7, "\303\251"},
+  {"easter;", 7, "\342\251\256"},
+  {"ecaron;", 7, "\304\233"},
+  {"ecir;", 5, "\342\211\226"},
+  {"ecirc", 5, "\303\252"},
+  {"ecirc;", 6, "\303\252"},
+  {"ecolon;", 7, "\342\211\225"},
+  {"ecy;", 4, "\321\215"},
+  {"edot;", 5, "\304\227"},
+  {"ee;", 3, "\342\205\207"},
+  {"efDot;", 6, "\342\211\222"},
+  {"efr;", 4, "\360\235\224\242"},
+  {"eg;", 3, "\342\252\232"},
+  {"egrave", 6, "\303\250"},
+  {"egrave;", 7, "\303\250"},
+  {"egs;", 4, "\342\252\226"},
+  {"egsdot;", 7, "\342\252\230"},
+  {"el;", 3, "\342\252\231"},
+  {"elinters;", 9, "\342\217\247"},
+  {"ell;", 4, "\342\204\223"},
+  {"els;", 4, "\342\252\225"},
+  {"elsdot;", 7, "\342\252\227"},
+  {"emacr;", 6, "\304\223"},
+  {"empty;", 6, "\342\210\205"},
+  {"emptyset;", 9, "\342\210\205"},
+  {"emptyv;", 7, "\342\210\205"},
+  {"emsp13;", 7, "\342\200\204"},
+  {"emsp14;", 7, "\342\200\205"},
+  {"emsp;", 5, "\342\200\203"},
+  {"eng;", 4, "\305\213"},
+  {"ensp;", 5, "\342\200\202"},
+  {"eogon;", 6, "\304\231"},
+  {"eopf;", 5, "\360\235\225\226"},
+  {"epar;", 5, "\342\213\225"},
+  {"eparsl;", 7, "\342\247\243"},
+  {"eplus;", 6, "\342\251\261"},
+  {"epsi;", 5, "\316\265"},
+  {"epsilon;", 8, "\316\265"},
+  {"epsiv;", 6, "\317\265"},
+  {"eqcirc;", 7, "\342\211\226"},
+  {"eqcolon;", 8, "\342\211\225"},
+  {"eqsim;", 6, "\342\211\202"},
+  {"eqslantgtr;", 11, "\342\252\226"},
+  {"eqslantless;", 12, "\342\252\225"},
+  {"equals;", 7, "="},
+  {"equest;", 7, "\342\211\237"},
+  {"equiv;", 6, "\342\211\241"},
+  {"equivDD;", 8, "\342\251\270"},
+  {"eqvparsl;", 9, "\342\247\245"},
+  {"erDot;", 6, "\342\211\223"},
+  {"erarr;", 6, "\342\245\261"},
+  {"escr;", 5, "\342\204\257"},
+  {"esdot;", 6, "\342\211\220"},
+  {"esim;", 5, "\342\211\202"},
+  {"eta;", 4, "\316\267"},
+  {"eth", 3, "\303\260"},
+  {"eth;", 4, "\303\260"},
+  {"euml", 4, "\303\253"},
+  {"euml;", 5, "\303\253"},
+  {"euro;", 5, "\342\202\254"},
+  {"excl;", 5, "!"},
+  {"exist;", 6, "\342\210\203"},
+  {"expectation;", 12, "\342\204\260"},
+  {"exponentiale;", 13, "\342\205\207"},
+  {"fallingdotseq;", 14, "\342\211\222"},
+  {"fcy;", 4, "\321\204"},
+  {"female;", 7, "\342\231\200"},
+  {"ffilig;", 7, "\357\254\203"},
+  {"fflig;", 6, "\357\254\200"},
+  {"ffllig;", 7, "\357\254\204"},
+  {"ffr;", 4, "\360\235\224\243"},
+  {"filig;", 6, "\357\254\201"},
+  {"fjlig;", 6, "fj"},
+  {"flat;", 5, "\342\231\255"},
+  {"fllig;", 6, "\357\254\202"},
+  {"fltns;", 6, "\342\226\261"},
+  {"fnof;", 5, "\306\222"},
+  {"fopf;", 5, "\360\235\225\227"},
+  {"forall;", 7, "\342\210\200"},
+  {"fork;", 5, "\342\213\224"},
+  {"forkv;", 6, "\342\253\231"},
+  {"fpartint;", 9, "\342\250\215"},
+  {"frac12", 6, "\302\275"},
+  {"frac12;", 7, "\302\275"},
+  {"frac13;", 7, "\342\205\223"},
+  {"frac14", 6, "\302\274"},
+  {"frac14;", 7, "\302\274"},
+  {"frac15;", 7, "\342\205\225"},
+  {"frac16;", 7, "\342\205\231"},
+  {"frac18;", 7, "\342\205\233"},
+  {"frac23;", 7, "\342\205\224"},
+  {"frac25;", 7, "\342\205\226"},
+  {"frac34", 6, "\302\276"},
+  {"frac34;", 7, "\302\276"},
+  {"frac35;", 7, "\342\205\227"},
+  {"frac38;", 7, "\342\205\234"},
+  {"frac45;", 7, "\342\205\230"},
+  {"frac56;", 7, "\342\205\232"},
+  {"frac58;", 7, "\342\205\235"},
+  {"frac78;", 7, "\342\205\236"},
+  {"frasl;", 6, "\342\201\204"},
+  {"frown;", 6, "\342\214\242"},
+  {"fscr;", 5, "\360\235\222\273"},
+  {"gE;", 3, "\342\211\247"},
+  {"gEl;", 4, "\342\252\214"},
+  {"gacute;", 7, "\307\265"},
+  {"gamma;", 6, "\316\263"},
+  {"gammad;", 7, "\317\235"},
+  {"gap;", 4, "\342\252\206"},
+  {"gbreve;", 7, "\304\237"},
+  {"gcirc;", 6, "\304\235"},
+  {"gcy;", 4, "\320\263"},
+  {"gdot;", 5, "\304\241"},
+  {"ge;", 3, "\342\211\245"},
+  {"gel;", 4, "\342\213\233"},
+  {"geq;", 4, "\342\211\245"},
+  {"geqq;", 5, "\342\211\247"},
+  {"geqslant;", 9, "\342\251\276"},
+  {"ges;", 4, "\342\251\276"},
+  {"gescc;", 6, "\342\252\251"},
+  {"gesdot;", 7, "\342\252\200"},
+  {"gesdoto;", 8, "\342\252\202"},
+  {"gesdotol;", 9, "\342\252\204"},
+  {"gesl;", 5, "\342\213\233\357\270\200"},
+  {"gesles;", 7, "\342\252\224"},
+  {"gfr;", 4, "\360\235\224\244"},
+  {"gg;", 3, "\342\211\253"},
+  {"ggg;", 4, "\342\213\231"},
+  {"gimel;", 6, "\342\204\267"},
+  {"gjcy;", 5, "\321\223"},
+  {"gl;", 3, "\342\211\267"},
+  {"glE;", 4, "\342\252\222"},
+  {"gla;", 4, "\342\252\245"},
+  {"glj;", 4, "\342\252\244"},
+  {"gnE;", 4, "\342\211\251"},
+  {"gnap;", 5, "\342\252\212"},
+  {"gnapprox;", 9, "\342\252\212"},
+  {"gne;", 4, "\342\252\210"},
+  {"gneq;", 5, "\342\252\210"},
+  {"gneqq;", 6, "\342\211\251"},
+  {"gnsim;", 6, "\342\213\247"},
+  {"gopf;", 5, "\360\235\225\230"},
+  {"grave;", 6, "`"},
+  {"gscr;", 5, "\342\204\212"},
+  {"gsim;", 5, "\342\211\263"},
+  {"gsime;", 6, "\342\252\216"},
+  {"gsiml;", 6, "\342\252\220"},
+  {"gt", 2, ">"},
+  {"gt;", 3, ">"},
+  {"gtcc;", 5, "\342\252\247"},
+  {"gtcir;", 6, "\342\251\272"},
+  {"gtdot;", 6, "\342\213\227"},
+  {"gtlPar;", 7, "\342\246\225"},
+  {"gtquest;", 8, "\342\251\274"},
+  {"gtrapprox;", 10, "\342\252\206"},
+  {"gtrarr;", 7, "\342\245\270"},
+  {"gtrdot;", 7, "\342\213\227"},
+  {"gtreqless;", 10, "\342\213\233"},
+  {"gtreqqless;", 11, "\342\252\214"},
+  {"gtrless;", 8, "\342\211\267"},
+  {"gtrsim;", 7, "\342\211\263"},
+  {"gvertneqq;", 10, "\342\211\251\357\270\200"},
+  {"gvnE;", 5, "\342\211\251\357\270\200"},
+  {"hArr;", 5, "\342\207\224"},
+  {"hairsp;", 7, "\342\200\212"},
+  {"half;", 5, "\302\275"},
+  {"hamilt;", 7, "\342\204\213"},
+  {"hardcy;", 7, "\321\212"},
+  {"harr;", 5, "\342\206\224"},
+  {"harrcir;", 8, "\342\245\210"},
+  {"harrw;", 6, "\342\206\255"},
+  {"hbar;", 5, "\342\204\217"},
+  {"hcirc;", 6, "\304\245"},
+  {"hearts;", 7, "\342\231\245"},
+  {"heartsuit;", 10, "\342\231\245"},
+  {"hellip;", 7, "\342\200\246"},
+  {"hercon;", 7, "\342\212\271"},
+  {"hfr;", 4, "\360\235\224\245"},
+  {"hksearow;", 9, "\342\244\245"},
+  {"hkswarow;", 9, "\342\244\246"},
+  {"hoarr;", 6, "\342\207\277"},
+  {"homtht;", 7, "\342\210\273"},
+  {"hookleftarrow;", 14, "\342\206\251"},
+  {"hookrightarrow;", 15, "\342\206\252"},
+  {"hopf;", 5, "\360\235\225\231"},
+  {"horbar;", 7, "\342\200\225"},
+  {"hscr;", 5, "\360\235\222\275"},
+  {"hslash;", 7, "\342\204\217"},
+  {"hstrok;", 7, "\304\247"},
+  {"hybull;", 7, "\342\201\203"},
+  {"hyphen;", 7, "\342\200\220"},
+  {"iacute", 6, "\303\255"},
+  {"iacute;", 7, "\303\255"},
+  {"ic;", 3, "\342\201\243"},
+  {"icirc", 5, "\303\256"},
+  {"icirc;", 6, "\303\256"},
+  {"icy;", 4, "\320\270"},
+  {"iecy;", 5, "\320\265"},
+  {"iexcl", 5, "\302\241"},
+  {"iexcl;", 6, "\302\241"},
+  {"iff;", 4, "\342\207\224"},
+  {"ifr;", 4, "\360\235\224\246"},
+  {"igrave", 6, "\303\254"},
+  {"igrave;", 7, "\303\254"},
+  {"ii;", 3, "\342\205\210"},
+  {"iiiint;", 7, "\342\250\214"},
+  {"iiint;", 6, "\342\210\255"},
+  {"iinfin;", 7, "\342\247\234"},
+  {"iiota;", 6, "\342\204\251"},
+  {"ijlig;", 6, "\304\263"},
+  {"imacr;", 6, "\304\253"},
+  {"image;", 6, "\342\204\221"},
+  {"imagline;", 9, "\342\204\220"},
+  {"imagpart;", 9, "\342\204\221"},
+  {"imath;", 6, "\304\261"},
+  {"imof;", 5, "\342\212\267"},
+  {"imped;", 6, "\306\265"},
+  {"in;", 3, "\342\210\210"},
+  {"incare;", 7, "\342\204\205"},
+  {"infin;", 6, "\342\210\236"},
+  {"infintie;", 9, "\342\247\235"},
+  {"inodot;", 7, "\304\261"},
+  {"int;", 4, "\342\210\253"},
+  {"intcal;", 7, "\342\212\272"},
+  {"integers;", 9, "\342\204\244"},
+  {"intercal;", 9, "\342\212\272"},
+  {"intlarhk;", 9, "\342\250\227"},
+  {"intprod;", 8, "\342\250\274"},
+  {"iocy;", 5, "\321\221"},
+  {"iogon;", 6, "\304\257"},
+  {"iopf;", 5, "\360\235\225\232"},
+  {"iota;", 5, "\316\271"},
+  {"iprod;", 6, "\342\250\274"},
+  {"iquest", 6, "\302\277"},
+  {"iquest;", 7, "\302\277"},
+  {"iscr;", 5, "\360\235\222\276"},
+  {"isin;", 5, "\342\210\210"},
+  {"isinE;", 6, "\342\213\271"},
+  {"isindot;", 8, "\342\213\265"},
+  {"isins;", 6, "\342\213\264"},
+  {"isinsv;", 7, "\342\213\263"},
+  {"isinv;", 6, "\342\210\210"},
+  {"it;", 3, "\342\201\242"},
+  {"itilde;", 7, "\304\251"},
+  {"iukcy;", 6, "\321\226"},
+  {"iuml", 4, "\303\257"},
+  {"iuml;", 5, "\303\257"},
+  {"jcirc;", 6, "\304\265"},
+  {"jcy;", 4, "\320\271"},
+  {"jfr;", 4, "\360\235\224\247"},
+  {"jmath;", 6, "\310\267"},
+  {"jopf;", 5, "\360\235\225\233"},
+  {"jscr;", 5, "\360\235\222\277"},
+  {"jsercy;", 7, "\321\230"},
+  {"jukcy;", 6, "\321\224"},
+  {"kappa;", 6, "\316\272"},
+  {"kappav;", 7, "\317\260"},
+  {"kcedil;", 7, "\304\267"},
+  {"kcy;", 4, "\320\272"},
+  {"kfr;", 4, "\360\235\224\250"},
+  {"kgreen;", 7, "\304\270"},
+  {"khcy;", 5, "\321\205"},
+  {"kjcy;", 5, "\321\234"},
+  {"kopf;", 5, "\360\235\225\234"},
+  {"kscr;", 5, "\360\235\223\200"},
+  {"lAarr;", 6, "\342\207\232"},
+  {"lArr;", 5, "\342\207\220"},
+  {"lAtail;", 7, "\342\244\233"},
+  {"lBarr;", 6, "\342\244\216"},
+  {"lE;", 3, "\342\211\246"},
+  {"lEg;", 4, "\342\252\213"},
+  {"lHar;", 5, "\342\245\242"},
+  {"lacute;", 7, "\304\272"},
+  {"laemptyv;", 9, "\342\246\264"},
+  {"lagran;", 7, "\342\204\222"},
+  {"lambda;", 7, "\316\273"},
+  {"lang;", 5, "\342\237\250"},
+  {"langd;", 6, "\342\246\221"},
+  {"langle;", 7, "\342\237\250"},
+  {"lap;", 4, "\342\252\205"},
+  {"laquo", 5, "\302\253"},
+  {"laquo;", 6, "\302\253"},
+  {"larr;", 5, "\342\206\220"},
+  {"larrb;", 6, "\342\207\244"},
+  {"larrbfs;", 8, "\342\244\237"},
+  {"larrfs;", 7, "\342\244\235"},
+  {"larrhk;", 7, "\342\206\251"},
+  {"larrlp;", 7, "\342\206\253"},
+  {"larrpl;", 7, "\342\244\271"},
+  {"larrsim;", 8, "\342\245\263"},
+  {"larrtl;", 7, "\342\206\242"},
+  {"lat;", 4, "\342\252\253"},
+  {"latail;", 7, "\342\244\231"},
+  {"late;", 5, "\342\252\255"},
+  {"lates;", 6, "\342\252\255\357\270\200"},
+  {"lbarr;", 6, "\342\244\214"},
+  {"lbbrk;", 6, "\342\235\262"},
+  {"lbrace;", 7, "{"},
+  {"lbrack;", 7, "["},
+  {"lbrke;", 6, "\342\246\213"},
+  {"lbrksld;", 8, "\342\246\217"},
+  {"lbrkslu;", 8, "\342\246\215"},
+  {"lcaron;", 7, "\304\276"},
+  {"lcedil;", 7, "\304\274"},
+  {"lceil;", 6, "\342\214\210"},
+  {"lcub;", 5, "{"},
+  {"lcy;", 4, "\320\273"},
+  {"ldca;", 5, "\342\244\266"},
+  {"ldquo;", 6, "\342\200\234"},
+  {"ldquor;", 7, "\342\200\236"},
+  {"ldrdhar;", 8, "\342\245\247"},
+  {"ldrushar;", 9, "\342\245\213"},
+  {"ldsh;", 5, "\342\206\262"},
+  {"le;", 3, "\342\211\244"},
+  {"leftarrow;", 10, "\342\206\220"},
+  {"leftarrowtail;", 14, "\342\206\242"},
+  {"leftharpoondown;", 16, "\342\206\275"},
+  {"leftharpoonup;", 14, "\342\206\274"},
+  {"leftleftarrows;", 15, "\342\207\207"},
+  {"leftrightarrow;", 15, "\342\206\224"},
+  {"leftrightarrows;", 16, "\342\207\206"},
+  {"leftrightharpoons;", 18, "\342\207\213"},
+  {"leftrightsquigarrow;", 20, "\342\206\255"},
+  {"leftthreetimes;", 15, "\342\213\213"},
+  {"leg;", 4, "\342\213\232"},
+  {"leq;", 4, "\342\211\244"},
+  {"leqq;", 5, "\342\211\246"},
+  {"leqslant;", 9, "\342\251\275"},
+  {"les;", 4, "\342\251\275"},
+  {"lescc;", 6, "\342\252\250"},
+  {"lesdot;", 7, "\342\251\277"},
+  {"lesdoto;", 8, "\342\252\201"},
+  {"lesdotor;", 9, "\342\252\203"},
+  {"lesg;", 5, "\342\213\232\357\270\200"},
+  {"lesges;", 7, "\342\252\223"},
+  {"lessapprox;", 11, "\342\252\205"},
+  {"lessdot;", 8, "\342\213\226"},
+  {"lesseqgtr;", 10, "\342\213\232"},
+  {"lesseqqgtr;", 11, "\342\252\213"},
+  {"lessgtr;", 8, "\342\211\266"},
+  {"lesssim;", 8, "\342\211\262"},
+  {"lfisht;", 7, "\342\245\274"},
+  {"lfloor;", 7, "\342\214\212"},
+  {"lfr;", 4, "\360\235\224\251"},
+  {"lg;", 3, "\342\211\266"},
+  {"lgE;", 4, "\342\252\221"},
+  {"lhard;", 6, "\342\206\275"},
+  {"lharu;", 6, "\342\206\274"},
+  {"lharul;", 7, "\342\245\252"},
+  {"lhblk;", 6, "\342\226\204"},
+  {"ljcy;", 5, "\321\231"},
+  {"ll;", 3, "\342\211\252"},
+  {"llarr;", 6, "\342\207\207"},
+  {"llcorner;", 9, "\342\214\236"},
+  {"llhard;", 7, "\342\245\253"},
+  {"lltri;", 6, "\342\227\272"},
+  {"lmidot;", 7, "\305\200"},
+  {"lmoust;", 7, "\342\216\260"},
+  {"lmoustache;", 11, "\342\216\260"},
+  {"lnE;", 4, "\342\211\250"},
+  {"lnap;", 5, "\342\252\211"},
+  {"lnapprox;", 9, "\342\252\211"},
+  {"lne;", 4, "\342\252\207"},
+  {"lneq;", 5, "\342\252\207"},
+  {"lneqq;", 6, "\342\211\250"},
+  {"lnsim;", 6, "\342\213\246"},
+  {"loang;", 6, "\342\237\254"},
+  {"loarr;", 6, "\342\207\275"},
+  {"lobrk;", 6, "\342\237\246"},
+  {"longleftarrow;", 14, "\342\237\265"},
+  {"longleftrightarrow;", 19, "\342\237\267"},
+  {"longmapsto;", 11, "\342\237\274"},
+  {"longrightarrow;", 15, "\342\237\266"},
+  {"looparrowleft;", 14, "\342\206\253"},
+  {"looparrowright;", 15, "\342\206\254"},
+  {"lopar;", 6, "\342\246\205"},
+  {"lopf;", 5, "\360\235\225\235"},
+  {"loplus;", 7, "\342\250\255"},
+  {"lotimes;", 8, "\342\250\264"},
+  {"lowast;", 7, "\342\210\227"},
+  {"lowbar;", 7, "_"},
+  {"loz;", 4, "\342\227\212"},
+  {"lozenge;", 8, "\342\227\212"},
+  {"lozf;", 5, "\342\247\253"},
+  {"lpar;", 5, "("},
+  {"lparlt;", 7, "\342\246\223"},
+  {"lrarr;", 6, "\342\207\206"},
+  {"lrcorner;", 9, "\342\214\237"},
+  {"lrhar;", 6, "\342\207\213"},
+  {"lrhard;", 7, "\342\245\255"},
+  {"lrm;", 4, "\342\200\216"},
+  {"lrtri;", 6, "\342\212\277"},
+  {"lsaquo;", 7, "\342\200\271"},
+  {"lscr;", 5, "\360\235\223\201"},
+  {"lsh;", 4, "\342\206\260"},
+  {"lsim;", 5, "\342\211\262"},
+  {"lsime;", 6, "\342\252\215"},
+  {"lsimg;", 6, "\342\252\217"},
+  {"lsqb;", 5, "["},
+  {"lsquo;", 6, "\342\200\230"},
+  {"lsquor;", 7, "\342\200\232"},
+  {"lstrok;", 7, "\305\202"},
+  {"lt", 2, "<"},
+  {"lt;", 3, "<"},
+  {"ltcc;", 5, "\342\252\246"},
+  {"ltcir;", 6, "\342\251\271"},
+  {"ltdot;", 6, "\342\213\226"},
+  {"lthree;", 7, "\342\213\213"},
+  {"ltimes;", 7, "\342\213\211"},
+  {"ltlarr;", 7, "\342\245\266"},
+  {"ltquest;", 8, "\342\251\273"},
+  {"ltrPar;", 7, "\342\246\226"},
+  {"ltri;", 5, "\342\227\203"},
+  {"ltrie;", 6, "\342\212\264"},
+  {"ltrif;", 6, "\342\227\202"},
+  {"lurdshar;", 9, "\342\245\212"},
+  {"luruhar;", 8, "\342\245\246"},
+  {"lvertneqq;", 10, "\342\211\250\357\270\200"},
+  {"lvnE;", 5, "\342\211\250\357\270\200"},
+  {"mDDot;", 6, "\342\210\272"},
+  {"macr", 4, "\302\257"},
+  {"macr;", 5, "\302\257"},
+  {"male;", 5, "\342\231\202"},
+  {"malt;", 5, "\342\234\240"},
+  {"maltese;", 8, "\342\234\240"},
+  {"map;", 4, "\342\206\246"},
+  {"mapsto;", 7, "\342\206\246"},
+  {"mapstodown;", 11, "\342\206\247"},
+  {"mapstoleft;", 11, "\342\206\244"},
+  {"mapstoup;", 9, "\342\206\245"},
+  {"marker;", 7, "\342\226\256"},
+  {"mcomma;", 7, "\342\250\251"},
+  {"mcy;", 4, "\320\274"},
+  {"mdash;", 6, "\342\200\224"},
+  {"measuredangle;", 14, "\342\210\241"},
+  {"mfr;", 4, "\360\235\224\252"},
+  {"mho;", 4, "\342\204\247"},
+  {"micro", 5, "\302\265"},
+  {"micro;", 6, "\302\265"},
+  {"mid;", 4, "\342\210\243"},
+  {"midast;", 7, "*"},
+  {"midcir;", 7, "\342\253\260"},
+  {"middot", 6, "\302\267"},
+  {"middot;", 7, "\302\267"},
+  {"minus;", 6, "\342\210\222"},
+  {"minusb;", 7, "\342\212\237"},
+  {"minusd;", 7, "\342\210\270"},
+  {"minusdu;", 8, "\342\250\252"},
+  {"mlcp;", 5, "\342\253\233"},
+  {"mldr;", 5, "\342\200\246"},
+  {"mnplus;", 7, "\342\210\223"},
+  {"models;", 7, "\342\212\247"},
+  {"mopf;", 5, "\360\235\225\236"},
+  {"mp;", 3, "\342\210\223"},
+  {"mscr;", 5, "\360\235\223\202"},
+  {"mstpos;", 7, "\342\210\276"},
+  {"mu;", 3, "\316\274"},
+  {"multimap;", 9, "\342\212\270"},
+  {"mumap;", 6, "\342\212\270"},
+  {"nGg;", 4, "\342\213\231\314\270"},
+  {"nGt;", 4, "\342\211\253\342\203\222"},
+  {"nGtv;", 5, "\342\211\253\314\270"},
+  {"nLeftarrow;", 11, "\342\207\215"},
+  {"nLeftrightarrow;", 16, "\342\207\216"},
+  {"nLl;", 4, "\342\213\230\314\270"},
+  {"nLt;", 4, "\342\211\252\342\203\222"},
+  {"nLtv;", 5, "\342\211\252\314\270"},
+  {"nRightarrow;", 12, "\342\207\217"},
+  {"nVDash;", 7, "\342\212\257"},
+  {"nVdash;", 7, "\342\212\256"},
+  {"nabla;", 6, "\342\210\207"},
+  {"nacute;", 7, "\305\204"},
+  {"nang;", 5, "\342\210\240\342\203\222"},
+  {"nap;", 4, "\342\211\211"},
+  {"napE;", 5, "\342\251\260\314\270"},
+  {"napid;", 6, "\342\211\213\314\270"},
+  {"napos;", 6, "\305\211"},
+  {"napprox;", 8, "\342\211\211"},
+  {"natur;", 6, "\342\231\256"},
+  {"natural;", 8, "\342\231\256"},
+  {"naturals;", 9, "\342\204\225"},
+  {"nbsp", 4, "\302\240"},
+  {"nbsp;", 5, "\302\240"},
+  {"nbump;", 6, "\342\211\216\314\270"},
+  {"nbumpe;", 7, "\342\211\217\314\270"},
+  {"ncap;", 5, "\342\251\203"},
+  {"ncaron;", 7, "\305\210"},
+  {"ncedil;", 7, "\305\206"},
+  {"ncong;", 6, "\342\211\207"},
+  {"ncongdot;", 9, "\342\251\255\314\270"},
+  {"ncup;", 5, "\342\251\202"},
+  {"ncy;", 4, "\320\275"},
+  {"ndash;", 6, "\342\200\223"},
+  {"ne;", 3, "\342\211\240"},
+  {"neArr;", 6, "\342\207\227"},
+  {"nearhk;", 7, "\342\244\244"},
+  {"nearr;", 6, "\342\206\227"},
+  {"nearrow;", 8, "\342\206\227"},
+  {"nedot;", 6, "\342\211\220\314\270"},
+  {"nequiv;", 7, "\342\211\242"},
+  {"nesear;", 7, "\342\244\250"},
+  {"nesim;", 6, "\342\211\202\314\270"},
+  {"nexist;", 7, "\342\210\204"},
+  {"nexists;", 8, "\342\210\204"},
+  {"nfr;", 4, "\360\235\224\253"},
+  {"ngE;", 4, "\342\211\247\314\270"},
+  {"nge;", 4, "\342\211\261"},
+  {"ngeq;", 5, "\342\211\261"},
+  {"ngeqq;", 6, "\342\211\247\314\270"},
+  {"ngeqslant;", 10, "\342\251\276\314\270"},
+  {"nges;", 5, "\342\251\276\314\270"},
+  {"ngsim;", 6, "\342\211\265"},
+  {"ngt;", 4, "\342\211\257"},
+  {"ngtr;", 5, "\342\211\257"},
+  {"nhArr;", 6, "\342\207\216"},
+  {"nharr;", 6, "\342\206\256"},
+  {"nhpar;", 6, "\342\253\262"},
+  {"ni;", 3, "\342\210\213"},
+  {"nis;", 4, "\342\213\274"},
+  {"nisd;", 5, "\342\213\272"},
+  {"niv;", 4, "\342\210\213"},
+  {"njcy;", 5, "\321\232"},
+  {"nlArr;", 6, "\342\207\215"},
+  {"nlE;", 4, "\342\211\246\314\270"},
+  {"nlarr;", 6, "\342\206\232"},
+  {"nldr;", 5, "\342\200\245"},
+  {"nle;", 4, "\342\211\260"},
+  {"nleftarrow;", 11, "\342\206\232"},
+  {"nleftrightarrow;", 16, "\342\206\256"},
+  {"nleq;", 5, "\342\211\260"},
+  {"nleqq;", 6, "\342\211\246\314\270"},
+  {"nleqslant;", 10, "\342\251\275\314\270"},
+  {"nles;", 5, "\342\251\275\314\270"},
+  {"nless;", 6, "\342\211\256"},
+  {"nlsim;", 6, "\342\211\264"},
+  {"nlt;", 4, "\342\211\256"},
+  {"nltri;", 6, "\342\213\252"},
+  {"nltrie;", 7, "\342\213\254"},
+  {"nmid;", 5, "\342\210\244"},
+  {"nopf;", 5, "\360\235\225\237"},
+  {"not", 3, "\302\254"},
+  {"not;", 4, "\302\254"},
+  {"notin;", 6, "\342\210\211"},
+  {"notinE;", 7, "\342\213\271\314\270"},
+  {"notindot;", 9, "\342\213\265\314\270"},
+  {"notinva;", 8, "\342\210\211"},
+  {"notinvb;", 8, "\342\213\267"},
+  {"notinvc;", 8, "\342\213\266"},
+  {"notni;", 6, "\342\210\214"},
+  {"notniva;", 8, "\342\210\214"},
+  {"notnivb;", 8, "\342\213\276"},
+  {"notnivc;", 8, "\342\213\275"},
+  {"npar;", 5, "\342\210\246"},
+  {"nparallel;", 10, "\342\210\246"},
+  {"nparsl;", 7, "\342\253\275\342\203\245"},
+  {"npart;", 6, "\342\210\202\314\270"},
+  {"npolint;", 8, "\342\250\224"},
+  {"npr;", 4, "\342\212\200"},
+  {"nprcue;", 7, "\342\213\240"},
+  {"npre;", 5, "\342\252\257\314\270"},
+  {"nprec;", 6, "\342\212\200"},
+  {"npreceq;", 8, "\342\252\257\314\270"},
+  {"nrArr;", 6, "\342\207\217"},
+  {"nrarr;", 6, "\342\206\233"},
+  {"nrarrc;", 7, "\342\244\263\314\270"},
+  {"nrarrw;", 7, "\342\206\235\314\270"},
+  {"nrightarrow;", 12, "\342\206\233"},
+  {"nrtri;", 6, "\342\213\253"},
+  {"nrtrie;", 7, "\342\213\255"},
+  {"nsc;", 4, "\342\212\201"},
+  {"nsccue;", 7, "\342\213\241"},
+  {"nsce;", 5, "\342\252\260\314\270"},
+  {"nscr;", 5, "\360\235\223\203"},
+  {"nshortmid;", 10, "\342\210\244"},
+  {"nshortparallel;", 15, "\342\210\246"},
+  {"nsim;", 5, "\342\211\201"},
+  {"nsime;", 6, "\342\211\204"},
+  {"nsimeq;", 7, "\342\211\204"},
+  {"nsmid;", 6, "\342\210\244"},
+  {"nspar;", 6, "\342\210\246"},
+  {"nsqsube;", 8, "\342\213\242"},
+  {"nsqsupe;", 8, "\342\213\243"},
+  {"nsub;", 5, "\342\212\204"},
+  {"nsubE;", 6, "\342\253\205\314\270"},
+  {"nsube;", 6, "\342\212\210"},
+  {"nsubset;", 8, "\342\212\202\342\203\222"},
+  {"nsubseteq;", 10, "\342\212\210"},
+  {"nsubseteqq;", 11, "\342\253\205\314\270"},
+  {"nsucc;", 6, "\342\212\201"},
+  {"nsucceq;", 8, "\342\252\260\314\270"},
+  {"nsup;", 5, "\342\212\205"},
+  {"nsupE;", 6, "\342\253\206\314\270"},
+  {"nsupe;", 6, "\342\212\211"},
+  {"nsupset;", 8, "\342\212\203\342\203\222"},
+  {"nsupseteq;", 10, "\342\212\211"},
+  {"nsupseteqq;", 11, "\342\253\206\314\270"},
+  {"ntgl;", 5, "\342\211\271"},
+  {"ntilde", 6, "\303\261"},
+  {"ntilde;", 7, "\303\261"},
+  {"ntlg;", 5, "\342\211\270"},
+  {"ntriangleleft;", 14, "\342\213\252"},
+  {"ntrianglelefteq;", 16, "\342\213\254"},
+  {"ntriangleright;", 15, "\342\213\253"},
+  {"ntrianglerighteq;", 17, "\342\213\255"},
+  {"nu;", 3, "\316\275"},
+  {"num;", 4, "#"},
+  {"numero;", 7, "\342\204\226"},
+  {"numsp;", 6, "\342\200\207"},
+  {"nvDash;", 7, "\342\212\255"},
+  {"nvHarr;", 7, "\342\244\204"},
+  {"nvap;", 5, "\342\211\215\342\203\222"},
+  {"nvdash;", 7, "\342\212\254"},
+  {"nvge;", 5, "\342\211\245\342\203\222"},
+  {"nvgt;", 5, ">\342\203\222"},
+  {"nvinfin;", 8, "\342\247\236"},
+  {"nvlArr;", 7, "\342\244\202"},
+  {"nvle;", 5, "\342\211\244\342\203\222"},
+  {"nvlt;", 5, "<\342\203\222"},
+  {"nvltrie;", 8, "\342\212\264\342\203\222"},
+  {"nvrArr;", 7, "\342\244\203"},
+  {"nvrtrie;", 8, "\342\212\265\342\203\222"},
+  {"nvsim;", 6, "\342\210\274\342\203\222"},
+  {"nwArr;", 6, "\342\207\226"},
+  {"nwarhk;", 7, "\342\244\243"},
+  {"nwarr;", 6, "\342\206\226"},
+  {"nwarrow;", 8, "\342\206\226"},
+  {"nwnear;", 7, "\342\244\247"},
+  {"oS;", 3, "\342\223\210"},
+  {"oacute", 6, "\303\263"},
+  {"oacute;", 7, "\303\263"},
+  {"oast;", 5, "\342\212\233"},
+  {"ocir;", 5, "\342\212\232"},
+  {"ocirc", 5, "\303\264"},
+  {"ocirc;", 6, "\303\264"},
+  {"ocy;", 4, "\320\276"},
+  {"odash;", 6, "\342\212\235"},
+  {"odblac;", 7, "\305\221"},
+  {"odiv;", 5, "\342\250\270"},
+  {"odot;", 5, "\342\212\231"},
+  {"odsold;", 7, "\342\246\274"},
+  {"oelig;", 6, "\305\223"},
+  {"ofcir;", 6, "\342\246\277"},
+  {"ofr;", 4, "\360\235\224\254"},
+  {"ogon;", 5, "\313\233"},
+  {"ograve", 6, "\303\262"},
+  {"ograve;", 7, "\303\262"},
+  {"ogt;", 4, "\342\247\201"},
+  {"ohbar;", 6, "\342\246\265"},
+  {"ohm;", 4, "\316\251"},
+  {"oint;", 5, "\342\210\256"},
+  {"olarr;", 6, "\342\206\272"},
+  {"olcir;", 6, "\342\246\276"},
+  {"olcross;", 8, "\342\246\273"},
+  {"oline;", 6, "\342\200\276"},
+  {"olt;", 4, "\342\247\200"},
+  {"omacr;", 6, "\305\215"},
+  {"omega;", 6, "\317\211"},
+  {"omicron;", 8, "\316\277"},
+  {"omid;", 5, "\342\246\266"},
+  {"ominus;", 7, "\342\212\226"},
+  {"oopf;", 5, "\360\235\225\240"},
+  {"opar;", 5, "\342\246\267"},
+  {"operp;", 6, "\342\246\271"},
+  {"oplus;", 6, "\342\212\225"},
+  {"or;", 3, "\342\210\250"},
+  {"orarr;", 6, "\342\206\273"},
+  {"ord;", 4, "\342\251\235"},
+  {"order;", 6, "\342\204\264"},
+  {"orderof;", 8, "\342\204\264"},
+  {"ordf", 4, "\302\252"},
+  {"ordf;", 5, "\302\252"},
+  {"ordm", 4, "\302\272"},
+  {"ordm;", 5, "\302\272"},
+  {"origof;", 7, "\342\212\266"},
+  {"oror;", 5, "\342\251\226"},
+  {"orslope;", 8, "\342\251\227"},
+  {"orv;", 4, "\342\251\233"},
+  {"oscr;", 5, "\342\204\264"},
+  {"oslash", 6, "\303\270"},
+  {"oslash;", 7, "\303\270"},
+  {"osol;", 5, "\342\212\230"},
+  {"otilde", 6, "\303\265"},
+  {"otilde;", 7, "\303\265"},
+  {"otimes;", 7, "\342\212\227"},
+  {"otimesas;", 9, "\342\250\266"},
+  {"ouml", 4, "\303\266"},
+  {"ouml;", 5, "\303\266"},
+  {"ovbar;", 6, "\342\214\275"},
+  {"par;", 4, "\342\210\245"},
+  {"para", 4, "\302\266"},
+  {"para;", 5, "\302\266"},
+  {"parallel;", 9, "\342\210\245"},
+  {"parsim;", 7, "\342\253\263"},
+  {"parsl;", 6, "\342\253\275"},
+  {"part;", 5, "\342\210\202"},
+  {"pcy;", 4, "\320\277"},
+  {"percnt;", 7, "%"},
+  {"period;", 7, "."},
+  {"permil;", 7, "\342\200\260"},
+  {"perp;", 5, "\342\212\245"},
+  {"pertenk;", 8, "\342\200\261"},
+  {"pfr;", 4, "\360\235\224\255"},
+  {"phi;", 4, "\317\206"},
+  {"phiv;", 5, "\317\225"},
+  {"phmmat;", 7, "\342\204\263"},
+  {"phone;", 6, "\342\230\216"},
+  {"pi;", 3, "\317\200"},
+  {"pitchfork;", 10, "\342\213\224"},
+  {"piv;", 4, "\317\226"},
+  {"planck;", 7, "\342\204\217"},
+  {"planckh;", 8, "\342\204\216"},
+  {"plankv;", 7, "\342\204\217"},
+  {"plus;", 5, "+"},
+  {"plusacir;", 9, "\342\250\243"},
+  {"plusb;", 6, "\342\212\236"},
+  {"pluscir;", 8, "\342\250\242"},
+  {"plusdo;", 7, "\342\210\224"},
+  {"plusdu;", 7, "\342\250\245"},
+  {"pluse;", 6, "\342\251\262"},
+  {"plusmn", 6, "\302\261"},
+  {"plusmn;", 7, "\302\261"},
+  {"plussim;", 8, "\342\250\246"},
+  {"plustwo;", 8, "\342\250\247"},
+  {"pm;", 3, "\302\261"},
+  {"pointint;", 9, "\342\250\225"},
+  {"popf;", 5, "\360\235\225\241"},
+  {"pound", 5, "\302\243"},
+  {"pound;", 6, "\302\243"},
+  {"pr;", 3, "\342\211\272"},
+  {"prE;", 4, "\342\252\263"},
+  {"prap;", 5, "\342\252\267"},
+  {"prcue;", 6, "\342\211\274"},
+  {"pre;", 4, "\342\252\257"},
+  {"prec;", 5, "\342\211\272"},
+  {"precapprox;", 11, "\342\252\267"},
+  {"preccurlyeq;", 12, "\342\211\274"},
+  {"preceq;", 7, "\342\252\257"},
+  {"precnapprox;", 12, "\342\252\271"},
+  {"precneqq;", 9, "\342\252\265"},
+  {"precnsim;", 9, "\342\213\250"},
+  {"precsim;", 8, "\342\211\276"},
+  {"prime;", 6, "\342\200\262"},
+  {"primes;", 7, "\342\204\231"},
+  {"prnE;", 5, "\342\252\265"},
+  {"prnap;", 6, "\342\252\271"},
+  {"prnsim;", 7, "\342\213\250"},
+  {"prod;", 5, "\342\210\217"},
+  {"profalar;", 9, "\342\214\256"},
+  {"profline;", 9, "\342\214\222"},
+  {"profsurf;", 9, "\342\214\223"},
+  {"prop;", 5, "\342\210\235"},
+  {"propto;", 7, "\342\210\235"},
+  {"prsim;", 6, "\342\211\276"},
+  {"prurel;", 7, "\342\212\260"},
+  {"pscr;", 5, "\360\235\223\205"},
+  {"psi;", 4, "\317\210"},
+  {"puncsp;", 7, "\342\200\210"},
+  {"qfr;", 4, "\360\235\224\256"},
+  {"qint;", 5, "\342\250\214"},
+  {"qopf;", 5, "\360\235\225\242"},
+  {"qprime;", 7, "\342\201\227"},
+  {"qscr;", 5, "\360\235\223\206"},
+  {"quaternions;", 12, "\342\204\215"},
+  {"quatint;", 8, "\342\250\226"},
+  {"quest;", 6, "\077"},
+  {"questeq;", 8, "\342\211\237"},
+  {"quot", 4, "\042"},
+  {"quot;", 5, "\042"},
+  {"rAarr;", 6, "\342\207\233"},
+  {"rArr;", 5, "\342\207\222"},
+  {"rAtail;", 7, "\342\244\234"},
+  {"rBarr;", 6, "\342\244\217"},
+  {"rHar;", 5, "\342\245\244"},
+  {"race;", 5, "\342\210\275\314\261"},
+  {"racute;", 7, "\305\225"},
+  {"radic;", 6, "\342\210\232"},
+  {"raemptyv;", 9, "\342\246\263"},
+  {"rang;", 5, "\342\237\251"},
+  {"rangd;", 6, "\342\246\222"},
+  {"range;", 6, "\342\246\245"},
+  {"rangle;", 7, "\342\237\251"},
+  {"raquo", 5, "\302\273"},
+  {"raquo;", 6, "\302\273"},
+  {"rarr;", 5, "\342\206\222"},
+  {"rarrap;", 7, "\342\245\265"},
+  {"rarrb;", 6, "\342\207\245"},
+  {"rarrbfs;", 8, "\342\244\240"},
+  {"rarrc;", 6, "\342\244\263"},
+  {"rarrfs;", 7, "\342\244\236"},
+  {"rarrhk;", 7, "\342\206\252"},
+  {"rarrlp;", 7, "\342\206\254"},
+  {"rarrpl;", 7, "\342\245\205"},
+  {"rarrsim;", 8, "\342\245\264"},
+  {"rarrtl;", 7, "\342\206\243"},
+  {"rarrw;", 6, "\342\206\235"},
+  {"ratail;", 7, "\342\244\232"},
+  {"ratio;", 6, "\342\210\266"},
+  {"rationals;", 10, "\342\204\232"},
+  {"rbarr;", 6, "\342\244\215"},
+  {"rbbrk;", 6, "\342\235\263"},
+  {"rbrace;", 7, "}"},
+  {"rbrack;", 7, "]"},
+  {"rbrke;", 6, "\342\246\214"},
+  {"rbrksld;", 8, "\342\246\216"},
+  {"rbrkslu;", 8, "\342\246\220"},
+  {"rcaron;", 7, "\305\231"},
+  {"rcedil;", 7, "\305\227"},
+  {"rceil;", 6, "\342\214\211"},
+  {"rcub;", 5, "}"},
+  {"rcy;", 4, "\321\200"},
+  {"rdca;", 5, "\342\244\267"},
+  {"rdldhar;", 8, "\342\245\251"},
+  {"rdquo;", 6, "\342\200\235"},
+  {"rdquor;", 7, "\342\200\235"},
+  {"rdsh;", 5, "\342\206\263"},
+  {"real;", 5, "\342\204\234"},
+  {"realine;", 8, "\342\204\233"},
+  {"realpart;", 9, "\342\204\234"},
+  {"reals;", 6, "\342\204\235"},
+  {"rect;", 5, "\342\226\255"},
+  {"reg", 3, "\302\256"},
+  {"reg;", 4, "\302\256"},
+  {"rfisht;", 7, "\342\245\275"},
+  {"rfloor;", 7, "\342\214\213"},
+  {"rfr;", 4, "\360\235\224\257"},
+  {"rhard;", 6, "\342\207\201"},
+  {"rharu;", 6, "\342\207\200"},
+  {"rharul;", 7, "\342\245\254"},
+  {"rho;", 4, "\317\201"},
+  {"rhov;", 5, "\317\261"},
+  {"rightarrow;", 11, "\342\206\222"},
+  {"rightarrowtail;", 15, "\342\206\243"},
+  {"rightharpoondown;", 17, "\342\207\201"},
+  {"rightharpoonup;", 15, "\342\207\200"},
+  {"rightleftarrows;", 16, "\342\207\204"},
+  {"rightleftharpoons;", 18, "\342\207\214"},
+  {"rightrightarrows;", 17, "\342\207\211"},
+  {"rightsquigarrow;", 16, "\342\206\235"},
+  {"rightthreetimes;", 16, "\342\213\214"},
+  {"ring;", 5, "\313\232"},
+  {"risingdotseq;", 13, "\342\211\223"},
+  {"rlarr;", 6, "\342\207\204"},
+  {"rlhar;", 6, "\342\207\214"},
+  {"rlm;", 4, "\342\200\217"},
+  {"rmoust;", 7, "\342\216\261"},
+  {"rmoustache;", 11, "\342\216\261"},
+  {"rnmid;", 6, "\342\253\256"},
+  {"roang;", 6, "\342\237\255"},
+  {"roarr;", 6, "\342\207\276"},
+  {"robrk;", 6, "\342\237\247"},
+  {"ropar;", 6, "\342\246\206"},
+  {"ropf;", 5, "\360\235\225\243"},
+  {"roplus;", 7, "\342\250\256"},
+  {"rotimes;", 8, "\342\250\265"},
+  {"rpar;", 5, ")"},
+  {"rpargt;", 7, "\342\246\224"},
+  {"rppolint;", 9, "\342\250\222"},
+  {"rrarr;", 6, "\342\207\211"},
+  {"rsaquo;", 7, "\342\200\272"},
+  {"rscr;", 5, "\360\235\223\207"},
+  {"rsh;", 4, "\342\206\261"},
+  {"rsqb;", 5, "]"},
+  {"rsquo;", 6, "\342\200\231"},
+  {"rsquor;", 7, "\342\200\231"},
+  {"rthree;", 7, "\342\213\214"},
+  {"rtimes;", 7, "\342\213\212"},
+  {"rtri;", 5, "\342\226\271"},
+  {"rtrie;", 6, "\342\212\265"},
+  {"rtrif;", 6, "\342\226\270"},
+  {"rtriltri;", 9, "\342\247\216"},
+  {"ruluhar;", 8, "\342\245\250"},
+  {"rx;", 3, "\342\204\236"},
+  {"sacute;", 7, "\305\233"},
+  {"sbquo;", 6, "\342\200\232"},
+  {"sc;", 3, "\342\211\273"},
+  {"scE;", 4, "\342\252\264"},
+  {"scap;", 5, "\342\252\270"},
+  {"scaron;", 7, "\305\241"},
+  {"sccue;", 6, "\342\211\275"},
+  {"sce;", 4, "\342\252\260"},
+  {"scedil;", 7, "\305\237"},
+  {"scirc;", 6, "\305\235"},
+  {"scnE;", 5, "\342\252\266"},
+  {"scnap;", 6, "\342\252\272"},
+  {"scnsim;", 7, "\342\213\251"},
+  {"scpolint;", 9, "\342\250\223"},
+  {"scsim;", 6, "\342\211\277"},
+  {"scy;", 4, "\321\201"},
+  {"sdot;", 5, "\342\213\205"},
+  {"sdotb;", 6, "\342\212\241"},
+  {"sdote;", 6, "\342\251\246"},
+  {"seArr;", 6, "\342\207\230"},
+  {"searhk;", 7, "\342\244\245"},
+  {"searr;", 6, "\342\206\230"},
+  {"searrow;", 8, "\342\206\230"},
+  {"sect", 4, "\302\247"},
+  {"sect;", 5, "\302\247"},
+  {"semi;", 5, ";"},
+  {"seswar;", 7, "\342\244\251"},
+  {"setminus;", 9, "\342\210\226"},
+  {"setmn;", 6, "\342\210\226"},
+  {"sext;", 5, "\342\234\266"},
+  {"sfr;", 4, "\360\235\224\260"},
+  {"sfrown;", 7, "\342\214\242"},
+  {"sharp;", 6, "\342\231\257"},
+  {"shchcy;", 7, "\321\211"},
+  {"shcy;", 5, "\321\210"},
+  {"shortmid;", 9, "\342\210\243"},
+  {"shortparallel;", 14, "\342\210\245"},
+  {"shy", 3, "\302\255"},
+  {"shy;", 4, "\302\255"},
+  {"sigma;", 6, "\317\203"},
+  {"sigmaf;", 7, "\317\202"},
+  {"sigmav;", 7, "\317\202"},
+  {"sim;", 4, "\342\210\274"},
+  {"simdot;", 7, "\342\251\252"},
+  {"sime;", 5, "\342\211\203"},
+  {"simeq;", 6, "\342\211\203"},
+  {"simg;", 5, "\342\252\236"},
+  {"simgE;", 6, "\342\252\240"},
+  {"siml;", 5, "\342\252\235"},
+  {"simlE;", 6, "\342\252\237"},
+  {"simne;", 6, "\342\211\206"},
+  {"simplus;", 8, "\342\250\244"},
+  {"simrarr;", 8, "\342\245\262"},
+  {"slarr;", 6, "\342\206\220"},
+  {"smallsetminus;", 14, "\342\210\226"},
+  {"smashp;", 7, "\342\250\263"},
+  {"smeparsl;", 9, "\342\247\244"},
+  {"smid;", 5, "\342\210\243"},
+  {"smile;", 6, "\342\214\243"},
+  {"smt;", 4, "\342\252\252"},
+  {"smte;", 5, "\342\252\254"},
+  {"smtes;", 6, "\342\252\254\357\270\200"},
+  {"softcy;", 7, "\321\214"},
+  {"sol;", 4, "/"},
+  {"solb;", 5, "\342\247\204"},
+  {"solbar;", 7, "\342\214\277"},
+  {"sopf;", 5, "\360\235\225\244"},
+  {"spades;", 7, "\342\231\240"},
+  {"spadesuit;", 10, "\342\231\240"},
+  {"spar;", 5, "\342\210\245"},
+  {"sqcap;", 6, "\342\212\223"},
+  {"sqcaps;", 7, "\342\212\223\357\270\200"},
+  {"sqcup;", 6, "\342\212\224"},
+  {"sqcups;", 7, "\342\212\224\357\270\200"},
+  {"sqsub;", 6, "\342\212\217"},
+  {"sqsube;", 7, "\342\212\221"},
+  {"sqsubset;", 9, "\342\212\217"},
+  {"sqsubseteq;", 11, "\342\212\221"},
+  {"sqsup;", 6, "\342\212\220"},
+  {"sqsupe;", 7, "\342\212\222"},
+  {"sqsupset;", 9, "\342\212\220"},
+  {"sqsupseteq;", 11, "\342\212\222"},
+  {"squ;", 4, "\342\226\241"},
+  {"square;", 7, "\342\226\241"},
+  {"squarf;", 7, "\342\226\252"},
+  {"squf;", 5, "\342\226\252"},
+  {"srarr;", 6, "\342\206\222"},
+  {"sscr;", 5, "\360\235\223\210"},
+  {"ssetmn;", 7, "\342\210\226"},
+  {"ssmile;", 7, "\342\214\243"},
+  {"sstarf;", 7, "\342\213\206"},
+  {"star;", 5, "\342\230\206"},
+  {"starf;", 6, "\342\230\205"},
+  {"straightepsilon;", 16, "\317\265"},
+  {"straightphi;", 12, "\317\225"},
+  {"strns;", 6, "\302\257"},
+  {"sub;", 4, "\342\212\202"},
+  {"subE;", 5, "\342\253\205"},
+  {"subdot;", 7, "\342\252\275"},
+  {"sube;", 5, "\342\212\206"},
+  {"subedot;", 8, "\342\253\203"},
+  {"submult;", 8, "\342\253\201"},
+  {"subnE;", 6, "\342\253\213"},
+  {"subne;", 6, "\342\212\212"},
+  {"subplus;", 8, "\342\252\277"},
+  {"subrarr;", 8, "\342\245\271"},
+  {"subset;", 7, "\342\212\202"},
+  {"subseteq;", 9, "\342\212\206"},
+  {"subseteqq;", 10, "\342\253\205"},
+  {"subsetneq;", 10, "\342\212\212"},
+  {"subsetneqq;", 11, "\342\253\213"},
+  {"subsim;", 7, "\342\253\207"},
+  {"subsub;", 7, "\342\253\225"},
+  {"subsup;", 7, "\342\253\223"},
+  {"succ;", 5, "\342\211\273"},
+  {"succapprox;", 11, "\342\252\270"},
+  {"succcurlyeq;", 12, "\342\211\275"},
+  {"succeq;", 7, "\342\252\260"},
+  {"succnapprox;", 12, "\342\252\272"},
+  {"succneqq;", 9, "\342\252\266"},
+  {"succnsim;", 9, "\342\213\251"},
+  {"succsim;", 8, "\342\211\277"},
+  {"sum;", 4, "\342\210\221"},
+  {"sung;", 5, "\342\231\252"},
+  {"sup1", 4, "\302\271"},
+  {"sup1;", 5, "\302\271"},
+  {"sup2", 4, "\302\262"},
+  {"sup2;", 5, "\302\262"},
+  {"sup3", 4, "\302\263"},
+  {"sup3;", 5, "\302\263"},
+  {"sup;", 4, "\342\212\203"},
+  {"supE;", 5, "\342\253\206"},
+  {"supdot;", 7, "\342\252\276"},
+  {"supdsub;", 8, "\342\253\230"},
+  {"supe;", 5, "\342\212\207"},
+  {"supedot;", 8, "\342\253\204"},
+  {"suphsol;", 8, "\342\237\211"},
+  {"suphsub;", 8, "\342\253\227"},
+  {"suplarr;", 8, "\342\245\273"},
+  {"supmult;", 8, "\342\253\202"},
+  {"supnE;", 6, "\342\253\214"},
+  {"supne;", 6, "\342\212\213"},
+  {"supplus;", 8, "\342\253\200"},
+  {"supset;", 7, "\342\212\203"},
+  {"supseteq;", 9, "\342\212\207"},
+  {"supseteqq;", 10, "\342\253\206"},
+  {"supsetneq;", 10, "\342\212\213"},
+  {"supsetneqq;", 11, "\342\253\214"},
+  {"supsim;", 7, "\342\253\210"},
+  {"supsub;", 7, "\342\253\224"},
+  {"supsup;", 7, "\342\253\226"},
+  {"swArr;", 6, "\342\207\231"},
+  {"swarhk;", 7, "\342\244\246"},
+  {"swarr;", 6, "\342\206\231"},
+  {"swarrow;", 8, "\342\206\231"},
+  {"swnwar;", 7, "\342\244\252"},
+  {"szlig", 5, "\303\237"},
+  {"szlig;", 6, "\303\237"},
+  {"target;", 7, "\342\214\226"},
+  {"tau;", 4, "\317\204"},
+  {"tbrk;", 5, "\342\216\264"},
+  {"tcaron;", 7, "\305\245"},
+  {"tcedil;", 7, "\305\243"},
+  {"tcy;", 4, "\321\202"},
+  {"tdot;", 5, "\342\203\233"},
+  {"telrec;", 7, "\342\214\225"},
+  {"tfr;", 4, "\360\235\224\261"},
+  {"there4;", 7, "\342\210\264"},
+  {"therefore;", 10, "\342\210\264"},
+  {"theta;", 6, "\316\270"},
+  {"thetasym;", 9, "\317\221"},
+  {"thetav;", 7, "\317\221"},
+  {"thickapprox;", 12, "\342\211\210"},
+  {"thicksim;", 9, "\342\210\274"},
+  {"thinsp;", 7, "\342\200\211"},
+  {"thkap;", 6, "\342\211\210"},
+  {"thksim;", 7, "\342\210\274"},
+  {"thorn", 5, "\303\276"},
+  {"thorn;", 6, "\303\276"},
+  {"tilde;", 6, "\313\234"},
+  {"times", 5, "\303\227"},
+  {"times;", 6, "\303\227"},
+  {"timesb;", 7, "\342\212\240"},
+  {"timesbar;", 9, "\342\250\261"},
+  {"timesd;", 7, "\342\250\260"},
+  {"tint;", 5, "\342\210\255"},
+  {"toea;", 5, "\342\244\250"},
+  {"top;", 4, "\342\212\244"},
+  {"topbot;", 7, "\342\214\266"},
+  {"topcir;", 7, "\342\253\261"},
+  {"topf;", 5, "\360\235\225\245"},
+  {"topfork;", 8, "\342\253\232"},
+  {"tosa;", 5, "\342\244\251"},
+  {"tprime;", 7, "\342\200\264"},
+  {"trade;", 6, "\342\204\242"},
+  {"triangle;", 9, "\342\226\265"},
+  {"triangledown;", 13, "\342\226\277"},
+  {"triangleleft;", 13, "\342\227\203"},
+  {"trianglelefteq;", 15, "\342\212\264"},
+  {"triangleq;", 10, "\342\211\234"},
+  {"triangleright;", 14, "\342\226\271"},
+  {"trianglerighteq;", 16, "\342\212\265"},
+  {"tridot;", 7, "\342\227\254"},
+  {"trie;", 5, "\342\211\234"},
+  {"triminus;", 9, "\342\250\272"},
+  {"triplus;", 8, "\342\250\271"},
+  {"trisb;", 6, "\342\247\215"},
+  {"tritime;", 8, "\342\250\273"},
+  {"trpezium;", 9, "\342\217\242"},
+  {"tscr;", 5, "\360\235\223\211"},
+  {"tscy;", 5, "\321\206"},
+  {"tshcy;", 6, "\321\233"},
+  {"tstrok;", 7, "\305\247"},
+  {"twixt;", 6, "\342\211\254"},
+  {"twoheadleftarrow;", 17, "\342\206\236"},
+  {"twoheadrightarrow;", 18, "\342\206\240"},
+  {"uArr;", 5, "\342\207\221"},
+  {"uHar;", 5, "\342\245\243"},
+  {"uacute", 6, "\303\272"},
+  {"uacute;", 7, "\303\272"},
+  {"uarr;", 5, "\342\206\221"},
+  {"ubrcy;", 6, "\321\236"},
+  {"ubreve;", 7, "\305\255"},
+  {"ucirc", 5, "\303\273"},
+  {"ucirc;", 6, "\303\273"},
+  {"ucy;", 4, "\321\203"},
+  {"udarr;", 6, "\342\207\205"},
+  {"udblac;", 7, "\305\261"},
+  {"udhar;", 6, "\342\245\256"},
+  {"ufisht;", 7, "\342\245\276"},
+  {"ufr;", 4, "\360\235\224\262"},
+  {"ugrave", 6, "\303\271"},
+  {"ugrave;", 7, "\303\271"},
+  {"uharl;", 6, "\342\206\277"},
+  {"uharr;", 6, "\342\206\276"},
+  {"uhblk;", 6, "\342\226\200"},
+  {"ulcorn;", 7, "\342\214\234"},
+  {"ulcorner;", 9, "\342\214\234"},
+  {"ulcrop;", 7, "\342\214\217"},
+  {"ultri;", 6, "\342\227\270"},
+  {"umacr;", 6, "\305\253"},
+  {"uml", 3, "\302\250"},
+  {"uml;", 4, "\302\250"},
+  {"uogon;", 6, "\305\263"},
+  {"uopf;", 5, "\360\235\225\246"},
+  {"uparrow;", 8, "\342\206\221"},
+  {"updownarrow;", 12, "\342\206\225"},
+  {"upharpoonleft;", 14, "\342\206\277"},
+  {"upharpoonright;", 15, "\342\206\276"},
+  {"uplus;", 6, "\342\212\216"},
+  {"upsi;", 5, "\317\205"},
+  {"upsih;", 6, "\317\222"},
+  {"upsilon;", 8, "\317\205"},
+  {"upuparrows;", 11, "\342\207\210"},
+  {"urcorn;", 7, "\342\214\235"},
+  {"urcorner;", 9, "\342\214\235"},
+  {"urcrop;", 7, "\342\214\216"},
+  {"uring;", 6, "\305\257"},
+  {"urtri;", 6, "\342\227\271"},
+  {"uscr;", 5, "\360\235\223\212"},
+  {"utdot;", 6, "\342\213\260"},
+  {"utilde;", 7, "\305\251"},
+  {"utri;", 5, "\342\226\265"},
+  {"utrif;", 6, "\342\226\264"},
+  {"uuarr;", 6, "\342\207\210"},
+  {"uuml", 4, "\303\274"},
+  {"uuml;", 5, "\303\274"},
+  {"uwangle;", 8, "\342\246\247"},
+  {"vArr;", 5, "\342\207\225"},
+  {"vBar;", 5, "\342\253\250"},
+  {"vBarv;", 6, "\342\253\251"},
+  {"vDash;", 6, "\342\212\250"},
+  {"vangrt;", 7, "\342\246\234"},
+  {"varepsilon;", 11, "\317\265"},
+  {"varkappa;", 9, "\317\260"},
+  {"varnothing;", 11, "\342\210\205"},
+  {"varphi;", 7, "\317\225"},
+  {"varpi;", 6, "\317\226"},
+  {"varpropto;", 10, "\342\210\235"},
+  {"varr;", 5, "\342\206\225"},
+  {"varrho;", 7, "\317\261"},
+  {"varsigma;", 9, "\317\202"},
+  {"varsubsetneq;", 13, "\342\212\212\357\270\200"},
+  {"varsubsetneqq;", 14, "\342\253\213\357\270\200"},
+  {"varsupsetneq;", 13, "\342\212\213\357\270\200"},
+  {"varsupsetneqq;", 14, "\342\253\214\357\270\200"},
+  {"vartheta;", 9, "\317\221"},
+  {"vartriangleleft;", 16, "\342\212\262"},
+  {"vartriangleright;", 17, "\342\212\263"},
+  {"vcy;", 4, "\320\262"},
+  {"vdash;", 6, "\342\212\242"},
+  {"vee;", 4, "\342\210\250"},
+  {"veebar;", 7, "\342\212\273"},
+  {"veeeq;", 6, "\342\211\232"},
+  {"vellip;", 7, "\342\213\256"},
+  {"verbar;", 7, "|"},
+  {"vert;", 5, "|"},
+  {"vfr;", 4, "\360\235\224\263"},
+  {"vltri;", 6, "\342\212\262"},
+  {"vnsub;", 6, "\342\212\202\342\203\222"},
+  {"vnsup;", 6, "\342\212\203\342\203\222"},
+  {"vopf;", 5, "\360\235\225\247"},
+  {"vprop;", 6, "\342\210\235"},
+  {"vrtri;", 6, "\342\212\263"},
+  {"vscr;", 5, "\360\235\223\213"},
+  {"vsubnE;", 7, "\342\253\213\357\270\200"},
+  {"vsubne;", 7, "\342\212\212\357\270\200"},
+  {"vsupnE;", 7, "\342\253\214\357\270\200"},
+  {"vsupne;", 7, "\342\212\213\357\270\200"},
+  {"vzigzag;", 8, "\342\246\232"},
+  {"wcirc;", 6, "\305\265"},
+  {"wedbar;", 7, "\342\251\237"},
+  {"wedge;", 6, "\342\210\247"},
+  {"wedgeq;", 7, "\342\211\231"},
+  {"weierp;", 7, "\342\204\230"},
+  {"wfr;", 4, "\360\235\224\264"},
+  {"wopf;", 5, "\360\235\225\250"},
+  {"wp;", 3, "\342\204\230"},
+  {"wr;", 3, "\342\211\200"},
+  {"wreath;", 7, "\342\211\200"},
+  {"wscr;", 5, "\360\235\223\214"},
+  {"xcap;", 5, "\342\213\202"},
+  {"xcirc;", 6, "\342\227\257"},
+  {"xcup;", 5, "\342\213\203"},
+  {"xdtri;", 6, "\342\226\275"},
+  {"xfr;", 4, "\360\235\224\265"},
+  {"xhArr;", 6, "\342\237\272"},
+  {"xharr;", 6, "\342\237\267"},
+  {"xi;", 3, "\316\276"},
+  {"xlArr;", 6, "\342\237\270"},
+  {"xlarr;", 6, "\342\237\265"},
+  {"xmap;", 5, "\342\237\274"},
+  {"xnis;", 5, "\342\213\273"},
+  {"xodot;", 6, "\342\250\200"},
+  {"xopf;", 5, "\360\235\225\251"},
+  {"xoplus;", 7, "\342\250\201"},
+  {"xotime;", 7, "\342\250\202"},
+  {"xrArr;", 6, "\342\237\271"},
+  {"xrarr;", 6, "\342\237\266"},
+  {"xscr;", 5, "\360\235\223\215"},
+  {"xsqcup;", 7, "\342\250\206"},
+  {"xuplus;", 7, "\342\250\204"},
+  {"xutri;", 6, "\342\226\263"},
+  {"xvee;", 5, "\342\213\201"},
+  {"xwedge;", 7, "\342\213\200"},
+  {"yacute", 6, "\303\275"},
+  {"yacute;", 7, "\303\275"},
+  {"yacy;", 5, "\321\217"},
+  {"ycirc;", 6, "\305\267"},
+  {"ycy;", 4, "\321\213"},
+  {"yen", 3, "\302\245"},
+  {"yen;", 4, "\302\245"},
+  {"yfr;", 4, "\360\235\224\266"},
+  {"yicy;", 5, "\321\227"},
+  {"yopf;", 5, "\360\235\225\252"},
+  {"yscr;", 5, "\360\235\223\216"},
+  {"yucy;", 5, "\321\216"},
+  {"yuml", 4, "\303\277"},
+  {"yuml;", 5, "\303\277"},
+  {"zacute;", 7, "\305\272"},
+  {"zcaron;", 7, "\305\276"},
+  {"zcy;", 4, "\320\267"},
+  {"zdot;", 5, "\305\274"},
+  {"zeetrf;", 7, "\342\204\250"},
+  {"zeta;", 5, "\316\266"},
+  {"zfr;", 4, "\360\235\224\267"},
+  {"zhcy;", 5, "\320\266"},
+  {"zigrarr;", 8, "\342\207\235"},
+  {"zopf;", 5, "\360\235\225\253"},
+  {"zscr;", 5, "\360\235\223\217"},
+  {"zwj;", 4, "\342\200\215"},
+  {"zwnj;", 5, "\342\200\214"},
+};
+
+const std::size_t kHTMLEntitiesSize = sizeof(kHTMLEntities) / sizeof(HTMLEntity);
+
+const std::size_t kLongestLegacyEntity = 6;
+
+} // namespace detail
+} // namespace preprocess
@@ -0,0 +1,33 @@
+#!/usr/bin/env python3
+# Generates html_entity_table.cc from the HTML5 named character references
+# bundled with Python (the same list as https://html.spec.whatwg.org/entities.json).
+#   ./html_entity_table.py > html_entity_table.cc
+from html.entities import html5
+
+def quote(data):
+    out = '"'
+    for b in data:
+        if 0x20 <= b < 0x7f and chr(b) not in '"\\?':
+            out += chr(b)
+        else:
+            out += '\\%03o' % b
+    return out + '"'
+
+names = sorted(html5, key=lambda n: n.encode('ascii'))
+print('// Generated by html_entity_table.py.  Do not edit.')
+print('#include "preprocess/html_entities.hh"')
+print('')
+print('namespace preprocess {')
+print('namespace detail {')
+print('')
+print('const HTMLEntity kHTMLEntities[] = {')
+for name in names:
+    print('  {%s, %d, %s},' % (quote(name.encode('ascii')), len(name), quote(html5[name].encode('utf-8'))))
+print('};')
+print('')
+print('const std::size_t kHTMLEntitiesSize = sizeof(kHTMLEntities) / sizeof(HTMLEntity);')
+print('')
+print('const std::size_t kLongestLegacyEntity = %d;' % max(len(n) for n in names if not n.endswith(';')))
+print('')
+print('} // namespace detail')
+print('} // namespace preprocess')
@@ -0,0 +1,262 @@
+#pragma once
+// Apply a line-by-line function on worker threads while keeping output in input order.
+
+#include "preprocess/parallel_corpus.hh"
+
+#include "util/file_piece.hh"
+#include "util/file_stream.hh"
+#include "util/fixed_array.hh"
+#include "util/pcqueue.hh"
+#include "util/string_stream.hh"
+#include "util/trace.hh"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace preprocess {
+
+// Roughly how much of a memory mapped file goes to a worker at a time.
+const std::size_t kRangeBatchBytes = 1 << 20;
+
+struct OrderedOutput {
+  OrderedOutput() : done(0) {}
+  util::StringStream output;
+  // Posted by the worker once output is complete.
+  util::Semaphore done;
+};
+
+struct LineBatch : public OrderedOutput {
+  CorpusBatch input;
+};
+
+struct RangeBatch : public OrderedOutput {
+  // Whole lines from a memory mapped file.
+  StringPiece range;
+};
+
+// Call function(line) for each line of text, stripping newlines like FilePiece::ReadLine.
+template <class Function> void ForEachLine(StringPiece text, Function &function) {
+  const char *i = text.data();
+  const char *const end = text.data() + text.size();
+  while (i != end) {
+    const char *newline = static_cast<const char*>(memchr(i, '\n', end - i));
+    const char *line_end = newline ? newline : end;
+    StringPiece line(i, line_end - i);
+    if (!line.empty() && line.data()[line.size() - 1] == '\r') {
+      line = StringPiece(line.data(), line.size() - 1);
+    }
+    function(line);
+    i = newline ? newline + 1 : end;
+  }
+}
+
+namespace detail {
+
+template <class Worker, class Stream> void ProcessBatch(Worker &worker, const CorpusBatch &batch, std::vector<StringPiece> &lines, Stream &out) {
+  lines.resize(batch.text.size());
+  CorpusBatchLines cursor(batch);
+  for (std::size_t record = 0; record < batch.records; ++record) {
+    for (std::size_t i = 0; i < lines.size(); ++i) {
+      lines[i] = cursor.Next(i);
+    }
+    worker(batch.first_record + record, &lines[0], out);
+  }
+}
+
+template <class Worker> void LineWorkerThread(Worker worker, util::PCQueue<LineBatch*> *work) {
+  UTIL_TRACE_THREAD("line worker");
+  try {
+    std::vector<StringPiece> lines;
+    LineBatch *batch;
+    while (true) {
+      work->Consume(batch);
+      if (!batch) return;
+      UTIL_TRACE_SPAN("process batch");
+      ProcessBatch(worker, batch->input, lines, batch->output);
+      batch->done.post();
+    }
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    abort();
+  }
+}
+
+template <class Worker, class Stream> class BindStream {
+  public:
+    BindStream(Worker &worker, Stream &out) : worker_(worker), out_(out) {}
+
+    void operator()(StringPiece line) { worker_(line, out_); }
+
+  private:
+    Worker &worker_;
+    Stream &out_;
+};
+
+template <class Worker> void RangeWorkerThread(Worker worker, util::PCQueue<RangeBatch*> *work) {
+  UTIL_TRACE_THREAD("line worker");
+  try {
+    RangeBatch *batch;
+    while (true) {
+      work->Consume(batch);
+      if (!batch) return;
+      UTIL_TRACE_SPAN("process batch");
+      BindStream<Worker, util::StringStream> bound(worker, batch->output);
+      ForEachLine(batch->range, bound);
+      batch->done.post();
+    }
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    abort();
+  }
+}
+
+template <class Batch> void LineWriterThread(util::PCQueue<Batch*> *ordered, util::FileStream *out) {
+  UTIL_TRACE_THREAD("line writer");
+  Batch *batch;
+  while (true) {
+    ordered->Consume(batch);
+    if (!batch) return;
+    std::unique_ptr<Batch> owned(batch);
+    {
+      UTIL_TRACE_SPAN("wait for batch");
+      util::WaitSemaphore(batch->done);
+    }
+    *out << batch->output.str();
+  }
+}
+
+template <class Worker> class FirstLine {
+  public:
+    explicit FirstLine(const Worker &worker) : worker_(worker) {}
+
+    template <class Stream> void operator()(std::size_t /*line_number*/, const StringPiece *lines, Stream &out) {
+      worker_(lines[0], out);
+    }
+
+  private:
+    Worker worker_;
+};
+
+} // namespace detail
+
+/* Like ParallelLines, but reads the files in lockstep with a
+ * ParallelCorpusReader and calls
+ * worker(std::size_t line_number, const StringPiece *lines, Stream &out)
+ * where lines has one entry per input file.  Throws MisalignedException if the
+ * files have different numbers of lines.
+ */
+template <class Worker> void ParallelAlignedLines(const std::vector<util::FilePiece*> &in, util::FileStream &out, const Worker &worker, std::size_t threads, bool strip_cr = true) {
+  ParallelCorpusReader reader(in, std::vector<unsigned int>(), ParallelCorpusReader::kDefaultBatchRecords, strip_cr);
+  if (threads <= 1) {
+    Worker local(worker);
+    std::vector<StringPiece> lines;
+    CorpusBatch batch;
+    while (reader.Next(batch)) {
+      detail::ProcessBatch(local, batch, lines, out);
+    }
+    return;
+  }
+  util::PCQueue<LineBatch*> work(threads * 2);
+  // Bounds the number of batches in flight.
+  util::PCQueue<LineBatch*> ordered(threads * 4);
+  util::FixedArray<std::thread> workers(threads);
+  for (std::size_t i = 0; i < threads; ++i) {
+    workers.push_back(detail::LineWorkerThread<Worker>, worker, &work);
+  }
+  std::thread writer(detail::LineWriterThread<LineBatch>, &ordered, &out);
+
+  std::exception_ptr error;
+  try {
+    while (true) {
+      std::unique_ptr<LineBatch> batch(new LineBatch());
+      if (!reader.Next(batch->input)) break;
+      // Writer takes ownership.
+      ordered.Produce(batch.get());
+      work.Produce(batch.release());
+    }
+  } catch (...) {
+    // Finish what was already read, then report.
+    error = std::current_exception();
+  }
+  for (std::size_t i = 0; i < threads; ++i) {
+    work.Produce(NULL);
+  }
+  ordered.Produce(NULL);
+  for (std::thread &w : workers) {
+    w.join();
+  }
+  writer.join();
+  if (error) std::rethrow_exception(error);
+}
+
+/* Calls worker(StringPiece line, Stream &out) for every line of in, writing
+ * the results to out in the same order as the input.  Each thread gets its own
+ * copy of worker, so it can keep scratch buffers as members.  operator() should
+ * be a template over Stream: with threads <= 1 it is called directly on out
+ * without any copying.  Set strip_cr to false to keep carriage returns, as
+ * Perl's chomp does.
+ */
+template <class Worker> void ParallelLines(util::FilePiece &in, util::FileStream &out, const Worker &worker, std::size_t threads, bool strip_cr = true) {
+  if (threads <= 1) {
+    Worker local(worker);
+    StringPiece line;
+    while (in.ReadLineOrEOF(line, '\n', strip_cr)) {
+      local(line, out);
+    }
+    return;
+  }
+  ParallelAlignedLines(std::vector<util::FilePiece*>(1, &in), out, detail::FirstLine<Worker>(worker), threads, strip_cr);
+}
+
+/* Like ParallelLines, but for text that is already in memory, typically a
+ * memory mapped file.  Workers are handed ranges of text instead of copies.
+ */
+template <class Worker> void ParallelMappedLines(StringPiece text, util::FileStream &out, const Worker &worker, std::size_t threads) {
+  if (threads <= 1) {
+    Worker local(worker);
+    detail::BindStream<Worker, util::FileStream> bound(local, out);
+    ForEachLine(text, bound);
+    return;
+  }
+  util::PCQueue<RangeBatch*> work(threads * 2);
+  // Bounds the number of batches in flight.
+  util::PCQueue<RangeBatch*> ordered(threads * 4);
+  util::FixedArray<std::thread> workers(threads);
+  for (std::size_t i = 0; i < threads; ++i) {
+    workers.push_back(detail::RangeWorkerThread<Worker>, worker, &work);
+  }
+  std::thread writer(detail::LineWriterThread<RangeBatch>, &ordered, &out);
+
+  const char *const end = text.data() + text.size();
+  for (const char *i = text.data(); i != end;) {
+    const char *stop = i + std::min<std::size_t>(kRangeBatchBytes, end - i);
+    if (stop != end) {
+      // Extend to the end of the line.
+      const char *newline = static_cast<const char*>(memchr(stop, '\n', end - stop));
+      stop = newline ? newline + 1 : end;
+    }
+    RangeBatch *batch = new RangeBatch();
+    batch->range = StringPiece(i, stop - i);
+    // Writer takes ownership.
+    ordered.Produce(batch);
+    work.Produce(batch);
+    i = stop;
+  }
+  for (std::size_t i = 0; i < threads; ++i) {
+    work.Produce(NULL);
+  }
+  ordered.Produce(NULL);
+  for (std::thread &w : workers) {
+    w.join();
+  }
+  writer.join();
+}
+
+} // namespace preprocess
@@ -0,0 +1,98 @@
+#include "preprocess/nonbreaking_prefix.hh"
+
+#include "util/file.hh"
+#include "util/file_piece.hh"
+#include "util/spaces.hh"
+#include "util/string_stream.hh"
+
+#include <string.h>
+#include <unistd.h>
+
+namespace preprocess {
+
+const char kNonbreakingPrefixMagic[8] = {'\0', 'n', 'b', 'p', 'r', 'e', 'f', '1'};
+
+namespace {
+
+const StringPiece kNumericOnlyMarker("#NUMERIC_ONLY#");
+
+// Mirrors /(.*)[\s]+(\#NUMERIC_ONLY\#)/: the greedy (.*) stops just before the
+// whitespace preceding the last marker.  Returns false if there is no marker.
+bool StripNumericOnly(StringPiece line, StringPiece &prefix) {
+  for (const char *i = line.data() + line.size() - kNumericOnlyMarker.size(); i > line.data(); --i) {
+    if (util::kSpaces[static_cast<unsigned char>(i[-1])] && !memcmp(i, kNumericOnlyMarker.data(), kNumericOnlyMarker.size())) {
+      prefix = StringPiece(line.data(), i - 1 - line.data());
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Exists(const std::string &file) {
+  return !access(file.c_str(), F_OK);
+}
+
+} // namespace
+
+void NonbreakingPrefixBuilder::Add(StringPiece prefix, PrefixType type) {
+  NonbreakingPrefixEntry entry;
+  entry.key = NonbreakingPrefixKey(prefix);
+  entry.type = type;
+  Table::MutableIterator found;
+  if (table_.FindOrInsert(entry, found)) found->type = type;
+}
+
+void NonbreakingPrefixBuilder::AddText(util::FilePiece &in) {
+  StringPiece line;
+  // Like chomp, keep any carriage return.
+  while (in.ReadLineOrEOF(line, '\n', false)) {
+    // Perl's truth test also skips a line that is just 0.
+    if (line.empty() || line == "0" || line.data()[0] == '#') continue;
+    StringPiece prefix;
+    if (line.size() > kNumericOnlyMarker.size() && StripNumericOnly(line, prefix)) {
+      Add(prefix, kNumericOnly);
+    } else {
+      Add(line, kNonbreaking);
+    }
+  }
+}
+
+NonbreakingPrefixes::NonbreakingPrefixes(const char *file) {
+  util::scoped_fd fd(util::OpenReadOrThrow(file));
+  uint64_t size = util::SizeFile(fd.get());
+  NonbreakingPrefixHeader header;
+  if (size != util::kBadSize && size >= sizeof(NonbreakingPrefixHeader)) {
+    util::ReadOrThrow(fd.get(), &header, sizeof(NonbreakingPrefixHeader));
+    if (!memcmp(header.magic, kNonbreakingPrefixMagic, sizeof(kNonbreakingPrefixMagic))) {
+      util::MapRead(util::POPULATE_OR_LAZY, fd.get(), 0, size, mapped_);
+      View(mapped_.begin(), size);
+      return;
+    }
+  }
+  util::FilePiece text(file);
+  NonbreakingPrefixBuilder builder;
+  builder.AddText(text);
+  util::StringStream image;
+  builder.Write(image);
+  image.swap(built_);
+  View(built_.data(), built_.size());
+}
+
+std::string NonbreakingPrefixes::LanguageFile(const std::string &directory, const std::string &language) {
+  std::string base(directory + "/nonbreaking_prefix.");
+  const std::string candidates[] = {base + language + ".bin", base + language, base + "en.bin", base + "en"};
+  for (const std::string &candidate : candidates) {
+    if (Exists(candidate)) return candidate;
+  }
+  UTIL_THROW(util::Exception, "No nonbreaking prefixes for " << language << " or en in " << directory);
+}
+
+void NonbreakingPrefixes::View(const char *image, uint64_t size) {
+  NonbreakingPrefixHeader header;
+  memcpy(&header, image, sizeof(NonbreakingPrefixHeader));
+  UTIL_THROW_IF2(header.entry_size != sizeof(NonbreakingPrefixEntry), "Compiled nonbreaking prefixes were built on an incompatible platform.");
+  UTIL_THROW_IF2(sizeof(NonbreakingPrefixHeader) + header.table_bytes != size, "Compiled nonbreaking prefixes have size " << size << " but the header implies " << (sizeof(NonbreakingPrefixHeader) + header.table_bytes) << "; is it truncated?");
+  table_ = Table(const_cast<char*>(image) + sizeof(NonbreakingPrefixHeader), header.table_bytes);
+}
+
+} // namespace preprocess
@@ -0,0 +1,129 @@
+#pragma once
+// Nonbreaking prefix lists (moses/share/nonbreaking_prefixes) compiled for
+// constant-time lookup by tokenizers and sentence splitters.
+
+#include "util/file_stream.hh"
+#include "util/mmap.hh"
+#include "util/murmur_hash.hh"
+#include "util/probing_hash_table.hh"
+#include "util/string_piece.hh"
+
+#include <string>
+
+#include <string.h>
+
+#include <stdint.h>
+
+namespace util { class FilePiece; }
+
+namespace preprocess {
+
+// Values match the hash the Moses Perl scripts build.
+enum PrefixType {
+  // Not in the list: a following period may end a sentence.
+  kBreaking = 0,
+  // A following period does not end a sentence.
+  kNonbreaking = 1,
+  // Only nonbreaking when the next word starts with a digit (#NUMERIC_ONLY#).
+  kNumericOnly = 2
+};
+
+inline uint64_t NonbreakingPrefixKey(StringPiece prefix) {
+  uint64_t key = util::MurmurHash64A(prefix.data(), prefix.size());
+  // 0, which is the hash of the empty string, marks empty buckets.
+  return key ? key : 1;
+}
+
+#pragma pack(push)
+#pragma pack(4)
+struct NonbreakingPrefixEntry {
+  typedef uint64_t Key;
+  uint64_t GetKey() const { return key; }
+  void SetKey(uint64_t to) { key = to; }
+
+  uint64_t key;
+  uint32_t type;
+};
+#pragma pack(pop)
+
+/* Binary layout: this header then the hash table buckets, in the layout of
+ * util::AutoProbing so the file can be mapped and searched in place.  Like the
+ * case model, it is platform-specific.
+ */
+struct NonbreakingPrefixHeader {
+  char magic[8];
+  // Guards against loading a file compiled on a different platform.
+  uint64_t entry_size;
+  uint64_t table_bytes;
+};
+
+extern const char kNonbreakingPrefixMagic[8];
+
+class NonbreakingPrefixBuilder {
+  public:
+    NonbreakingPrefixBuilder() {}
+
+    // Later additions of the same prefix replace earlier ones.
+    void Add(StringPiece prefix, PrefixType type);
+
+    /* Add the prefixes in a text list, parsed like the Perl scripts do: lines
+     * that are empty or start with # are skipped, and "prefix #NUMERIC_ONLY#"
+     * marks a numeric-only prefix.  Other text is taken verbatim, including
+     * trailing whitespace.
+     */
+    void AddText(util::FilePiece &in);
+
+    template <class Stream> void Write(Stream &out) const {
+      NonbreakingPrefixHeader header;
+      memcpy(header.magic, kNonbreakingPrefixMagic, sizeof(kNonbreakingPrefixMagic));
+      header.entry_size = sizeof(NonbreakingPrefixEntry);
+      header.table_bytes = (table_.RawEnd() - table_.RawBegin()) * sizeof(NonbreakingPrefixEntry);
+      out.write(&header, sizeof(NonbreakingPrefixHeader));
+      out.write(table_.RawBegin(), header.table_bytes);
+    }
+
+    void Write(int fd) const {
+      util::FileStream out(fd);
+      Write(out);
+    }
+
+  private:
+    typedef util::AutoProbing<NonbreakingPrefixEntry, util::IdentityHash> Table;
+    Table table_;
+};
+
+// Read-only prefix set.  Loads a text list or the output of compile_prefixes.
+class NonbreakingPrefixes {
+  public:
+    explicit NonbreakingPrefixes(const char *file);
+
+    PrefixType Find(StringPiece prefix) const {
+      const NonbreakingPrefixEntry *entry;
+      if (!table_.Find(NonbreakingPrefixKey(prefix), entry)) return kBreaking;
+      return static_cast<PrefixType>(entry->type);
+    }
+
+    bool IsNonbreaking(StringPiece prefix) const { return Find(prefix) == kNonbreaking; }
+
+    bool IsNumericOnly(StringPiece prefix) const { return Find(prefix) == kNumericOnly; }
+
+    /* The list for language in directory, preferring a compiled
+     * nonbreaking_prefix.<language>.bin over the text file and falling back to
+     * English like the Perl scripts.  Throws if neither exists.
+     */
+    static std::string LanguageFile(const std::string &directory, const std::string &language);
+
+  private:
+    // Point table_ into a complete binary image.
+    void View(const char *image, uint64_t size);
+
+    // Backing for text lists: the binary image built in memory.
+    std::string built_;
+    // Backing for compiled lists.
+    util::scoped_memory mapped_;
+
+    typedef util::ProbingHashTable<NonbreakingPrefixEntry, util::IdentityHash, std::equal_to<uint64_t>, util::Power2Mod> Table;
+    Table table_;
+};
+
+} // namespace preprocess
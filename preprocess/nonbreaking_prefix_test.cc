@@ -0,0 +1,136 @@
+#define BOOST_TEST_MODULE NonbreakingPrefixTest
+#include "preprocess/nonbreaking_prefix.hh"
+
+#include "util/file.hh"
+#include "util/file_piece.hh"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace preprocess { namespace {
+
+// A scratch directory that is removed with its files.
+class TempDirectory {
+  public:
+    TempDirectory() {
+      std::string pattern(util::DefaultTempDirectory() + "nonbreaking_prefix_test_XXXXXX");
+      BOOST_REQUIRE(mkdtemp(&pattern[0]));
+      path_ = pattern;
+    }
+
+    ~TempDirectory() {
+      for (const std::string &file : files_) unlink(file.c_str());
+      rmdir(path_.c_str());
+    }
+
+    std::string Write(const std::string &name, const std::string &contents) {
+      std::string file(path_ + "/" + name);
+      util::scoped_fd fd(util::CreateOrThrow(file.c_str()));
+      util::WriteOrThrow(fd.get(), contents.data(), contents.size());
+      files_.push_back(file);
+      return file;
+    }
+
+    std::string Compile(const std::string &name, const std::string &text) {
+      std::string source(Write(name + ".txt", text));
+      util::FilePiece in(source.c_str());
+      NonbreakingPrefixBuilder builder;
+      builder.AddText(in);
+      std::string file(path_ + "/" + name);
+      util::scoped_fd fd(util::CreateOrThrow(file.c_str()));
+      builder.Write(fd.get());
+      files_.push_back(file);
+      return file;
+    }
+
+    const std::string &Path() const { return path_; }
+
+  private:
+    std::string path_;
+    std::vector<std::string> files_;
+};
+
+const char kList[] =
+  "# Comment\n"
+  "\n"
+  "Mr\n"
+  "Dr\n"
+  "0\n"
+  "No #NUMERIC_ONLY# \n"
+  "Art #NUMERIC_ONLY#\n"
+  "trailing \n"
+  "crlf\r\n";
+
+void CheckList(const NonbreakingPrefixes &prefixes) {
+  BOOST_CHECK_EQUAL(kNonbreaking, prefixes.Find("Mr"));
+  BOOST_CHECK(prefixes.IsNonbreaking("Dr"));
+  BOOST_CHECK_EQUAL(kBreaking, prefixes.Find("mr"));
+  BOOST_CHECK_EQUAL(kBreaking, prefixes.Find("# Comment"));
+  BOOST_CHECK_EQUAL(kBreaking, prefixes.Find("0"));
+  // The greedy match stops before the marker, whatever follows it.
+  BOOST_CHECK(prefixes.IsNumericOnly("No"));
+  BOOST_CHECK(prefixes.IsNumericOnly("Art"));
+  BOOST_CHECK_EQUAL(kBreaking, prefixes.Find("Art #NUMERIC_ONLY#"));
+  // Text is taken verbatim, like chomp.
+  BOOST_CHECK(prefixes.IsNonbreaking("trailing "));
+  BOOST_CHECK_EQUAL(kBreaking, prefixes.Find("trailing"));
+  BOOST_CHECK(prefixes.IsNonbreaking("crlf\r"));
+  BOOST_CHECK_EQUAL(kBreaking, prefixes.Find(""));
+}
+
+BOOST_AUTO_TEST_CASE(Text) {
+  TempDirectory dir;
+  NonbreakingPrefixes prefixes(dir.Write("list", kList).c_str());
+  CheckList(prefixes);
+}
+
+BOOST_AUTO_TEST_CASE(Compiled) {
+  TempDirectory dir;
+  NonbreakingPrefixes prefixes(dir.Compile("list.bin", kList).c_str());
+  CheckList(prefixes);
+}
+
+BOOST_AUTO_TEST_CASE(Replace) {
+  TempDirectory dir;
+  NonbreakingPrefixes prefixes(dir.Write("list", "No\nNo #NUMERIC_ONLY#\nSt #NUMERIC_ONLY#\nSt\n").c_str());
+  BOOST_CHECK(prefixes.IsNumericOnly("No"));
+  BOOST_CHECK(prefixes.IsNonbreaking("St"));
+}
+
+// The empty string hashes to the empty bucket marker.
+BOOST_AUTO_TEST_CASE(EmptyPrefix) {
+  TempDirectory dir;
+  const char kEmpty[] = "Mr\n #NUMERIC_ONLY#\n";
+  NonbreakingPrefixes text(dir.Write("list", kEmpty).c_str());
+  BOOST_CHECK(text.IsNumericOnly(""));
+  BOOST_CHECK(text.IsNonbreaking("Mr"));
+  BOOST_CHECK_EQUAL(kBreaking, text.Find("Dr"));
+  NonbreakingPrefixes compiled(dir.Compile("list.bin", kEmpty).c_str());
+  BOOST_CHECK(compiled.IsNumericOnly(""));
+  BOOST_CHECK(compiled.IsNonbreaking("Mr"));
+  BOOST_CHECK_EQUAL(kBreaking, compiled.Find("Dr"));
+}
+
+BOOST_AUTO_TEST_CASE(LanguageFile) {
+  TempDirectory dir;
+  const std::string &path = dir.Path();
+  BOOST_CHECK_THROW(NonbreakingPrefixes::LanguageFile(path, "fr"), util::Exception);
+  dir.Write("nonbreaking_prefix.en", "Mr\n");
+  BOOST_CHECK_EQUAL(path + "/nonbreaking_prefix.en", NonbreakingPrefixes::LanguageFile(path, "fr"));
+  dir.Compile("nonbreaking_prefix.en.bin", "Mr\n");
+  BOOST_CHECK_EQUAL(path + "/nonbreaking_prefix.en.bin", NonbreakingPrefixes::LanguageFile(path, "fr"));
+  dir.Write("nonbreaking_prefix.fr", "M\n");
+  BOOST_CHECK_EQUAL(path + "/nonbreaking_prefix.fr", NonbreakingPrefixes::LanguageFile(path, "fr"));
+  dir.Compile("nonbreaking_prefix.fr.bin", "M\n");
+  BOOST_CHECK_EQUAL(path + "/nonbreaking_prefix.fr.bin", NonbreakingPrefixes::LanguageFile(path, "fr"));
+  NonbreakingPrefixes prefixes(NonbreakingPrefixes::LanguageFile(path, "fr").c_str());
+  BOOST_CHECK(prefixes.IsNonbreaking("M"));
+  BOOST_CHECK_EQUAL(kBreaking, prefixes.Find("Mr"));
+}
+
+}} // namespaces
@@ -0,0 +1,163 @@
+#include "line_parallel.hh"
+
+#include "util/file_piece.hh"
+#include "util/file_stream.hh"
+#include "util/rewrite_rules.hh"
+
+#include <iostream>
+#include <string>
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace {
+
+/* The substitutions of moses/tokenizer/normalize-punctuation.perl in order.
+ * That script works on bytes, so the rules do too.  Strings with \xC2\xA0 are
+ * no-break spaces.
+ */
+const char *const kRemoveSpaces[] = {
+  R"(s/\r//g)",
+  // remove extra spaces
+  R"(s/\(/ \(/g)",
+  R"(s/\)/\) /g)",
+  R"(s/ +/ /g)",
+  R"(s/\) ([\.\!\:\?\;\,])/\)$1/g)",
+  R"(s/\( /\(/g)",
+  R"(s/ \)/\)/g)",
+  R"(s/(\d) \%/$1\%/g)",
+  R"(s/ :/:/g)",
+  R"(s/ ;/;/g)",
+};
+
+const char *const kNotPenn[] = {
+  R"(s/\`/\'/g)",
+  R"(s/\'\'/ \" /g)",
+};
+
+const char *const kUnicodePunctuation[] = {
+  R"(s/„/\"/g)",
+  R"(s/“/\"/g)",
+  R"(s/”/\"/g)",
+  R"(s/–/-/g)",
+  R"(s/—/ - /g)",
+  R"(s/ +/ /g)",
+  R"(s/´/\'/g)",
+  R"(s/([a-z])‘([a-z])/$1\'$2/gi)",
+  R"(s/([a-z])’([a-z])/$1\'$2/gi)",
+  R"(s/‘/\"/g)",
+  R"(s/‚/\"/g)",
+  R"(s/’/\"/g)",
+  R"(s/''/\"/g)",
+  R"(s/´´/\"/g)",
+  R"(s/…/.../g)",
+  // French quotes
+  "s/\xC2\xA0«\xC2\xA0/ \\\"/g",
+  "s/«\xC2\xA0/\\\"/g",
+  R"(s/«/\"/g)",
+  "s/\xC2\xA0»\xC2\xA0/\\\" /g",
+  "s/\xC2\xA0»/\\\"/g",
+  R"(s/»/\"/g)",
+  // handle pseudo-spaces
+  "s/\xC2\xA0\\%/\\%/g",
+  "s/nº\xC2\xA0/nº /g",
+  "s/\xC2\xA0:/:/g",
+  "s/\xC2\xA0ºC/ ºC/g",
+  "s/\xC2\xA0" "cm/ cm/g",
+  "s/\xC2\xA0\\?/\\?/g",
+  "s/\xC2\xA0\\!/\\!/g",
+  "s/\xC2\xA0;/;/g",
+  "s/,\xC2\xA0/, /g",
+  R"(s/ +/ /g)",
+};
+
+// English "quotation," followed by comma, style
+const char *const kEnglishQuotes[] = {
+  R"(s/\"([,\.]+)/$1\"/g)",
+};
+
+// German/Spanish/French "quotation", followed by comma, style
+const char *const kOtherQuotes[] = {
+  R"(s/,\"/\",/g)",
+  // don't fix period at end of sentence
+  R"(s/(\.+)\"(\s*[^<])/\"$1$2/g)",
+};
+
+const char *const kDecimalComma[] = {
+  "s/(\\d)\xC2\xA0(\\d)/$1,$2/g",
+};
+
+const char *const kDecimalPoint[] = {
+  "s/(\\d)\xC2\xA0(\\d)/$1.$2/g",
+};
+
+template <std::size_t N> void AddAll(util::RewriteRules &rules, const char *const (&add)[N]) {
+  for (const char *rule : add) {
+    rules.Add(rule);
+  }
+}
+
+void Build(const std::string &language, bool penn, util::RewriteRules &rules) {
+  AddAll(rules, kRemoveSpaces);
+  if (!penn) AddAll(rules, kNotPenn);
+  AddAll(rules, kUnicodePunctuation);
+  if (language == "en") {
+    AddAll(rules, kEnglishQuotes);
+  } else if (language != "cs" && language != "cz") {
+    // Czech is confused, so it gets neither.
+    AddAll(rules, kOtherQuotes);
+  }
+  if (language == "de" || language == "es" || language == "cz" || language == "cs" || language == "fr") {
+    AddAll(rules, kDecimalComma);
+  } else {
+    AddAll(rules, kDecimalPoint);
+  }
+}
+
+class Normalizer {
+  public:
+    explicit Normalizer(const util::RewriteRules &rules) : rules_(rules) {}
+
+    template <class Stream> void operator()(StringPiece line, Stream &out) {
+      // The Perl rules see the newline: \s matches it.
+      text_.assign(line.data(), line.size());
+      text_ += '\n';
+      rules_.Apply(text_, scratch_);
+      out << text_;
+    }
+
+  private:
+    const util::RewriteRules &rules_;
+    std::string text_, scratch_;
+};
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::string language("en");
+  bool penn = false;
+  std::size_t threads = 1;
+  for (int i = 1; i < argc; ++i) {
+    if (i + 1 < argc && (!strcmp(argv[i], "-j") || !strcmp(argv[i], "--jobs"))) {
+      threads = strtoul(argv[++i], NULL, 10);
+    } else if (i + 1 < argc && !strcmp(argv[i], "-l")) {
+      language = argv[++i];
+    } else if (!strcmp(argv[i], "-penn")) {
+      penn = true;
+    } else if (!strcmp(argv[i], "-b")) {
+      // Output is flushed when the input ends anyway.
+    } else if (argv[i][0] != '-') {
+      language = argv[i];
+    } else {
+      std::cerr << argv[0] << " [-l language] [-penn] [-j threads] <in >out\n"
+        "Normalizes punctuation with the same output as normalize-punctuation.perl." << std::endl;
+      return 1;
+    }
+  }
+  util::RewriteRules rules(util::RewriteRules::kBytes);
+  Build(language, penn, rules);
+  util::FilePiece in(0);
+  util::FileStream out(1);
+  preprocess::ParallelLines(in, out, Normalizer(rules), threads);
+  return 0;
+}
@@ -1,15 +1,23 @@
 #ifndef PREPROCESS_PARALLEL__
 #define PREPROCESS_PARALLEL__
 
+#include "preprocess/parallel_corpus.hh"
+
 #include "util/file_stream.hh"
 #include "util/file_piece.hh"
+#include "util/stats.hh"
 
 #include <iostream>
+#include <vector>
 
 #include <stdint.h>
 
 template <class Pass> int FilterParallel(Pass &pass, int argc, char **argv) {
   uint64_t input = 0, output = 0;
+  util::Stats stats;
+  util::LineCounters counters(stats);
+  util::StatsCounter &dropped = stats.Counter("dropped_filter");
+  stats.ReportFromEnvironment();
   if (argc == 1) {
     StringPiece line;
     util::FilePiece in(0, NULL, &std::cerr);
@@ -19,32 +27,46 @@ template <class Pass> int FilterParallel(Pass &pass, int argc, char **argv) {
         line = in.ReadLine();
       } catch (const util::EndOfFileException &e) { break; }
       ++input;
+      counters.Read(line);
       if (pass(line)) {
         out << line << '\n';
         ++output;
+        counters.Wrote(line);
+      } else {
+        ++dropped;
       }
     }
   } else if (argc == 5) {
-    StringPiece line0, line1;
     util::FilePiece in0(argv[1], &std::cerr), in1(argv[2]);
     util::FileStream out0(util::CreateOrThrow(argv[3])), out1(util::CreateOrThrow(argv[4]));
-    while (true) {
-      try {
-        line0 = in0.ReadLine();
-      } catch (const util::EndOfFileException &e) { break; }
-      line1 = in1.ReadLine();
-      ++input;
-      if (pass(line0) && pass(line1)) {
-        out0 << line0 << '\n';
-        out1 << line1 << '\n';
-        ++output;
-      }
-    }
+    std::vector<util::FilePiece*> files;
+    files.push_back(&in0);
+    files.push_back(&in1);
     try {
-      line1 = in1.ReadLine();
-      std::cerr << "Input is not balaced: " << argv[2] << " has " << line1 << std::endl;
+      preprocess::ParallelCorpusReader reader(files);
+      preprocess::CorpusBatch batch;
+      while (reader.Next(batch)) {
+        preprocess::CorpusBatchLines lines(batch);
+        for (std::size_t i = 0; i < batch.records; ++i) {
+          StringPiece line0(lines.Next(0)), line1(lines.Next(1));
+          ++input;
+          counters.Read(line0);
+          counters.Read(line1);
+          if (pass(line0) && pass(line1)) {
+            out0 << line0 << '\n';
+            out1 << line1 << '\n';
+            ++output;
+            counters.Wrote(line0);
+            counters.Wrote(line1);
+          } else {
+            ++dropped;
+          }
+        }
+      }
+    } catch (const preprocess::MisalignedException &e) {
+      std::cerr << e.what() << std::endl;
       return 2;
-    } catch (const util::EndOfFileException &e) {}
+    }
   } else {
     std::cerr << 
       "To filter one file, run\n" << argv[0] << " <stdin >stdout\n"
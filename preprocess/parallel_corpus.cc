@@ -0,0 +1,103 @@
+#include "preprocess/parallel_corpus.hh"
+
+#include "util/file_piece.hh"
+
+#include <memory>
+
+namespace preprocess {
+
+namespace {
+const std::size_t kQueueBatches = 4;
+} // namespace
+
+const std::size_t ParallelCorpusReader::kDefaultBatchRecords;
+
+ParallelCorpusReader::File::File(util::FilePiece &in_file, unsigned int lines_per_record_in)
+  : in(in_file), lines_per_record(lines_per_record_in), queue(kQueueBatches), ended(false), records(0) {}
+
+ParallelCorpusReader::ParallelCorpusReader(const std::vector<util::FilePiece*> &files, const std::vector<unsigned int> &lines_per_record, std::size_t batch_records, bool strip_cr)
+  : batch_records_(batch_records), strip_cr_(strip_cr), stop_(false), next_record_(0), files_(files.size()) {
+  for (std::size_t i = 0; i < files.size(); ++i) {
+    files_.push_back(*files[i], i < lines_per_record.size() ? lines_per_record[i] : 1);
+  }
+  for (File &f : files_) {
+    f.thread = std::thread(&ParallelCorpusReader::Read, this, &f);
+  }
+}
+
+ParallelCorpusReader::~ParallelCorpusReader() {
+  stop_ = true;
+  for (File &f : files_) {
+    // Unblock the thread, which will stop at the next batch.
+    for (CorpusBatch *batch; !f.ended; ) {
+      f.queue.Consume(batch);
+      if (batch) {
+        delete batch;
+      } else {
+        f.ended = true;
+      }
+    }
+    f.thread.join();
+  }
+}
+
+bool ParallelCorpusReader::Next(CorpusBatch &batch) {
+  batch.text.resize(files_.size());
+  batch.first_record = next_record_;
+  bool any = false;
+  for (std::size_t i = 0; i < files_.size(); ++i) {
+    File &f = files_[i];
+    std::unique_ptr<CorpusBatch> got;
+    if (!f.ended) {
+      CorpusBatch *consumed;
+      f.queue.Consume(consumed);
+      got.reset(consumed);
+      if (!got) {
+        f.ended = true;
+        if (f.error) std::rethrow_exception(f.error);
+      }
+    }
+    batch.text[i].clear();
+    if (got) {
+      batch.text[i].swap(got->text[0]);
+      f.records += got->records;
+      any = true;
+    }
+  }
+  for (std::size_t i = 1; i < files_.size(); ++i) {
+    UTIL_THROW_IF(files_[i].records != files_[0].records, MisalignedException,
+        "Input is not balanced: " << files_[0].in.FileName() << " has " << files_[0].records << " records so far but " << files_[i].in.FileName() << " has " << files_[i].records << '.');
+  }
+  if (!any) return false;
+  batch.records = files_[0].records - next_record_;
+  next_record_ = files_[0].records;
+  return true;
+}
+
+void ParallelCorpusReader::Read(File *file) {
+  try {
+    StringPiece line;
+    while (!stop_) {
+      std::unique_ptr<CorpusBatch> batch(new CorpusBatch());
+      batch->text.resize(1);
+      std::string &text = batch->text[0];
+      for (batch->records = 0; batch->records < batch_records_; ++batch->records) {
+        if (!file->in.ReadLineOrEOF(line, '\n', strip_cr_)) break;
+        text.append(line.data(), line.size());
+        text.push_back('\n');
+        for (unsigned int i = 1; i < file->lines_per_record; ++i) {
+          UTIL_THROW_IF(!file->in.ReadLineOrEOF(line, '\n', strip_cr_), MisalignedException, file->in.FileName() << " ended in the middle of a record of " << file->lines_per_record << " lines.");
+          text.append(line.data(), line.size());
+          text.push_back('\n');
+        }
+      }
+      if (!batch->records) break;
+      file->queue.Produce(batch.release());
+    }
+  } catch (...) {
+    file->error = std::current_exception();
+  }
+  file->queue.Produce(NULL);
+}
+
+} // namespace preprocess
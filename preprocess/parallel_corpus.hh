@@ -0,0 +1,104 @@
+#pragma once
+// Read several line-aligned files in lockstep with a readahead thread per file.
+
+#include "util/exception.hh"
+#include "util/fixed_array.hh"
+#include "util/pcqueue.hh"
+#include "util/string_piece.hh"
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <string.h>
+
+namespace util { class FilePiece; }
+
+namespace preprocess {
+
+// The files have a different number of records.
+class MisalignedException : public util::Exception {
+  public:
+    MisalignedException() throw() {}
+    ~MisalignedException() throw() {}
+};
+
+// The same range of records from every file.
+struct CorpusBatch {
+  // Index of the first record in this batch.
+  std::size_t first_record;
+  std::size_t records;
+  // One buffer per file, holding its lines including their newlines.
+  std::vector<std::string> text;
+};
+
+// Walk the lines of a CorpusBatch, independently for each file.
+class CorpusBatchLines {
+  public:
+    explicit CorpusBatchLines(const CorpusBatch &batch) {
+      for (const std::string &t : batch.text) {
+        at_.push_back(t.data());
+        end_.push_back(t.data() + t.size());
+      }
+    }
+
+    // Next line of file.  Only call as many times as there are lines.
+    StringPiece Next(std::size_t file) {
+      const char *newline = static_cast<const char*>(memchr(at_[file], '\n', end_[file] - at_[file]));
+      StringPiece ret(at_[file], newline - at_[file]);
+      at_[file] = newline + 1;
+      return ret;
+    }
+
+  private:
+    std::vector<const char*> at_, end_;
+};
+
+/* A record is one line from most files, but a file can be configured to have
+ * several lines per record (i.e. GIZA alignments have three).  Misalignment
+ * throws MisalignedException from Next as soon as a batch disagrees on its
+ * number of records.
+ */
+class ParallelCorpusReader {
+  public:
+    static const std::size_t kDefaultBatchRecords = 4096;
+
+    /* The caller owns the files, which must outlive the reader.  lines_per_record defaults to 1 for each file.
+     * strip_cr removes a carriage return before each newline, as FilePiece::ReadLine does.
+     */
+    explicit ParallelCorpusReader(const std::vector<util::FilePiece*> &files, const std::vector<unsigned int> &lines_per_record = std::vector<unsigned int>(), std::size_t batch_records = kDefaultBatchRecords, bool strip_cr = true);
+
+    ~ParallelCorpusReader();
+
+    // Fill the next batch, reusing its memory.  Returns false at the end of all files.
+    bool Next(CorpusBatch &batch);
+
+  private:
+    struct File {
+      explicit File(util::FilePiece &in, unsigned int lines_per_record);
+
+      util::FilePiece &in;
+      const unsigned int lines_per_record;
+      util::PCQueue<CorpusBatch*> queue;
+      // Set once a NULL has been consumed from the queue.
+      bool ended;
+      // Records handed out so far.
+      std::size_t records;
+      // Set by the thread before it produces its final NULL.
+      std::exception_ptr error;
+      std::thread thread;
+    };
+
+    void Read(File *file);
+
+    const std::size_t batch_records_;
+    const bool strip_cr_;
+    std::atomic<bool> stop_;
+    std::size_t next_record_;
+    util::FixedArray<File> files_;
+};
+
+} // namespace preprocess
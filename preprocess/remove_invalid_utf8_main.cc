@@ -1,14 +1,23 @@
 #include "util/file_stream.hh"
 #include "util/file_piece.hh"
+#include "util/stats.hh"
 #include "util/utf8.hh"
 
 int main() {
+  util::Stats stats;
+  util::LineCounters counters(stats);
+  util::StatsCounter &dropped = stats.Counter("dropped_invalid_utf8");
+  stats.ReportFromEnvironment();
   util::FilePiece in(0);
   util::FileStream out(1);
   StringPiece line;
   while (in.ReadLineOrEOF(line)) {
+    counters.Read(line);
     if (utf8::IsUTF8(line)) {
       out << line << '\n';
+      counters.Wrote(line);
+    } else {
+      ++dropped;
     }
   }
 }
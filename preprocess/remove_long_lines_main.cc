@@ -1,5 +1,6 @@
 #include "util/file_stream.hh"
 #include "util/file_piece.hh"
+#include "util/stats.hh"
 
 #include <boost/lexical_cast.hpp>
 #include <iostream>
@@ -16,13 +17,21 @@ int main(int argc, char *argv[]) {
     std::cerr << "Usage: " << argv[0] << " [length limit in bytes]" << std::endl;
     return 1;
   }
+  util::Stats stats;
+  util::LineCounters counters(stats);
+  util::StatsCounter &dropped = stats.Counter("dropped_too_long");
+  stats.ReportFromEnvironment();
   util::FilePiece f(0, NULL, &std::cerr);
   util::FileStream out(1);
   try {
     while (true) {
       StringPiece l = f.ReadLine();
+      counters.Read(l);
       if (l.size() <= limit) {
         out << l << '\n';
+        counters.Wrote(l);
+      } else {
+        ++dropped;
       }
     }
   } catch (const util::EndOfFileException &e) {}
@@ -0,0 +1,53 @@
+#!/bin/bash
+# Checks that the native heuristics and normalize_punctuation produce the same
+# output as the Perl scripts they replace, on random lines built from fragments
+# the rules care about.
+# Usage: rewrite_equivalence.sh $bin_directory $source_directory [lines] [seed]
+set -e -o pipefail
+if [ $# -lt 2 ]; then
+  echo "Usage: $0 bin_directory source_directory [lines] [seed]" 1>&2
+  exit 1
+fi
+bin="$1"
+src="$2"
+lines="${3:-20000}"
+seed="${4:-1}"
+dir="$(mktemp -d)"
+trap 'rm -rf "$dir"' EXIT
+
+perl -e '
+use utf8;
+binmode STDOUT, ":utf8";
+my ($lines, $seed) = @ARGV;
+srand($seed);
+my @fragments = (
+  " ", " ", " ", "  ", "\t", "\x{2003}", "\x{a0}", "a", "b", "e", "t", "x",
+  "word", "Word", "Élite", "élite", "dlrs", "AT", "s", "at", "&", "t", "p",
+  "full", "time", "vis", "viz", "à", "ça", "là", "-t-", "il", "je", "j\x27",
+  "qu", "lorsqu", "aujourd", "hui", "ca", "n\x27t", "n", "\x27", "\x27\x27",
+  "`", "\x27 s", "al", "EL", "-", "--", "---", "_", "__", "*", "**", "#", "!",
+  "!!", "?", "??", ".", "..", "...", ",", ",,", ":", ";", "%", "+", "++",
+  "(", ")", "<", ">", "\"", "0", "1", "42", "3.5",
+  "\x{201e}", "\x{201c}", "\x{201d}", "\x{2013}", "\x{2014}", "\x{b4}",
+  "\x{2018}", "\x{2019}", "\x{201a}", "\x{2026}", "\x{ab}", "\x{bb}",
+  "n\x{ba}", "\x{ba}C", "cm", "\x{a0}\x{ab}\x{a0}", "\x{a0}\x{bb}\x{a0}",
+  "\x{a0}%", "\x{a0}:", "\x{a0}?", "\x{a0}!", "\x{a0};", ",\x{a0}", "1\x{a0}000",
+  "\x{3b1}", "\x{416}", "\r", "\x0b", "\x0c", "ÉLITE", "Élite", "À", "ÇA", "LÀ",
+  "QU", "AUJOURD", "VIS", "\x{17f}", "\x{212a}", "\x{2126}", "\x{2160}",
+);
+for (1..$lines) {
+  my $length = int(rand(25));
+  my $line = "";
+  $line .= $fragments[int(rand(@fragments))] for 1..$length;
+  print "$line\n";
+}' "$lines" "$seed" >"$dir/in"
+
+perl "$src/heuristics.perl" <"$dir/in" >"$dir/perl"
+"$bin/heuristics" <"$dir/in" >"$dir/native"
+cmp "$dir/perl" "$dir/native"
+
+for args in "-l en" "-l fr" "-l de" "-l cs" "-l en -penn"; do
+  perl "$src/../moses/tokenizer/normalize-punctuation.perl" $args <"$dir/in" >"$dir/perl"
+  "$bin/normalize_punctuation" $args <"$dir/in" >"$dir/native"
+  cmp "$dir/perl" "$dir/native"
+done
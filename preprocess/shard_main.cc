@@ -1,11 +1,14 @@
 #include "preprocess/fields.hh"
+#include "util/async_writer.hh"
 #include "util/file_stream.hh"
 #include "util/file_piece.hh"
 #include "util/fixed_array.hh"
 #include "util/murmur_hash.hh"
+#include "util/stats.hh"
 
 #include <sstream>
 #include <iomanip>
+#include <memory>
 
 #include <boost/program_options.hpp>
 #include <boost/program_options/positional_options.hpp>
@@ -16,6 +19,8 @@ struct Options {
   std::vector<FieldRange> key_fields;
   char delim;
   std::vector<std::string> outputs;
+  std::size_t buffer_size;
+  std::size_t write_threads;
 };
 
 void ParseArgs(int argc, char *argv[], Options &out) {
@@ -31,7 +36,9 @@ void ParseArgs(int argc, char *argv[], Options &out) {
     ("delim,d", po::value(&out.delim)->default_value('\t'), "Field delimiter")
     ("prefix,p", po::value(&prefix), "Prefix and count of outputs")
     ("number,n", po::value(&number), "Number of shards")
-    ("output,o", po::value(&out.outputs)->multitoken(), "Output file names (or just list them without -o)");
+    ("output,o", po::value(&out.outputs)->multitoken(), "Output file names (or just list them without -o)")
+    ("buffer,b", po::value(&out.buffer_size)->default_value(1 << 16), "Output buffer size per file in bytes")
+    ("write-threads,w", po::value(&out.write_threads)->default_value(1), "Threads shared by all outputs for writing.  0 writes in the main thread.");
 
   po::positional_options_description pd;
   pd.add("output", -1);
@@ -82,17 +89,35 @@ int main(int argc, char *argv[]) {
   preprocess::ParseArgs(argc, argv, options);
   uint64_t shard_count = options.outputs.size();
 
+  util::Stats stats;
+  util::LineCounters counters(stats);
+  util::FixedArray<util::StatsCounter*> shard_lines(shard_count);
+  for (uint64_t i = 0; i < shard_count; ++i) {
+    shard_lines.push_back(&stats.Counter("lines_written_" + options.outputs[i]));
+  }
+  stats.ReportFromEnvironment();
+
   util::FilePiece in(0);
   StringPiece line;
+  // Declared before the streams so it outlives them.
+  std::unique_ptr<util::AsyncWriter> writer;
+  if (options.write_threads) writer.reset(new util::AsyncWriter(options.write_threads));
   util::FixedArray<util::FileStream> out(options.outputs.size());
-  std::string output(argv[1]);
   for (const std::string &o : options.outputs) {
-    out.push_back(util::CreateOrThrow(o.c_str()));
+    if (writer) {
+      out.push_back(util::CreateOrThrow(o.c_str()), options.buffer_size, *writer);
+    } else {
+      out.push_back(util::CreateOrThrow(o.c_str()), options.buffer_size);
+    }
   }
   while (in.ReadLineOrEOF(line)) {
     preprocess::HashCallback cb;
     preprocess::RangeFields(line, options.key_fields, options.delim, cb);
-    out[cb.Hash() % shard_count] << line << '\n';
+    uint64_t shard = cb.Hash() % shard_count;
+    out[shard] << line << '\n';
+    counters.Read(line);
+    counters.Wrote(line);
+    ++*shard_lines[shard];
   }
   return 0;
 }
@@ -1,11 +1,21 @@
 #include "preprocess/fields.hh"
+#include "line_parallel.hh"
+#include "util/file.hh"
 #include "util/file_stream.hh"
 #include "util/file_piece.hh"
+#include "util/mmap.hh"
 #include "util/murmur_hash.hh"
 #include "util/pool.hh"
 #include "util/probing_hash_table.hh"
+
+#include <iostream>
 #include <vector>
 
+#include <stdlib.h>
+#include <string.h>
+
+namespace {
+
 struct Entry {
   typedef uint64_t Key;
   Key key;
@@ -14,6 +24,19 @@ struct Entry {
   StringPiece value;
 };
 
+// Two-pass mode: value of the first occurrence as an offset into the mapped file.
+#pragma pack(push)
+#pragma pack(4)
+struct OffsetEntry {
+  typedef uint64_t Key;
+  Key key;
+  uint64_t GetKey() const { return key; }
+  void SetKey(uint64_t to) { key = to; }
+  uint64_t offset;
+  uint32_t length;
+};
+#pragma pack(pop)
+
 class RecordCallback {
   public:
     RecordCallback(StringPiece *to) : i_(to) {}
@@ -28,38 +51,52 @@ class RecordCallback {
     StringPiece *i_;
 };
 
-int main() {
-  std::vector<preprocess::FieldRange> fields;
-  fields.resize(4);
-  StringPiece segments[4];
-  fields[0].begin = 0;
-  fields[0].end = 2;
-  StringPiece &sentences = segments[1];
-  fields[1].begin = 2;
-  fields[1].end = 4;
-  StringPiece &value = segments[2];
-  fields[2].begin = 4;
-  fields[2].end = 5;
-  StringPiece &after = segments[3];
-  fields[3].begin = 5;
-  fields[3].end = preprocess::FieldRange::kInfiniteEnd;
+// Splits a line into columns 1-2, sentences (columns 3-4), value (column 5), and the rest.
+class Splitter {
+  public:
+    Splitter() : fields_(4) {
+      fields_[0].begin = 0;
+      fields_[0].end = 2;
+      fields_[1].begin = 2;
+      fields_[1].end = 4;
+      fields_[2].begin = 4;
+      fields_[2].end = 5;
+      fields_[3].begin = 5;
+      fields_[3].end = preprocess::FieldRange::kInfiniteEnd;
+    }
 
+    void Split(StringPiece line, StringPiece *segments) const {
+      RecordCallback cb(segments);
+      preprocess::RangeFields(line, fields_, '\t', cb);
+      UTIL_THROW_IF2(cb.Position() != segments + 4, "Did not get all fields in line " << line);
+    }
+
+  private:
+    std::vector<preprocess::FieldRange> fields_;
+};
+
+template <class Stream> void WriteSubstituted(StringPiece line, const StringPiece *segments, StringPiece value, Stream &out) {
+  out << StringPiece(line.data(), segments[1].data() + segments[1].size() - line.data());
+  out << '\t' << value << '\t' << segments[3];
+}
+
+// Original single pass over stdin, copying values.
+void Streaming() {
+  Splitter splitter;
+  StringPiece segments[4];
   util::Pool string_pool;
   util::FileStream out(1);
 
   typedef util::AutoProbing<Entry, util::IdentityHash> Table;
   Table table;
   for (StringPiece line : util::FilePiece(0)) {
-    RecordCallback cb(segments);
-    preprocess::RangeFields(line, fields, '\t', cb);
-    UTIL_THROW_IF2(cb.Position() != segments + 4, "Did not get all fields in line " << line);
+    splitter.Split(line, segments);
+    const StringPiece &sentences = segments[1], &value = segments[2];
     Entry entry;
     entry.key = util::MurmurHashNative(sentences.data(), sentences.size());
     Table::MutableIterator it;
     if (table.FindOrInsert(entry, it)) {
-       out << StringPiece(line.data(), sentences.data() + sentences.size() - line.data());
-       out << '\t' << it->value << '\t';
-       out << after;
+      WriteSubstituted(line, segments, it->value, out);
     } else {
       char *mem = static_cast<char*>(memcpy(string_pool.Allocate(value.size()), value.data(), value.size()));
       it->value = StringPiece(mem, value.size());
@@ -68,3 +105,89 @@ int main() {
     out << '\n';
   }
 }
+
+typedef util::AutoProbing<OffsetEntry, util::IdentityHash> OffsetTable;
+
+// First pass: remember where the first value for each key is.
+class Indexer {
+  public:
+    Indexer(StringPiece text, OffsetTable &table) : base_(text.data()), table_(table) {}
+
+    void operator()(StringPiece line) {
+      splitter_.Split(line, segments_);
+      OffsetEntry entry;
+      entry.key = util::MurmurHashNative(segments_[1].data(), segments_[1].size());
+      OffsetTable::MutableIterator it;
+      if (!table_.FindOrInsert(entry, it)) {
+        it->offset = segments_[2].data() - base_;
+        it->length = segments_[2].size();
+      }
+    }
+
+  private:
+    const char *base_;
+    OffsetTable &table_;
+    Splitter splitter_;
+    StringPiece segments_[4];
+};
+
+/* Second pass: every line gets the value of the first occurrence of its key.
+ * For the first occurrence itself, this reproduces the line.
+ */
+class Substituter {
+  public:
+    Substituter(StringPiece text, const OffsetTable &table) : base_(text.data()), table_(table) {}
+
+    template <class Stream> void operator()(StringPiece line, Stream &out) {
+      splitter_.Split(line, segments_);
+      OffsetTable::ConstIterator it;
+      UTIL_THROW_IF2(!table_.Find(util::MurmurHashNative(segments_[1].data(), segments_[1].size()), it), "Input changed between passes at line " << line);
+      WriteSubstituted(line, segments_, StringPiece(base_ + it->offset, it->length), out);
+      out << '\n';
+    }
+
+  private:
+    const char *base_;
+    const OffsetTable &table_;
+    Splitter splitter_;
+    StringPiece segments_[4];
+};
+
+void TwoPass(const char *name, std::size_t threads) {
+  util::scoped_fd file(util::OpenReadOrThrow(name));
+  uint64_t size = util::SizeOrThrow(file.get());
+  if (!size) return;
+  util::scoped_memory mem;
+  util::MapRead(util::POPULATE_OR_LAZY, file.get(), 0, size, mem);
+  StringPiece text(static_cast<const char*>(mem.get()), size);
+
+  OffsetTable table;
+  Indexer indexer(text, table);
+  preprocess::ForEachLine(text, indexer);
+
+  util::FileStream out(1);
+  preprocess::ParallelMappedLines(text, out, Substituter(text, table), threads);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::size_t threads = 1;
+  if (argc >= 3 && (!strcmp(argv[1], "-j") || !strcmp(argv[1], "--jobs"))) {
+    threads = strtoul(argv[2], NULL, 10);
+    argc -= 2;
+    argv += 2;
+  }
+  if (argc == 1) {
+    Streaming();
+  } else if (argc == 2) {
+    TwoPass(argv[1], threads);
+  } else {
+    std::cerr << argv[0] << " [-j threads] [file]\n"
+      "Replaces column 5 with the column 5 of the first line that has the same columns 3 and 4.\n"
+      "Without a file, streams stdin in one pass and stores values in memory.\n"
+      "With a file, memory maps it and makes two passes: the first indexes values by\n"
+      "offset and the second rewrites lines on multiple threads." << std::endl;
+    return 1;
+  }
+}
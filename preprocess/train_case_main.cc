@@ -1,103 +1,498 @@
-#include "util/file_stream.hh"
+#include "case_model.hh"
+#include "parallel_corpus.hh"
+
+#include "util/file.hh"
 #include "util/file_piece.hh"
+#include "util/file_stream.hh"
+#include "util/fixed_array.hh"
+#include "util/mmap.hh"
 #include "util/murmur_hash.hh"
-#include "util/mutable_vocab.hh"
+#include "util/pcqueue.hh"
+#include "util/pool.hh"
+#include "util/probing_hash_table.hh"
+#include "util/string_stream.hh"
+#include "util/string_to_integer.hh"
 #include "util/tokenize_piece.hh"
 #include "util/utf8.hh"
 
-#include <boost/lexical_cast.hpp>
-#include <boost/unordered_map.hpp>
+#include <boost/program_options/options_description.hpp>
+#include <boost/program_options/parsers.hpp>
+#include <boost/program_options/positional_options.hpp>
+#include <boost/program_options/variables_map.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
 
+#include <string.h>
+
+namespace preprocess {
 namespace {
-void SplitLine(util::FilePiece &from, std::vector<StringPiece> &to) {
-  to.clear();
-  for (util::TokenIter<util::SingleCharacter, true> i(from.ReadLine(), ' '); i; ++i) {
-    to.push_back(*i);
+
+// Spilled runs per thread before they are merged into one.
+const std::size_t kMaxSpills = 64;
+
+const util::ByteSet kSpace(" ");
+
+void SplitLine(StringPiece line, std::vector<StringPiece> &to) {
+  util::Tokenize(line, kSpace, to);
+}
+
+unsigned long ParseIndex(StringPiece token) {
+  UTIL_THROW_IF2(token.empty(), "Expected a number");
+  uint64_t ret;
+  const char *end = token.data() + token.size();
+  UTIL_THROW_IF2(util::ParseDecimal(token.data(), end, ret) != end, "Expected a number, not " << token);
+  return ret;
+}
+
+/* Spilled and final counts are runs of records sorted by (context, target):
+ *   uint64_t context, uint64_t count, uint32_t length, then length bytes.
+ */
+template <class Stream> void WriteRecord(Stream &out, uint64_t context, StringPiece target, uint64_t count) {
+  uint32_t length = target.size();
+  out.write(&context, sizeof(uint64_t));
+  out.write(&count, sizeof(uint64_t));
+  out.write(&length, sizeof(uint32_t));
+  out.write(target.data(), length);
+}
+
+class RunCursor {
+  public:
+    RunCursor(const char *begin, const char *end) : next_(begin), end_(end) {
+      ++*this;
+    }
+
+    operator bool() const { return valid_; }
+
+    RunCursor &operator++() {
+      valid_ = (next_ != end_);
+      if (!valid_) return *this;
+      uint32_t length;
+      memcpy(&context_, next_, sizeof(uint64_t));
+      memcpy(&count_, next_ + sizeof(uint64_t), sizeof(uint64_t));
+      memcpy(&length, next_ + 2 * sizeof(uint64_t), sizeof(uint32_t));
+      next_ += 2 * sizeof(uint64_t) + sizeof(uint32_t);
+      target_ = StringPiece(next_, length);
+      next_ += length;
+      return *this;
+    }
+
+    uint64_t Context() const { return context_; }
+    StringPiece Target() const { return target_; }
+    uint64_t Count() const { return count_; }
+
+    bool operator<(const RunCursor &other) const {
+      return context_ < other.context_ || (context_ == other.context_ && target_ < other.target_);
+    }
+
+  private:
+    const char *next_, *end_;
+    bool valid_;
+
+    uint64_t context_;
+    StringPiece target_;
+    uint64_t count_;
+};
+
+struct CursorGreater {
+  bool operator()(const RunCursor *a, const RunCursor *b) const {
+    return *b < *a;
+  }
+};
+
+/* Merge runs, calling sink(context, target, count) once per distinct pair in
+ * (context, target) order, then sink.Finish().
+ */
+template <class Sink> void Merge(std::vector<RunCursor> &runs, Sink &sink) {
+  std::priority_queue<RunCursor*, std::vector<RunCursor*>, CursorGreater> queue;
+  for (RunCursor &r : runs) {
+    if (r) queue.push(&r);
+  }
+  while (!queue.empty()) {
+    RunCursor *top = queue.top();
+    uint64_t context = top->Context();
+    StringPiece target = top->Target();
+    uint64_t count = 0;
+    while (!queue.empty() && queue.top()->Context() == context && queue.top()->Target() == target) {
+      top = queue.top();
+      queue.pop();
+      count += top->Count();
+      if (++*top) queue.push(top);
+    }
+    sink(context, target, count);
   }
+  sink.Finish();
 }
 
-class Recorder {
+// Rewrites merged counts as a single run.
+class RecordSink {
+  public:
+    explicit RecordSink(int fd) : out_(fd, 1 << 20) {}
+
+    void operator()(uint64_t context, StringPiece target, uint64_t count) {
+      WriteRecord(out_, context, target, count);
+    }
+
+    void Finish() {}
+
+  private:
+    util::FileStream out_;
+};
+
+// Counts for one thread, spilled to disk as sorted runs when they get too big.
+class Counter {
   public:
+    Counter(std::size_t memory, const std::string &temp_prefix)
+      : memory_(memory), temp_prefix_(temp_prefix), pool_bytes_(0) {}
+
     void Add(StringPiece source, StringPiece target) {
       utf8::ToLower(target, lowered_);
-      uint64_t key = util::MurmurHash64A(lowered_.data(), lowered_.size(), util::MurmurHash64A(source.data(), source.size()));
-      ++map_[key][vocab_.FindOrInsert(target)];
+      CountEntry entry;
+      entry.context = CaseModelKey(source, lowered_);
+      entry.key = util::MurmurHash64A(target.data(), target.size(), entry.context);
+      entry.count = 0;
+      Table::MutableIterator it;
+      if (!table_.FindOrInsert(entry, it)) {
+        it->target = static_cast<const char*>(memcpy(pool_.Allocate(target.size()), target.data(), target.size()));
+        it->target_length = target.size();
+        pool_bytes_ += target.size();
+      }
+      ++it->count;
     }
 
-    void Dump() {
-      util::FileStream out(1);
-      for (Map::const_iterator i = map_.begin(); i != map_.end(); ++i) {
-        out << boost::lexical_cast<std::string>(i->first);
-        for (boost::unordered_map<uint32_t, unsigned int>::const_iterator j = i->second.begin(); j != i->second.end(); ++j) {
-          out << '\t' << vocab_.String(j->first) << ' ' << j->second;
-        }
-        out << '\n';
+    // Call between sentences.
+    void SpillIfNeeded() {
+      if (Table::MemUsage(table_.Size()) + pool_bytes_ < memory_) return;
+      spilled_.emplace_back(util::MakeTemp(temp_prefix_));
+      {
+        util::FileStream out(spilled_.back().get(), 1 << 20);
+        WriteSorted(out);
       }
+      Clear();
+      if (spilled_.size() >= kMaxSpills) Compact();
+    }
+
+    // Move the remaining counts to an in-memory run.
+    void Finish() {
+      util::StringStream out;
+      WriteSorted(out);
+      out.swap(in_memory_);
+      Clear();
+    }
+
+    // After Finish: add cursors over all runs, mapping the spilled ones.
+    void Runs(std::vector<util::scoped_memory> &mapped, std::vector<RunCursor> &out) {
+      MapSpilled(mapped, out);
+      out.push_back(RunCursor(in_memory_.data(), in_memory_.data() + in_memory_.size()));
     }
 
   private:
-    util::MutableVocab vocab_;
+    void MapSpilled(std::vector<util::scoped_memory> &mapped, std::vector<RunCursor> &out) {
+      for (util::scoped_fd &file : spilled_) {
+        uint64_t size = util::SizeOrThrow(file.get());
+        if (!size) continue;
+        mapped.emplace_back();
+        util::MapRead(util::LAZY, file.get(), 0, size, mapped.back());
+        out.push_back(RunCursor(mapped.back().begin(), mapped.back().end()));
+      }
+    }
+
+    // Merge spilled runs into one to bound the number of open files.
+    void Compact() {
+      util::scoped_fd merged(util::MakeTemp(temp_prefix_));
+      {
+        std::vector<util::scoped_memory> mapped;
+        std::vector<RunCursor> runs;
+        MapSpilled(mapped, runs);
+        RecordSink sink(merged.get());
+        Merge(runs, sink);
+      }
+      spilled_.clear();
+      spilled_.push_back(std::move(merged));
+    }
+
+    struct CountEntry {
+      typedef uint64_t Key;
+      uint64_t GetKey() const { return key; }
+      void SetKey(uint64_t to) { key = to; }
+
+      // Hash of target seeded with context.
+      uint64_t key;
+      // CaseModelKey(source, lowered target)
+      uint64_t context;
+      const char *target;
+      uint32_t target_length;
+      uint64_t count;
+    };
+
+    struct SortOrder {
+      bool operator()(const CountEntry *a, const CountEntry *b) const {
+        if (a->context != b->context) return a->context < b->context;
+        return StringPiece(a->target, a->target_length) < StringPiece(b->target, b->target_length);
+      }
+    };
+
+    template <class Stream> void WriteSorted(Stream &out) {
+      std::vector<const CountEntry*> sorted;
+      sorted.reserve(table_.Size());
+      for (Table::ConstIterator i = table_.RawBegin(); i != table_.RawEnd(); ++i) {
+        if (i->key) sorted.push_back(i);
+      }
+      std::sort(sorted.begin(), sorted.end(), SortOrder());
+      for (const CountEntry *i : sorted) {
+        WriteRecord(out, i->context, StringPiece(i->target, i->target_length), i->count);
+      }
+    }
+
+    void Clear() {
+      table_.Clear();
+      pool_.FreeAll();
+      pool_bytes_ = 0;
+    }
+
+    const std::size_t memory_;
+    const std::string temp_prefix_;
+
+    typedef util::AutoProbing<CountEntry, util::IdentityHash> Table;
+    Table table_;
+    util::Pool pool_;
+    std::size_t pool_bytes_;
 
     std::string lowered_;
 
-    // map_[hash(lowered_target, hash(cased_source))][cased_target] = count(cased_source, cased_target)
-    typedef boost::unordered_map<uint64_t, boost::unordered_map<uint32_t, unsigned int> > Map;
-    Map map_;
+    std::vector<util::scoped_fd> spilled_;
+    std::string in_memory_;
 };
 
-} // namespace
+struct Worker {
+  Worker(std::size_t memory, const std::string &temp_prefix)
+    : counter(memory, temp_prefix), sentences(0), discarded(0) {}
 
-int main(int argc, char *argv[]) {
-  if (argc != 4) {
-    std::cerr << "Usage: " << argv[0] << " alignment source target\n";
-    return 1;
+  Counter counter;
+  std::size_t sentences, discarded;
+};
+
+// Parse GIZA output for one sentence.  Returns false if it was discarded.
+bool CountSentence(StringPiece comment, StringPiece alignment, const std::vector<StringPiece> &source_words, const std::vector<StringPiece> &target_words, std::size_t sentence, Counter &counter) {
+  // "# Sentence pair (0) source length 5 target length 6 alignment score : ..."
+  util::TokenIter<util::BoolCharacter, true> token(comment, util::kSpaces);
+  for (unsigned int i = 0; i < 6; ++i) ++token;
+  unsigned long from_length = ParseIndex(*token);
+  for (unsigned int i = 0; i < 3; ++i) ++token;
+  unsigned long to_length = ParseIndex(*token);
+
+  util::TokenIter<util::BoolCharacter, true> word(alignment, util::kSpaces);
+  UTIL_THROW_IF2(!word || "NULL" != *word, "Expected NULL at the beginning, not " << (word ? *word : StringPiece()));
+
+  if (from_length != source_words.size() || to_length != target_words.size()) {
+    return false;
   }
-  util::FilePiece align(argv[1], &std::cerr), source_file(argv[2]), target_file(argv[3]);
-  std::vector<StringPiece> source_words, target_words;
-  Recorder recorder;
-  std::size_t sentence = 0, discarded = 0;
-  for (; ; ++sentence) {
-    try {
-      SplitLine(source_file, source_words);
-    } catch (const util::EndOfFileException &e) { break; }
-    SplitLine(target_file, target_words);
-    // parse comment lone
-    // "# sentence pair (0) source length"
-    for (unsigned int i = 0; i < 6; ++i) {
-      align.ReadDelimited();
-    }
-    unsigned long from_length = align.ReadULong();
-    align.ReadDelimited(); align.ReadDelimited(); // target length
-    unsigned long to_length = align.ReadULong();
-    align.ReadLine(); // comment line ending
-
-    align.ReadLine(); // uncased sentence
-    StringPiece word(align.ReadDelimited());
-    UTIL_THROW_IF2("NULL" != word, "Expected NULL at the beginning, not " << word);
-
-    if (from_length != source_words.size() || to_length != target_words.size()) {
-      align.ReadLine(); // Complete line.
-      ++discarded;
-      continue;
-    }
-
-    while ("})" != align.ReadDelimited()) {}
-    for (unsigned long from = 0; align.ReadWordSameLine(word); ++from) {
-      align.ReadWordSameLine(word);
-      UTIL_THROW_IF2(word != "({", "Expected ({ not " << word);
-      UTIL_THROW_IF2(from >= source_words.size(), "Index " << from << " too high for source text at sentence " << sentence);
-      for (align.SkipSpaces(); align.peek() != '}'; align.SkipSpaces()) {
-        unsigned long to = align.ReadULong() - 1 /* NULL word */;
-        UTIL_THROW_IF2(to >= target_words.size(), "Index " << to << " too high for target text");
-        // Throw out beginning of sentence.
-        if (from != 0 && to != 0) {
-          recorder.Add(source_words[from], target_words[to]);
+
+  while (*++word != "})") {}
+  for (unsigned long from = 0; ++word; ++from) {
+    UTIL_THROW_IF2(*++word != "({", "Expected ({ not " << *word);
+    UTIL_THROW_IF2(from >= source_words.size(), "Index " << from << " too high for source text at sentence " << sentence);
+    for (++word; *word != "})"; ++word) {
+      unsigned long to = ParseIndex(*word) - 1 /* NULL word */;
+      UTIL_THROW_IF2(to >= target_words.size(), "Index " << to << " too high for target text");
+      // Throw out beginning of sentence.
+      if (from != 0 && to != 0) {
+        counter.Add(source_words[from], target_words[to]);
+      }
+    }
+  }
+  return true;
+}
+
+void CountBatches(util::PCQueue<CorpusBatch*> *queue, Worker *worker) {
+  try {
+    std::vector<StringPiece> source_words, target_words;
+    CorpusBatch *batch;
+    while (true) {
+      queue->Consume(batch);
+      if (!batch) break;
+      std::unique_ptr<CorpusBatch> owned(batch);
+      CorpusBatchLines lines(*batch);
+      for (std::size_t i = 0; i < batch->records; ++i) {
+        SplitLine(lines.Next(0), source_words);
+        SplitLine(lines.Next(1), target_words);
+        StringPiece comment(lines.Next(2));
+        lines.Next(2); // uncased sentence
+        if (!CountSentence(comment, lines.Next(2), source_words, target_words, batch->first_record + i, worker->counter)) {
+          ++worker->discarded;
         }
+        worker->counter.SpillIfNeeded();
       }
-      UTIL_THROW_IF2(align.ReadDelimited() != "})", "Expected })");
+      worker->sentences += batch->records;
     }
-    align.ReadLine(); // Complete line.
+    worker->counter.Finish();
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    abort();
   }
-  std::cerr << "Discarded " << discarded << "/" << sentence << std::endl;
-  recorder.Dump();
+}
+
+// Text format: context \t target count \t target count ...
+class TextSink {
+  public:
+    explicit TextSink(int fd) : out_(fd), first_(true) {}
+
+    void operator()(uint64_t context, StringPiece target, uint64_t count) {
+      if (first_ || context != context_) {
+        if (!first_) out_ << '\n';
+        out_ << context;
+        context_ = context;
+        first_ = false;
+      }
+      out_ << '\t' << target << ' ' << count;
+    }
+
+    void Finish() {
+      if (!first_) out_ << '\n';
+    }
+
+  private:
+    util::FileStream out_;
+    uint64_t context_;
+    bool first_;
+};
+
+// Keep the most frequent casing for each context.
+class BinarySink {
+  public:
+    BinarySink() : best_count_(0) {}
+
+    void operator()(uint64_t context, StringPiece target, uint64_t count) {
+      if (best_count_ && context != context_) Flush();
+      context_ = context;
+      if (count > best_count_) {
+        best_count_ = count;
+        best_ = target;
+      }
+    }
+
+    void Finish() {
+      if (best_count_) Flush();
+    }
+
+    const CaseModelBuilder &Builder() const { return builder_; }
+
+  private:
+    void Flush() {
+      builder_.Add(context_, best_);
+      best_count_ = 0;
+    }
+
+    CaseModelBuilder builder_;
+
+    uint64_t context_;
+    StringPiece best_;
+    uint64_t best_count_;
+};
+
+struct Options {
+  std::string alignment, source, target;
+  std::string binary;
+  std::string temp_prefix;
+  std::size_t threads;
+  std::size_t memory;
+};
+
+void Run(const Options &options) {
+  util::FilePiece align(options.alignment.c_str(), &std::cerr), source_file(options.source.c_str()), target_file(options.target.c_str());
+
+  util::PCQueue<CorpusBatch*> queue(options.threads * 2);
+  util::FixedArray<Worker> workers(options.threads);
+  util::FixedArray<std::thread> threads(options.threads);
+  for (std::size_t i = 0; i < options.threads; ++i) {
+    workers.push_back(options.memory / options.threads, options.temp_prefix);
+    threads.push_back(CountBatches, &queue, &workers.back());
+  }
+
+  std::vector<util::FilePiece*> files;
+  files.push_back(&source_file);
+  files.push_back(&target_file);
+  files.push_back(&align);
+  // GIZA has a comment, the uncased sentence, and the alignment.
+  std::vector<unsigned int> lines_per_record(3, 1);
+  lines_per_record[2] = 3;
+  std::exception_ptr error;
+  try {
+    ParallelCorpusReader reader(files, lines_per_record);
+    while (true) {
+      std::unique_ptr<CorpusBatch> batch(new CorpusBatch());
+      if (!reader.Next(*batch)) break;
+      queue.Produce(batch.release());
+    }
+  } catch (...) {
+    // Stop the workers before reporting.
+    error = std::current_exception();
+  }
+  for (std::size_t i = 0; i < options.threads; ++i) {
+    queue.Produce(NULL);
+  }
+  for (std::thread &t : threads) {
+    t.join();
+  }
+  if (error) std::rethrow_exception(error);
+
+  std::size_t sentences = 0, discarded = 0;
+  std::vector<util::scoped_memory> mapped;
+  std::vector<RunCursor> runs;
+  for (Worker &w : workers) {
+    sentences += w.sentences;
+    discarded += w.discarded;
+    w.counter.Runs(mapped, runs);
+  }
+  std::cerr << "Discarded " << discarded << "/" << sentences << std::endl;
+
+  if (options.binary.empty()) {
+    TextSink sink(1);
+    Merge(runs, sink);
+  } else {
+    BinarySink sink;
+    Merge(runs, sink);
+    util::scoped_fd out(util::CreateOrThrow(options.binary.c_str()));
+    sink.Builder().Write(out.get());
+  }
+}
+
+void ParseArgs(int argc, char *argv[], Options &out) {
+  namespace po = boost::program_options;
+  po::options_description desc("Arguments");
+  desc.add_options()
+    ("help,h", po::bool_switch(), "Show this help message")
+    ("alignment", po::value(&out.alignment)->required(), "GIZA alignment file")
+    ("source", po::value(&out.source)->required(), "Cased source text")
+    ("target", po::value(&out.target)->required(), "Cased target text")
+    ("binary,b", po::value(&out.binary), "Write a binary model for apply_case to this file instead of text to stdout")
+    ("jobs,j", po::value(&out.threads)->default_value(std::thread::hardware_concurrency()), "Number of counting threads")
+    ("memory,S", po::value(&out.memory)->default_value(1024), "Approximate memory limit for counts in MB before spilling to disk")
+    ("temp_prefix,T", po::value(&out.temp_prefix)->default_value(util::DefaultTempDirectory()), "Prefix for spilled counts");
+  po::positional_options_description positional;
+  positional.add("alignment", 1).add("source", 1).add("target", 1);
+  po::variables_map vm;
+  po::store(po::command_line_parser(argc, argv).options(desc).positional(positional).run(), vm);
+  if (argc == 1 || vm["help"].as<bool>()) {
+    std::cerr << "Usage: " << argv[0] << " alignment source target\n" << desc;
+    exit(1);
+  }
+  po::notify(vm);
+  out.threads = std::max<std::size_t>(out.threads, 1);
+  out.memory <<= 20;
+}
+
+} // namespace
+} // namespace preprocess
+
+int main(int argc, char *argv[]) {
+  preprocess::Options options;
+  preprocess::ParseArgs(argc, argv, options);
+  preprocess::Run(options);
 }
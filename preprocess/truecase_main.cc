@@ -1,11 +1,17 @@
+#include "line_parallel.hh"
+
 #include "util/file_piece.hh"
 #include "util/file_stream.hh"
+#include "util/file.hh"
+#include "util/mmap.hh"
 #include "util/murmur_hash.hh"
-#include "util/pool.hh"
 #include "util/probing_hash_table.hh"
 #include "util/tokenize_piece.hh"
 #include "util/utf8.hh"
 
+#include <memory>
+
+#include <stdlib.h>
 #include <string.h>
 
 uint64_t Hash(const StringPiece &str) {
@@ -14,10 +20,14 @@ uint64_t Hash(const StringPiece &str) {
 
 class Truecase {
   public:
+    // Loads either a Moses-format text model or a binary image from Compile.
     explicit Truecase(const char *file);
 
     // Apply truecasing, using temp as a buffer (to remain const and fast).
-    void Apply(const StringPiece &line, std::string &temp, util::FileStream &out) const;
+    template <class Stream> void Apply(const StringPiece &line, std::string &temp, Stream &out) const;
+
+    // Write the model as a binary image that the constructor can mmap.
+    void Compile(const char *file) const;
 
   private:
     struct TableEntry {
@@ -25,51 +35,102 @@ class Truecase {
       Key key;
       uint64_t GetKey() const { return key; }
       void SetKey(uint64_t to) { key = to; }
-      
-      const char *best;
+
+      // Offset and length of the best casing in strings_.
+      uint64_t best;
+      uint32_t best_length;
       // If only the uppercase version is known, the lowercase version will still be in the hash table.
       bool known;
       bool sentence_end;
       bool delayed_sentence_start;
     };
 
+    // Binary layout: this header, the hash table buckets, then the strings.
+    struct BinaryHeader {
+      char magic[8];
+      // Guards against loading a model compiled on a different platform.
+      uint64_t entry_size;
+      uint64_t table_bytes;
+      uint64_t strings_bytes;
+    };
+
+    static const char kMagic[8];
+
+    // Mutable hash table used while parsing a text model.
+    typedef util::AutoProbing<TableEntry, util::IdentityHash> Builder;
+    // Same bucket layout as Builder, but over memory we don't own.
+    typedef util::ProbingHashTable<TableEntry, util::IdentityHash, std::equal_to<uint64_t>, util::Power2Mod> Table;
+
+    void LoadText(const char *file);
+
+    void LoadBinary(const BinaryHeader &header, int fd, uint64_t size);
+
     TableEntry &Insert(StringPiece word) {
       TableEntry entry;
       entry.key = Hash(word);
       entry.sentence_end = false;
       entry.delayed_sentence_start = false;
       entry.known = true;
-      Table::MutableIterator it;
-      if (!table_.FindOrInsert(entry, it)) {
-        char *start = static_cast<char*>(memcpy(string_pool_.Allocate(word.size() + 1), word.data(), word.size()));
-        start[word.size()] = '\0';
-        it->best = start;
+      Builder::MutableIterator it;
+      if (!builder_->FindOrInsert(entry, it)) {
+        it->best = built_strings_.size();
+        it->best_length = word.size();
+        built_strings_.append(word.data(), word.size());
       } else {
         it->known = true;
       }
       return *it;
     }
 
-    void InsertFollow(StringPiece word, const char *best, bool known) {
+    void InsertFollow(StringPiece word, const TableEntry &top, bool known) {
       TableEntry entry;
       entry.key = Hash(word);
       entry.sentence_end = false;
       entry.delayed_sentence_start = false;
-      entry.best = best;
+      entry.best = top.best;
+      entry.best_length = top.best_length;
       entry.known = known;
-      Table::MutableIterator it;
-      table_.FindOrInsert(entry, it);
+      Builder::MutableIterator it;
+      builder_->FindOrInsert(entry, it);
       it->known |= known;
     }
 
-    util::Pool string_pool_;
+    StringPiece Best(const TableEntry &entry) const {
+      return StringPiece(strings_ + entry.best, entry.best_length);
+    }
+
+    // Backing for text models.
+    std::unique_ptr<Builder> builder_;
+    std::string built_strings_;
 
-    typedef util::AutoProbing<TableEntry, util::IdentityHash> Table;
+    // Backing for binary models.
+    util::scoped_memory mapped_;
 
+    // Views used by Apply, pointing into one of the above.
     Table table_;
+    const char *strings_;
+    std::size_t strings_size_;
 };
 
+const char Truecase::kMagic[8] = {'\0', 't', 'r', 'u', 'e', 'c', 'a', '1'};
+
 Truecase::Truecase(const char *file) {
+  util::scoped_fd fd(util::OpenReadOrThrow(file));
+  uint64_t size = util::SizeFile(fd.get());
+  BinaryHeader header;
+  if (size != util::kBadSize && size >= sizeof(BinaryHeader)) {
+    util::ReadOrThrow(fd.get(), &header, sizeof(BinaryHeader));
+    if (!memcmp(header.magic, kMagic, sizeof(kMagic))) {
+      LoadBinary(header, fd.get(), size);
+      return;
+    }
+  }
+  // Text models can be compressed or piped, so let FilePiece reopen it.
+  LoadText(file);
+}
+
+void Truecase::LoadText(const char *file) {
+  builder_.reset(new Builder());
   // Sentence ends.
   const char *kEndSentence[] = { ".", ":", "?", "!"};
   for (const char *const *i = kEndSentence; i != kEndSentence + sizeof(kEndSentence) / sizeof(const char*); ++i)
@@ -83,20 +144,48 @@ Truecase::Truecase(const char *file) {
   StringPiece word;
   std::string lower;
   for (util::FilePiece f(file); f.ReadWordSameLine(word); f.ReadLine()) {
-    const TableEntry &top = Insert(word);
+    // Copy because Insert may move the table.
+    const TableEntry top = Insert(word);
     utf8::ToLower(word, lower);
     if (word != lower) {
-      InsertFollow(lower, top.best, false);
+      InsertFollow(lower, top, false);
     }
     // Discard every other token (these are statistics)
     while (f.ReadWordSameLine(word) && f.ReadWordSameLine(word)) {
       // These secondary casings reference the same best casing.
-      InsertFollow(word, top.best, true);
+      InsertFollow(word, top, true);
     }
   }
+
+  // The builder is done growing, so it's safe to take views.
+  table_ = Table(const_cast<TableEntry*>(builder_->RawBegin()), (builder_->RawEnd() - builder_->RawBegin()) * sizeof(TableEntry));
+  strings_ = built_strings_.data();
+  strings_size_ = built_strings_.size();
 }
 
-void Truecase::Apply(const StringPiece &line, std::string &temp, util::FileStream &out) const {
+void Truecase::LoadBinary(const BinaryHeader &header, int fd, uint64_t size) {
+  UTIL_THROW_IF2(header.entry_size != sizeof(TableEntry), "Binary truecase model was compiled on an incompatible platform.");
+  UTIL_THROW_IF2(sizeof(BinaryHeader) + header.table_bytes + header.strings_bytes != size, "Binary truecase model has size " << size << " but the header implies " << (sizeof(BinaryHeader) + header.table_bytes + header.strings_bytes) << "; is it truncated?");
+  // Shared mapping so concurrent processes use the same page cache.
+  util::MapRead(util::POPULATE_OR_LAZY, fd, 0, size, mapped_);
+  table_ = Table(mapped_.begin() + sizeof(BinaryHeader), header.table_bytes);
+  strings_ = mapped_.begin() + sizeof(BinaryHeader) + header.table_bytes;
+  strings_size_ = header.strings_bytes;
+}
+
+void Truecase::Compile(const char *file) const {
+  BinaryHeader header;
+  memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.entry_size = sizeof(TableEntry);
+  header.table_bytes = (table_.RawEnd() - table_.RawBegin()) * sizeof(TableEntry);
+  header.strings_bytes = strings_size_;
+  util::FileStream out(util::CreateOrThrow(file));
+  out.write(&header, sizeof(BinaryHeader));
+  out.write(table_.RawBegin(), header.table_bytes);
+  out.write(strings_, strings_size_);
+}
+
+template <class Stream> void Truecase::Apply(const StringPiece &line, std::string &temp, Stream &out) const {
   bool sentence_start = true;
   for (util::TokenIter<util::BoolCharacter, true> word(line, util::kSpaces); word;) {
     const TableEntry *entry;
@@ -111,10 +200,15 @@ void Truecase::Apply(const StringPiece &line, std::string &temp, util::FileStrea
         std::cerr << e.what() << "\nSkipping this word.\n";
         continue;
       }
-      const TableEntry *lower;
-      if (table_.Find(Hash(temp), lower)) {
+      // Words that are already lowercase reuse the lookup above.
+      const TableEntry *lower = entry;
+      bool lower_found = entry_found;
+      if (*word != temp) {
+        lower_found = table_.Find(Hash(temp), lower);
+      }
+      if (lower_found) {
         // If there's a best form, print it.
-        out << lower->best;
+        out << Best(*lower);
       } else {
         // Pass unknowns through.
         out << *word;
@@ -134,18 +228,56 @@ void Truecase::Apply(const StringPiece &line, std::string &temp, util::FileStrea
   out << '\n';
 }
 
+// Per-thread state for ParallelLines.
+class TruecaseWorker {
+  public:
+    explicit TruecaseWorker(const Truecase &caser) : caser_(caser) {}
+
+    template <class Stream> void operator()(StringPiece line, Stream &out) {
+      caser_.Apply(line, temp_, out);
+    }
+
+  private:
+    const Truecase &caser_;
+    std::string temp_;
+};
+
+namespace {
+void Usage(const char *name) {
+  std::cerr << "Fast reimplementation of Moses scripts/recaser/truecase.perl except it does not support factors." << std::endl;
+  std::cerr << name << " --model $model [-j threads] <in >out" << std::endl;
+  std::cerr << "To convert a model into a binary image that loads instantly, run" << std::endl;
+  std::cerr << name << " --model $model --compile $binary" << std::endl;
+  std::cerr << "The binary can then be passed as --model.  It is platform-specific." << std::endl;
+}
+} // namespace
+
 int main(int argc, char *argv[]) {
-  if (argc != 3 || (strcmp(argv[1], "--model") && strcmp(argv[1], "-model"))) {
-    std::cerr << "Fast reimplementation of Moses scripts/recaser/truecase.perl except it does not support factors." << std::endl;
-    std::cerr << argv[0] << " --model $model <in >out" << std::endl;
+  const char *model = NULL, *compile = NULL;
+  std::size_t threads = 1;
+  for (int i = 1; i < argc; ++i) {
+    if (i + 1 < argc && (!strcmp(argv[i], "--model") || !strcmp(argv[i], "-model"))) {
+      model = argv[++i];
+    } else if (i + 1 < argc && !strcmp(argv[i], "--compile")) {
+      compile = argv[++i];
+    } else if (i + 1 < argc && (!strcmp(argv[i], "-j") || !strcmp(argv[i], "--jobs"))) {
+      threads = strtoul(argv[++i], NULL, 10);
+    } else {
+      Usage(argv[0]);
+      return 1;
+    }
+  }
+  if (!model) {
+    Usage(argv[0]);
     return 1;
   }
-  Truecase caser(argv[2]);
-  util::FileStream out(1);
-  StringPiece line;
-  std::string temp;
-  for (util::FilePiece f(0); f.ReadLineOrEOF(line);) {
-    caser.Apply(line, temp, out);
+  Truecase caser(model);
+  if (compile) {
+    caser.Compile(compile);
+    return 0;
   }
+  util::FileStream out(1);
+  util::FilePiece in(0);
+  preprocess::ParallelLines(in, out, TruecaseWorker(caser), threads);
   return 0;
 }
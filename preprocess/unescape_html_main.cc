@@ -0,0 +1,42 @@
+#include "html_entities.hh"
+#include "line_parallel.hh"
+
+#include "util/file_piece.hh"
+#include "util/file_stream.hh"
+
+#include <iostream>
+#include <string>
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace {
+
+class Unescaper {
+  public:
+    template <class Stream> void operator()(StringPiece line, Stream &out) {
+      out << preprocess::UnescapeHTML(line, buffer_) << '\n';
+    }
+
+  private:
+    std::string buffer_;
+};
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::size_t threads = 1;
+  if (argc == 3 && (!strcmp(argv[1], "-j") || !strcmp(argv[1], "--jobs"))) {
+    threads = strtoul(argv[2], NULL, 10);
+  } else if (argc != 1) {
+    std::cerr << argv[0] << " [-j threads] <in >out\n"
+      "Decodes HTML entities and turns byte order marks into spaces.  Follows Python's\n"
+      "html.unescape, which differs from unescape_html.perl on &#128; through &#159;." << std::endl;
+    return 1;
+  }
+  util::FilePiece in(0);
+  util::FileStream out(1);
+  // Keep carriage returns so lines without entities are copied through untouched.
+  preprocess::ParallelLines(in, out, Unescaper(), threads, false);
+  return 0;
+}
@@ -1,3 +1,4 @@
+#include "util/concurrent_vocab.hh"
 #include "util/file_piece.hh"
 #include "util/file_stream.hh"
 #include "util/murmur_hash.hh"
@@ -6,6 +7,7 @@
 #include <boost/unordered_set.hpp>
 
 #include <iostream>
+#include <memory>
 
 #include <string.h>
 
@@ -17,7 +19,14 @@ struct Entry {
 };
 
 
-int main() {
+int main(int argc, char *argv[]) {
+  if (argc > 2) {
+    std::cerr << "Usage: " << argv[0] << " [binary_vocab] <text >words\n"
+      "Writes each distinct word of the input once, terminated by a null byte.\n"
+      "If binary_vocab is given, also saves the words and their IDs in order\n"
+      "of appearance as a file that util::MappedVocab memory maps." << std::endl;
+    return 1;
+  }
   bool delimiters[256];
   memset(delimiters, 0, sizeof(delimiters));
   delimiters['\0'] = true;
@@ -34,11 +43,24 @@ int main() {
   util::AutoProbing<Entry, util::IdentityHash>::MutableIterator it;
   Entry entry;
 
+  util::scoped_fd binary;
+  std::unique_ptr<util::ConcurrentVocab> vocab;
+  if (argc == 2) {
+    binary.reset(util::CreateOrThrow(argv[1]));
+    vocab.reset(new util::ConcurrentVocab());
+  }
+
   try { while (true) {
     StringPiece word = in.ReadDelimited(delimiters);
-    entry.SetKey(util::MurmurHashNative(word.data(), word.size()));
-    if (!seen.FindOrInsert(entry, it)) {
-      out << word << '\0';
+    if (vocab) {
+      // The vocabulary grows only for new words, so it doubles as seen.
+      std::size_t before = vocab->Size();
+      vocab->FindOrInsert(word);
+      if (vocab->Size() != before) out << word << '\0';
+    } else {
+      entry.SetKey(util::MurmurHashNative(word.data(), word.size()));
+      if (!seen.FindOrInsert(entry, it)) out << word << '\0';
     }
   } } catch (const util::EndOfFileException &e) {}
+  if (vocab) vocab->Write(binary.get());
 }
@@ -6,10 +6,13 @@
 #include "util/file.hh"
 #include "util/fixed_array.hh"
 #include "util/pcqueue.hh"
+#include "util/splice_writer.hh"
+#include "util/trace.hh"
 
 #include <sys/types.h>
 #include <sys/wait.h>
 
+#include <atomic>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -21,32 +24,54 @@
 namespace preprocess {
 namespace {
 
+#ifdef UTIL_TRACE
+// Records read but not yet written, plotted in traces.
+std::atomic<int64_t> gInFlight(0);
+#endif
+
 // Thread to read from queue and dump to a worker.  Steals process_in.
-void InputToProcess(util::PCQueue<std::string> *queue, int process_in) {
+void InputToProcess(util::PCQueue<std::string> *queue, int process_in, bool splice) {
   // Steal fd for consistency with OutputFromProcess.
   util::scoped_fd fd(process_in);
+  // Records pass through unchanged, so with splice large ones are spliced into the pipe.
+  util::SpliceWriter writer(process_in, splice);
+  UTIL_TRACE_THREAD("to child");
   std::string warc;
   while (true) {
     queue->ConsumeSwap(warc);
     if (warc.empty()) return;
-    util::WriteOrThrow(process_in, warc.data(), warc.size());
+    writer.Write(warc);
   }
 }
 
 // Thread to write from a worker to output.  Steals process_out.
 void OutputFromProcess(bool compress, int process_out, util::FileStream *out, std::mutex *out_mutex) {
   WARCReader reader(process_out);
+  UTIL_TRACE_THREAD("from child");
   std::string str;
   if (compress) {
     std::string compressed;
     while (reader.Read(str)) {
-      util::GZCompress(str, compressed);
-      std::lock_guard<std::mutex> guard(*out_mutex);
+      {
+        UTIL_TRACE_SPAN("gzip");
+        util::GZCompress(str, compressed);
+      }
+      std::unique_lock<std::mutex> guard(*out_mutex, std::defer_lock);
+      {
+        UTIL_TRACE_SPAN("output lock wait");
+        guard.lock();
+      }
+      UTIL_TRACE_COUNTER("records in flight", --gInFlight);
       *out << compressed;
     }
   } else {
     while (reader.Read(str)) {
-      std::lock_guard<std::mutex> guard(*out_mutex);
+      std::unique_lock<std::mutex> guard(*out_mutex, std::defer_lock);
+      {
+        UTIL_TRACE_SPAN("output lock wait");
+        guard.lock();
+      }
+      UTIL_TRACE_COUNTER("records in flight", --gInFlight);
       *out << str;
     }
   }
@@ -55,8 +80,10 @@ void OutputFromProcess(bool compress, int process_out, util::FileStream *out, st
 // Thread to read WARC input from a file.  Steals from.  Does not poison the queue.
 void ReadInput(int from, util::PCQueue<std::string> *queue) {
   preprocess::WARCReader reader(from);
+  UTIL_TRACE_THREAD("input");
   std::string str;
   while (reader.Read(str)) {
+    UTIL_TRACE_COUNTER("records in flight", ++gInFlight);
     queue->ProduceSwap(str);
   }
 }
@@ -64,10 +91,10 @@ void ReadInput(int from, util::PCQueue<std::string> *queue) {
 // A child process going from WARC to WARC.
 class Worker {
   public:
-    Worker(util::PCQueue<std::string> &in, util::FileStream &out, std::mutex &out_mutex, bool compress, char *argv[]) {
+    Worker(util::PCQueue<std::string> &in, util::FileStream &out, std::mutex &out_mutex, bool compress, bool splice, char *argv[]) {
       util::scoped_fd in_file, out_file;
       Launch(argv, in_file, out_file);
-      input_ = std::thread(InputToProcess, &in, in_file.release());
+      input_ = std::thread(InputToProcess, &in, in_file.release(), splice);
       output_ = std::thread(OutputFromProcess, compress, out_file.release(), &out, &out_mutex);
     }
 
@@ -97,9 +124,9 @@ void ChildReaper(std::size_t expect) {
 
 class WorkerPool {
   public:
-    WorkerPool(std::size_t number, util::FileStream &out, bool compress, char *argv[]) : in_(number), workers_(number) {
+    WorkerPool(std::size_t number, util::FileStream &out, bool compress, bool splice, char *argv[]) : in_(number), workers_(number) {
       for (std::size_t i = 0; i < number; ++i) {
-        workers_.push_back(in_, out, out_mutex_, compress, argv);
+        workers_.push_back(in_, out, out_mutex_, compress, splice, argv);
       }
       child_reaper_ = std::thread(ChildReaper, number);
     }
@@ -130,6 +157,7 @@ struct Options {
   std::vector<std::string> inputs;
   std::size_t workers;
   bool compress;
+  bool splice;
 };
 
 void ParseBoostArgs(int restricted_argc, int real_argc, char *argv[], Options &out) {
@@ -139,7 +167,8 @@ void ParseBoostArgs(int restricted_argc, int real_argc, char *argv[], Options &o
     ("help,h", po::bool_switch(), "Show this help message")
     ("inputs,i", po::value(&out.inputs)->multitoken(), "Input files, which will be read in parallel and jumbled together.  Default: read from stdin.")
     ("jobs,j", po::value(&out.workers)->default_value(std::thread::hardware_concurrency()), "Number of child process workers to use.")
-    ("gzip,z", po::bool_switch(&out.compress), "Compress output in gzip format");
+    ("gzip,z", po::bool_switch(&out.compress), "Compress output in gzip format")
+    ("splice", po::bool_switch(&out.splice), "Pass large records to the child with vmsplice instead of copying them.  Only safe if the child reads its input rather than passing it on with splice or tee, which would see records overwritten.");
   po::variables_map vm;
   po::store(po::command_line_parser(restricted_argc, argv).options(desc).run(), vm);
   if (real_argc == 1 || vm["help"].as<bool>()) {
@@ -168,7 +197,7 @@ char **FindChild(int argc, char *argv[]) {
     if (!strcmp(a, "--help") || !strcmp(a, "-h")) {
       // Help, doesn't matter, just make sure command is past that.
       return argv + i + 1;
-    } else if (!strcmp(a, "--gzip") || !strcmp(a, "-z")) {
+    } else if (!strcmp(a, "--gzip") || !strcmp(a, "-z") || !strcmp(a, "--splice")) {
       i += 1;
     } else if (!strcmp(a, "--jobs") || !strcmp(a, "-j")) {
       UTIL_THROW_IF2(i + 1 == argc, "Expected argument to jobs");
@@ -195,7 +224,7 @@ char **FindChild(int argc, char *argv[]) {
 void Run(const Options &options, char *child[]) {
   util::FileStream out(1);
 
-  WorkerPool pool(options.workers, out, options.compress, child);
+  WorkerPool pool(options.workers, out, options.compress, options.splice, child);
 
   util::FixedArray<std::thread> readers(options.inputs.empty() ? 1 : options.inputs.size());
   if (options.inputs.empty()) {
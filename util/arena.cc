@@ -0,0 +1,92 @@
+#include "util/arena.hh"
+
+#include "util/murmur_hash.hh"
+
+#include <algorithm>
+
+namespace util {
+
+ChunkSource::ChunkSource(std::size_t chunk_size) : chunk_size_(chunk_size), next_(0), epoch_(0) {}
+
+void *ChunkSource::Get(std::size_t size, std::size_t &got) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (size > chunk_size_) {
+    large_.emplace_back();
+    HugeMalloc(size, false, large_.back());
+    got = size;
+    return large_.back().get();
+  }
+  if (next_ == chunks_.size()) {
+    chunks_.emplace_back();
+    HugeMalloc(chunk_size_, false, chunks_.back());
+  }
+  got = chunk_size_;
+  return chunks_[next_++].get();
+}
+
+void ChunkSource::Reset() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  next_ = 0;
+  large_.clear();
+  epoch_.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::size_t ChunkSource::MemUsage() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  std::size_t ret = chunks_.size() * chunk_size_;
+  for (std::deque<scoped_memory>::const_iterator i = large_.begin(); i != large_.end(); ++i) {
+    ret += i->size();
+  }
+  return ret;
+}
+
+void *Arena::More(std::size_t size, std::size_t align) {
+  uint64_t epoch = source_->Epoch();
+  if (epoch != epoch_) {
+    // The source was reset, so the current chunk may belong to someone else.
+    epoch_ = epoch;
+    current_ = NULL;
+    end_ = NULL;
+  }
+  std::size_t got;
+  // HugeMalloc may fall back to malloc, which only guarantees kAlign.
+  std::size_t slack = align > kAlign ? align - 1 : 0;
+  if (size + slack > source_->ChunkSize() / 4) {
+    // Big requests get their own memory without wasting the rest of the current chunk.
+    return AlignUp(static_cast<uint8_t*>(source_->Get(size + slack, got)), align);
+  }
+  current_ = static_cast<uint8_t*>(source_->Get(source_->ChunkSize(), got));
+  end_ = current_ + got;
+  uint8_t *ret = AlignUp(current_, align);
+  current_ = ret + size;
+  return ret;
+}
+
+namespace {
+// 0 marks an empty bucket, but it is also the hash of the empty string.
+uint64_t InternKey(const StringPiece &str) {
+  uint64_t key = MurmurHashNative(str.data(), str.size());
+  return key ? key : 1;
+}
+} // namespace
+
+StringPiece StringInterner::Intern(const StringPiece &str) {
+  InternEntry entry;
+  entry.key = InternKey(str);
+  AutoProbing<InternEntry, IdentityHash>::MutableIterator it;
+  if (!table_.FindOrInsert(entry, it)) {
+    StringPiece copied(arena_.Copy(str));
+    it->data = copied.data();
+    it->size = copied.size();
+  }
+  return StringPiece(it->data, it->size);
+}
+
+bool StringInterner::Find(const StringPiece &str, StringPiece &out) const {
+  AutoProbing<InternEntry, IdentityHash>::ConstIterator it;
+  if (!table_.Find(InternKey(str), it)) return false;
+  out = StringPiece(it->data, it->size);
+  return true;
+}
+
+} // namespace util
@@ -0,0 +1,163 @@
+#ifndef UTIL_ARENA_H
+#define UTIL_ARENA_H
+
+/* Bump allocation for multi-threaded stages.  A ChunkSource is shared by all
+ * threads and hands out large chunks; each thread bumps through its chunks with
+ * its own Arena, so allocation takes no lock.  Memory is only freed all at once
+ * by ChunkSource::Reset, e.g. after each batch.
+ */
+
+#include "util/exception.hh"
+#include "util/mmap.hh"
+#include "util/probing_hash_table.hh"
+#include "util/string_piece.hh"
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <mutex>
+
+#include <stdint.h>
+
+namespace util {
+
+class ChunkSource {
+  public:
+    // Matches the huge page size on x86.
+    static const std::size_t kDefaultChunk = 2 << 20;
+
+    explicit ChunkSource(std::size_t chunk_size = kDefaultChunk);
+
+    // Thread safe.  Returns memory for at least size bytes and sets got to
+    // the amount usable, which is larger for small requests.
+    void *Get(std::size_t size, std::size_t &got);
+
+    /* Invalidate everything allocated from this source.  Arenas notice and
+     * start over on their next allocation.  Chunks are kept for reuse, except
+     * oversized ones.  Nothing may allocate concurrently.
+     */
+    void Reset();
+
+    uint64_t Epoch() const { return epoch_.load(std::memory_order_relaxed); }
+
+    std::size_t ChunkSize() const { return chunk_size_; }
+
+    // Bytes held, whether in use or not.
+    std::size_t MemUsage() const;
+
+  private:
+    const std::size_t chunk_size_;
+
+    mutable std::mutex mutex_;
+
+    // Standard size chunks.  Those before next_ are handed out.
+    std::deque<scoped_memory> chunks_;
+    std::size_t next_;
+
+    // Requests larger than chunk_size_, freed on Reset.
+    std::deque<scoped_memory> large_;
+
+    std::atomic<uint64_t> epoch_;
+
+    ChunkSource(const ChunkSource &);
+    ChunkSource &operator=(const ChunkSource &);
+};
+
+/* Per-thread allocator drawing from a ChunkSource.  Copies share the source
+ * but not the current chunk, so a worker holding an Arena can be copied to
+ * each thread.
+ */
+class Arena {
+  public:
+    static const std::size_t kAlign = alignof(std::max_align_t);
+
+    explicit Arena(ChunkSource &source)
+      : source_(&source), epoch_(source.Epoch()), current_(NULL), end_(NULL) {}
+
+    Arena(const Arena &from)
+      : source_(from.source_), epoch_(from.source_->Epoch()), current_(NULL), end_(NULL) {}
+
+    Arena &operator=(const Arena &from) {
+      source_ = from.source_;
+      epoch_ = source_->Epoch();
+      current_ = NULL;
+      end_ = NULL;
+      return *this;
+    }
+
+    // align must be a power of 2.  Any alignment is honored, but those above
+    // kAlign waste up to align - 1 bytes when a new chunk is started.
+    void *Allocate(std::size_t size, std::size_t align = kAlign) {
+      // A fresh or reset arena has no chunk to do arithmetic on.
+      if (UTIL_UNLIKELY(!current_)) return More(size, align);
+      uint8_t *ret = AlignUp(current_, align);
+      if (UTIL_UNLIKELY(ret + size > end_ || epoch_ != source_->Epoch())) {
+        return More(size, align);
+      }
+      current_ = ret + size;
+      return ret;
+    }
+
+    // Copy a string into the arena.
+    StringPiece Copy(const StringPiece &str) {
+      char *to = static_cast<char*>(Allocate(str.size(), 1));
+      std::memcpy(to, str.data(), str.size());
+      return StringPiece(to, str.size());
+    }
+
+    ChunkSource &Source() { return *source_; }
+
+  private:
+    static uint8_t *AlignUp(uint8_t *ptr, std::size_t align) {
+      return reinterpret_cast<uint8_t*>((reinterpret_cast<uintptr_t>(ptr) + align - 1) & ~static_cast<uintptr_t>(align - 1));
+    }
+
+    void *More(std::size_t size, std::size_t align);
+
+    ChunkSource *source_;
+    uint64_t epoch_;
+    uint8_t *current_, *end_;
+};
+
+#pragma pack(push)
+#pragma pack(4)
+struct InternEntry {
+  typedef uint64_t Key;
+  uint64_t GetKey() const { return key; }
+  void SetKey(uint64_t to) { key = to; }
+
+  uint64_t key;
+  const char *data;
+  uint32_t size;
+};
+#pragma pack(pop)
+
+/* Keeps one copy of each distinct string in an Arena.  As with MutableVocab,
+ * strings are identified by their 64-bit hash.  Not thread safe: give each
+ * thread its own interner, possibly sharing a ChunkSource.  Call Clear when
+ * the source is Reset.
+ */
+class StringInterner {
+  public:
+    explicit StringInterner(ChunkSource &source) : arena_(source) {}
+
+    // The returned memory lives until the ChunkSource is Reset.
+    StringPiece Intern(const StringPiece &str);
+
+    // Lookup without inserting.  Returns false if absent.
+    bool Find(const StringPiece &str, StringPiece &out) const;
+
+    std::size_t Size() const { return table_.Size(); }
+
+    void Clear() { table_.Clear(); }
+
+  private:
+    Arena arena_;
+
+    AutoProbing<InternEntry, IdentityHash> table_;
+};
+
+} // namespace util
+
+#endif // UTIL_ARENA_H
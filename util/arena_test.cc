@@ -0,0 +1,108 @@
+#define BOOST_TEST_MODULE ArenaTest
+
+#include "util/arena.hh"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <stdint.h>
+
+namespace util { namespace {
+
+BOOST_AUTO_TEST_CASE(Alignment) {
+  ChunkSource source(4096);
+  Arena arena(source);
+  for (std::size_t i = 1; i < 1000; ++i) {
+    arena.Allocate(i % 7, 1);
+    void *aligned = arena.Allocate(8);
+    BOOST_CHECK_EQUAL(0U, reinterpret_cast<uintptr_t>(aligned) % Arena::kAlign);
+  }
+  // Bigger than a chunk.
+  char *big = static_cast<char*>(arena.Allocate(10000));
+  memset(big, 1, 10000);
+}
+
+BOOST_AUTO_TEST_CASE(LargeAlignment) {
+  ChunkSource source(4096);
+  Arena arena(source);
+  for (std::size_t align = Arena::kAlign; align <= 16384; align *= 2) {
+    arena.Allocate(1, 1);
+    void *small = arena.Allocate(8, align);
+    BOOST_CHECK_EQUAL(0U, reinterpret_cast<uintptr_t>(small) % align);
+    // Bypasses the chunk.
+    char *big = static_cast<char*>(arena.Allocate(5000, align));
+    BOOST_CHECK_EQUAL(0U, reinterpret_cast<uintptr_t>(big) % align);
+    memset(big, 1, 5000);
+  }
+}
+
+void Fill(Arena arena, unsigned thread, std::vector<StringPiece> *out) {
+  for (unsigned i = 0; i < 10000; ++i) {
+    out->push_back(arena.Copy(std::to_string(thread) + " " + std::to_string(i)));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Threads) {
+  ChunkSource source(1 << 16);
+  Arena arena(source);
+  std::vector<StringPiece> strings[4];
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < 4; ++t) {
+    threads.push_back(std::thread(Fill, arena, t, &strings[t]));
+  }
+  for (std::thread &t : threads) t.join();
+  for (unsigned t = 0; t < 4; ++t) {
+    BOOST_REQUIRE_EQUAL(10000U, strings[t].size());
+    for (unsigned i = 0; i < 10000; ++i) {
+      BOOST_REQUIRE_EQUAL(std::to_string(t) + " " + std::to_string(i), strings[t][i]);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Reset) {
+  ChunkSource source(4096);
+  Arena arena(source);
+  void *first = arena.Allocate(100);
+  for (unsigned i = 0; i < 100; ++i) arena.Allocate(100);
+  std::size_t usage = source.MemUsage();
+  source.Reset();
+  // Starts again at the first chunk.
+  BOOST_CHECK_EQUAL(first, arena.Allocate(100));
+  for (unsigned i = 0; i < 100; ++i) arena.Allocate(100);
+  BOOST_CHECK_EQUAL(usage, source.MemUsage());
+}
+
+BOOST_AUTO_TEST_CASE(Interner) {
+  ChunkSource source;
+  StringInterner interner(source);
+  std::string foo("foo");
+  StringPiece first(interner.Intern(foo));
+  foo[0] = 'g';
+  BOOST_CHECK_EQUAL("foo", first);
+  BOOST_CHECK_EQUAL(first.data(), interner.Intern("foo").data());
+  BOOST_CHECK(first.data() != interner.Intern(foo).data());
+  BOOST_CHECK_EQUAL(2U, interner.Size());
+  StringPiece found;
+  BOOST_CHECK(interner.Find("goo", found));
+  BOOST_CHECK_EQUAL("goo", found);
+  BOOST_CHECK(!interner.Find("bar", found));
+  // The empty string hashes to the empty bucket marker.
+  BOOST_CHECK(!interner.Find("", found));
+  BOOST_CHECK_EQUAL("", interner.Intern(""));
+  BOOST_CHECK_EQUAL(3U, interner.Size());
+  BOOST_CHECK(interner.Find("", found));
+  BOOST_CHECK_EQUAL("", found);
+  BOOST_CHECK_EQUAL(3U, interner.Size());
+}
+
+BOOST_AUTO_TEST_CASE(FreshEmpty) {
+  ChunkSource source(4096);
+  Arena arena(source);
+  // Nothing to allocate from yet, but the result is still usable memory.
+  BOOST_CHECK(arena.Allocate(0, 1));
+}
+
+}} // namespaces
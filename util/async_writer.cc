@@ -0,0 +1,63 @@
+#include "util/async_writer.hh"
+
+#include "util/file.hh"
+#include "util/trace.hh"
+
+#include <algorithm>
+
+namespace util {
+
+namespace detail {
+void PendingWrite::WaitIdle() {
+  WaitSemaphore(idle_);
+  if (error_) {
+    std::exception_ptr error;
+    std::swap(error, error_);
+    idle_.post();
+    std::rethrow_exception(error);
+  }
+}
+} // namespace detail
+
+AsyncWriter::AsyncWriter(std::size_t threads) : queue_(std::max<std::size_t>(threads, 1) * 4) {
+  threads = std::max<std::size_t>(threads, 1);
+  for (std::size_t i = 0; i < threads; ++i) {
+    threads_.push_back(std::thread(&AsyncWriter::Run, this));
+  }
+}
+
+AsyncWriter::~AsyncWriter() {
+  Job poison;
+  poison.pending = NULL;
+  for (std::size_t i = 0; i < threads_.size(); ++i) {
+    queue_.Produce(poison);
+  }
+  for (std::vector<std::thread>::iterator i = threads_.begin(); i != threads_.end(); ++i) {
+    i->join();
+  }
+}
+
+void AsyncWriter::Submit(int fd, const void *data, std::size_t size, detail::PendingWrite &pending) {
+  Job job;
+  job.fd = fd;
+  job.data = data;
+  job.size = size;
+  job.pending = &pending;
+  queue_.Produce(job);
+}
+
+void AsyncWriter::Run() {
+  UTIL_TRACE_THREAD("AsyncWriter");
+  Job job;
+  while (queue_.Consume(job).pending) {
+    try {
+      WriteOrThrow(job.fd, job.data, job.size);
+    } catch (...) {
+      // Reported to the stream on its next write or flush.
+      job.pending->error_ = std::current_exception();
+    }
+    job.pending->MarkIdle();
+  }
+}
+
+} // namespace util
@@ -0,0 +1,65 @@
+#ifndef UTIL_ASYNC_WRITER_H
+#define UTIL_ASYNC_WRITER_H
+
+#include "util/pcqueue.hh"
+
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace util {
+
+class AsyncWriter;
+
+namespace detail {
+// Tracks the one write a FileStream may have in flight.
+class PendingWrite {
+  public:
+    PendingWrite() : idle_(1) {}
+
+    // Block until the previous write finished, rethrowing any error from it.
+    // Call MarkIdle after if not following up with AsyncWriter::Submit.
+    void WaitIdle();
+
+    void MarkIdle() { idle_.post(); }
+
+  private:
+    friend class util::AsyncWriter;
+
+    Semaphore idle_;
+    std::exception_ptr error_;
+};
+} // namespace detail
+
+/* Threads that write buffers for FileStreams so the producer can fill the next
+ * buffer in the meantime.  One AsyncWriter can serve many streams, e.g. every
+ * output of shard.  Streams must be destroyed before the AsyncWriter.
+ */
+class AsyncWriter {
+  public:
+    explicit AsyncWriter(std::size_t threads = 1);
+
+    ~AsyncWriter();
+
+    // Write data to fd then mark pending idle.  Call pending.WaitIdle() first.
+    void Submit(int fd, const void *data, std::size_t size, detail::PendingWrite &pending);
+
+  private:
+    struct Job {
+      int fd;
+      const void *data;
+      std::size_t size;
+      // NULL is poison.
+      detail::PendingWrite *pending;
+    };
+
+    void Run();
+
+    PCQueue<Job> queue_;
+    std::vector<std::thread> threads_;
+};
+
+} // namespace util
+
+#endif // UTIL_ASYNC_WRITER_H
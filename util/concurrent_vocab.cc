@@ -0,0 +1,189 @@
+#include "util/concurrent_vocab.hh"
+
+#include "util/exception.hh"
+#include "util/file.hh"
+#include "util/file_stream.hh"
+#include "util/murmur_hash.hh"
+#include "util/trace.hh"
+
+#include <cstring>
+
+namespace util {
+
+namespace {
+const char kMagic[8] = {'v', 'o', 'c', 'a', 'b', 'v', '1', '\n'};
+
+struct Header {
+  char magic[8];
+  uint64_t size;
+  uint64_t buckets;
+};
+
+const std::size_t kInitialBuckets = 64;
+
+uint64_t Key(const StringPiece &str) {
+  uint64_t key = MurmurHashNative(str.data(), str.size());
+  // 0 marks an empty slot.
+  return key ? key : 1;
+}
+} // namespace
+
+const ConcurrentVocab::ID ConcurrentVocab::kUNK;
+const MappedVocab::ID MappedVocab::kUNK;
+
+ConcurrentVocab::Table::Table(std::size_t buckets) : mask(buckets - 1), slots(buckets) {}
+
+ConcurrentVocab::Shard::Shard(ChunkSource &source)
+  : table(new Table(kInitialBuckets)), size(0), arena(source) {}
+
+ConcurrentVocab::ConcurrentVocab() : shards_(kShards), next_id_(0) {
+  for (std::size_t i = 0; i < kShards; ++i) {
+    shards_.push_back(source_);
+  }
+  for (unsigned i = 0; i < kSegments; ++i) {
+    segments_[i].store(NULL, std::memory_order_relaxed);
+  }
+  SetString(kUNK, StringPiece("<unk>"));
+  next_id_.store(1, std::memory_order_release);
+}
+
+ConcurrentVocab::~ConcurrentVocab() {
+  for (Shard &shard : shards_) {
+    delete shard.table.load(std::memory_order_relaxed);
+    for (std::vector<Table*>::iterator i = shard.retired.begin(); i != shard.retired.end(); ++i) {
+      delete *i;
+    }
+  }
+  for (unsigned i = 0; i < kSegments; ++i) {
+    delete [] segments_[i].load(std::memory_order_relaxed);
+  }
+}
+
+ConcurrentVocab::ID ConcurrentVocab::FindIn(const Table &table, uint64_t key) {
+  for (std::size_t i = key & table.mask;; i = (i + 1) & table.mask) {
+    uint64_t got = table.slots[i].key.load(std::memory_order_acquire);
+    if (got == key) return table.slots[i].id.load(std::memory_order_relaxed);
+    if (!got) return kUNK;
+  }
+}
+
+ConcurrentVocab::ID ConcurrentVocab::Find(const StringPiece &str) const {
+  uint64_t key = Key(str);
+  const Shard &shard = shards_[key >> (64 - kShardBits)];
+  return FindIn(*shard.table.load(std::memory_order_acquire), key);
+}
+
+ConcurrentVocab::ID ConcurrentVocab::FindOrInsert(const StringPiece &str) {
+  uint64_t key = Key(str);
+  Shard &shard = shards_[key >> (64 - kShardBits)];
+  ID found = FindIn(*shard.table.load(std::memory_order_acquire), key);
+  if (found != kUNK) return found;
+
+  std::lock_guard<std::mutex> guard(shard.mutex);
+  Table *table = shard.table.load(std::memory_order_relaxed);
+  // Another thread may have inserted it since.
+  std::size_t i = key & table->mask;
+  for (;; i = (i + 1) & table->mask) {
+    uint64_t got = table->slots[i].key.load(std::memory_order_relaxed);
+    if (got == key) return table->slots[i].id.load(std::memory_order_relaxed);
+    if (!got) break;
+  }
+  ID id = next_id_.fetch_add(1, std::memory_order_relaxed);
+  UTIL_THROW_IF2(id == static_cast<ID>(-1), "Vocabulary overflowed " << id << " entries");
+  SetString(id, shard.arena.Copy(str));
+  table->slots[i].id.store(id, std::memory_order_relaxed);
+  table->slots[i].key.store(key, std::memory_order_release);
+
+  if (++shard.size * 2 > table->slots.size()) {
+    UTIL_TRACE_SPAN("ConcurrentVocab grow");
+    // Readers may still be probing the old table, so keep it.
+    Table *larger = new Table(table->slots.size() * 2);
+    for (const Slot &slot : table->slots) {
+      uint64_t k = slot.key.load(std::memory_order_relaxed);
+      if (!k) continue;
+      std::size_t j = k & larger->mask;
+      while (larger->slots[j].key.load(std::memory_order_relaxed)) j = (j + 1) & larger->mask;
+      larger->slots[j].id.store(slot.id.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      larger->slots[j].key.store(k, std::memory_order_relaxed);
+    }
+    shard.table.store(larger, std::memory_order_release);
+    shard.retired.push_back(table);
+  }
+  return id;
+}
+
+void ConcurrentVocab::SetString(ID id, StringPiece str) {
+  std::size_t index = static_cast<std::size_t>(id) + kFirstSegment;
+  unsigned segment = Log2(index) - kFirstSegmentBits;
+  StringPiece *strings = segments_[segment].load(std::memory_order_acquire);
+  if (!strings) {
+    // Threads inserting into different shards can race to allocate.
+    StringPiece *allocated = new StringPiece[static_cast<std::size_t>(1) << (segment + kFirstSegmentBits)];
+    if (segments_[segment].compare_exchange_strong(strings, allocated, std::memory_order_acq_rel)) {
+      strings = allocated;
+    } else {
+      delete [] allocated;
+    }
+  }
+  strings[index - (static_cast<std::size_t>(1) << (segment + kFirstSegmentBits))] = str;
+}
+
+void ConcurrentVocab::Write(int fd) const {
+  const std::size_t size = Size();
+  Header header;
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.size = size;
+  header.buckets = 1;
+  while (header.buckets < size * 2) header.buckets *= 2;
+  const uint64_t mask = header.buckets - 1;
+
+  std::vector<uint64_t> buckets(header.buckets * 2, 0);
+  std::vector<uint64_t> offsets;
+  offsets.reserve(size + 1);
+  offsets.push_back(0);
+  for (std::size_t id = 0; id < size; ++id) {
+    StringPiece str(String(id));
+    offsets.push_back(offsets.back() + str.size());
+    if (id == kUNK) continue;
+    uint64_t key = Key(str);
+    std::size_t i = key & mask;
+    while (buckets[i * 2]) i = (i + 1) & mask;
+    buckets[i * 2] = key;
+    buckets[i * 2 + 1] = id;
+  }
+  WriteOrThrow(fd, &header, sizeof(Header));
+  WriteOrThrow(fd, &buckets[0], buckets.size() * sizeof(uint64_t));
+  WriteOrThrow(fd, &offsets[0], offsets.size() * sizeof(uint64_t));
+  // Strings are short, so buffer them rather than making a syscall each.
+  FileStream out(fd, 1 << 20);
+  for (std::size_t id = 0; id < size; ++id) {
+    StringPiece str(String(id));
+    out.write(str.data(), str.size());
+  }
+  out.flush();
+}
+
+MappedVocab::MappedVocab(int fd) {
+  scoped_fd file(fd);
+  uint64_t file_size = SizeOrThrow(file.get());
+  UTIL_THROW_IF2(file_size < sizeof(Header), "Vocabulary file is too small to be a vocabulary");
+  MapRead(LAZY, file.get(), 0, file_size, memory_);
+  const Header *header = static_cast<const Header*>(memory_.get());
+  UTIL_THROW_IF2(std::memcmp(header->magic, kMagic, sizeof(kMagic)), "Not a binary vocabulary file");
+  size_ = header->size;
+  mask_ = header->buckets - 1;
+  buckets_ = reinterpret_cast<const Bucket*>(header + 1);
+  offsets_ = reinterpret_cast<const uint64_t*>(buckets_ + header->buckets);
+  strings_ = reinterpret_cast<const char*>(offsets_ + size_ + 1);
+  UTIL_THROW_IF2(strings_ > static_cast<const char*>(memory_.get()) + file_size || offsets_[size_] != static_cast<uint64_t>(static_cast<const char*>(memory_.get()) + file_size - strings_), "Vocabulary file is truncated");
+}
+
+MappedVocab::ID MappedVocab::Find(const StringPiece &str) const {
+  uint64_t key = Key(str);
+  for (uint64_t i = key & mask_;; i = (i + 1) & mask_) {
+    if (buckets_[i].key == key) return buckets_[i].id;
+    if (!buckets_[i].key) return kUNK;
+  }
+}
+
+} // namespace util
@@ -0,0 +1,143 @@
+#ifndef UTIL_CONCURRENT_VOCAB_H
+#define UTIL_CONCURRENT_VOCAB_H
+
+/* Vocabularies mapping strings to dense IDs.  ConcurrentVocab can be built by
+ * many threads at once; Write saves it in a format MappedVocab memory maps, so
+ * tools that only look words up can load it instantly.  As with MutableVocab,
+ * strings are identified by their 64-bit hash and ID 0 is <unk>.
+ */
+
+#include "util/arena.hh"
+#include "util/fixed_array.hh"
+#include "util/mmap.hh"
+#include "util/string_piece.hh"
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include <stdint.h>
+
+namespace util {
+
+class ConcurrentVocab {
+  public:
+    typedef uint32_t ID;
+
+    static const ID kUNK = 0;
+
+    ConcurrentVocab();
+
+    ~ConcurrentVocab();
+
+    // Lock free.  Returns kUNK if absent.
+    ID Find(const StringPiece &str) const;
+
+    // Thread safe.  Lookups of words already present are lock free; inserts
+    // lock one of kShards stripes.
+    ID FindOrInsert(const StringPiece &str);
+
+    /* Lock free.  id must have come from this vocab and, if it was inserted by
+     * another thread, been passed on with the usual synchronization (e.g. a
+     * queue).
+     */
+    StringPiece String(ID id) const {
+      std::size_t index = static_cast<std::size_t>(id) + kFirstSegment;
+      unsigned segment = Log2(index) - kFirstSegmentBits;
+      return segments_[segment].load(std::memory_order_relaxed)[index - (static_cast<std::size_t>(1) << (segment + kFirstSegmentBits))];
+    }
+
+    // Includes kUNK.
+    std::size_t Size() const { return next_id_.load(std::memory_order_acquire); }
+
+    // Write in the format MappedVocab reads.  No inserts may run concurrently.
+    void Write(int fd) const;
+
+  private:
+    struct Slot {
+      // 0 is empty.  Stored after id, with release.
+      std::atomic<uint64_t> key;
+      std::atomic<ID> id;
+    };
+
+    struct Table {
+      explicit Table(std::size_t buckets);
+      std::size_t mask;
+      std::vector<Slot> slots;
+    };
+
+    struct Shard {
+      explicit Shard(ChunkSource &source);
+      std::atomic<Table*> table;
+      // Entries in table.
+      std::size_t size;
+      std::mutex mutex;
+      Arena arena;
+      // Outgrown tables, kept for concurrent readers.
+      std::vector<Table*> retired;
+    };
+
+    static const unsigned kShardBits = 6;
+    static const std::size_t kShards = 1 << kShardBits;
+
+    // String storage grows in segments of 2^(kFirstSegmentBits + i).
+    static const unsigned kFirstSegmentBits = 10;
+    static const std::size_t kFirstSegment = 1 << kFirstSegmentBits;
+    static const unsigned kSegments = 64 - kFirstSegmentBits;
+
+    static unsigned Log2(uint64_t value) { return 63 - __builtin_clzll(value); }
+
+    static ID FindIn(const Table &table, uint64_t key);
+
+    void SetString(ID id, StringPiece str);
+
+    ChunkSource source_;
+
+    FixedArray<Shard> shards_;
+
+    std::atomic<ID> next_id_;
+
+    std::atomic<StringPiece*> segments_[kSegments];
+
+    ConcurrentVocab(const ConcurrentVocab &);
+    ConcurrentVocab &operator=(const ConcurrentVocab &);
+};
+
+// Read-only vocabulary memory mapped from ConcurrentVocab::Write.
+class MappedVocab {
+  public:
+    typedef uint32_t ID;
+
+    static const ID kUNK = 0;
+
+    // Takes ownership of fd.
+    explicit MappedVocab(int fd);
+
+    ID Find(const StringPiece &str) const;
+
+    StringPiece String(ID id) const {
+      return StringPiece(strings_ + offsets_[id], offsets_[id + 1] - offsets_[id]);
+    }
+
+    std::size_t Size() const { return size_; }
+
+  private:
+    scoped_memory memory_;
+
+    std::size_t size_;
+
+    struct Bucket {
+      uint64_t key;
+      uint64_t id;
+    };
+    const Bucket *buckets_;
+    uint64_t mask_;
+
+    const uint64_t *offsets_;
+    const char *strings_;
+};
+
+} // namespace util
+
+#endif // UTIL_CONCURRENT_VOCAB_H
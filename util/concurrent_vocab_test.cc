@@ -0,0 +1,75 @@
+#define BOOST_TEST_MODULE ConcurrentVocabTest
+
+#include "util/concurrent_vocab.hh"
+#include "util/file.hh"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace util { namespace {
+
+BOOST_AUTO_TEST_CASE(Small) {
+  ConcurrentVocab vocab;
+  BOOST_CHECK_EQUAL(ConcurrentVocab::kUNK, vocab.Find("Foo"));
+  BOOST_CHECK_EQUAL(1U, vocab.FindOrInsert("Foo"));
+  BOOST_CHECK_EQUAL(2U, vocab.Size());
+  BOOST_CHECK_EQUAL(1U, vocab.Find("Foo"));
+  BOOST_CHECK_EQUAL(1U, vocab.FindOrInsert("Foo"));
+  BOOST_CHECK_EQUAL("Foo", vocab.String(1));
+  BOOST_CHECK_EQUAL("<unk>", vocab.String(ConcurrentVocab::kUNK));
+}
+
+void Insert(ConcurrentVocab *vocab, unsigned offset, std::vector<ConcurrentVocab::ID> *ids) {
+  // Threads overlap in the words they insert.
+  for (unsigned i = 0; i < 50000; ++i) {
+    ids->push_back(vocab->FindOrInsert(std::to_string((i * 7 + offset) % 60000)));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Threads) {
+  ConcurrentVocab vocab;
+  std::vector<ConcurrentVocab::ID> ids[4];
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < 4; ++t) {
+    threads.push_back(std::thread(Insert, &vocab, t * 10000, &ids[t]));
+  }
+  for (std::thread &t : threads) t.join();
+  // Every word got exactly one dense ID.
+  BOOST_CHECK_EQUAL(60001U, vocab.Size());
+  std::vector<bool> seen(vocab.Size());
+  for (unsigned t = 0; t < 4; ++t) {
+    for (unsigned i = 0; i < ids[t].size(); ++i) {
+      std::string word(std::to_string((i * 7 + t * 10000) % 60000));
+      BOOST_REQUIRE_EQUAL(word, vocab.String(ids[t][i]));
+      BOOST_REQUIRE_EQUAL(ids[t][i], vocab.Find(word));
+      seen[ids[t][i]] = true;
+    }
+  }
+  for (std::size_t i = 1; i < seen.size(); ++i) {
+    BOOST_REQUIRE(seen[i]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(WriteMap) {
+  scoped_fd file(MakeTemp("concurrent_vocab_test"));
+  ConcurrentVocab vocab;
+  for (unsigned i = 0; i < 1000; ++i) {
+    vocab.FindOrInsert(std::to_string(i * 13));
+  }
+  vocab.FindOrInsert("");
+  vocab.Write(file.get());
+  MappedVocab mapped(file.release());
+  BOOST_REQUIRE_EQUAL(vocab.Size(), mapped.Size());
+  for (ConcurrentVocab::ID i = 0; i < vocab.Size(); ++i) {
+    BOOST_CHECK_EQUAL(vocab.String(i), mapped.String(i));
+    if (i != ConcurrentVocab::kUNK) {
+      BOOST_CHECK_EQUAL(i, mapped.Find(vocab.String(i)));
+    }
+  }
+  BOOST_CHECK_EQUAL(MappedVocab::kUNK, mapped.Find("14"));
+}
+
+}} // namespaces
@@ -1,24 +1,38 @@
 #include "util/ersatz_progress.hh"
 
 #include <algorithm>
+#include <iomanip>
 #include <ostream>
 #include <limits>
+#include <sstream>
 #include <string>
 
 namespace util {
 
-namespace { const unsigned char kWidth = 100; }
+namespace {
+const unsigned char kWidth = 100;
+
+// Print bytes with a binary prefix and one decimal place.
+void PrintBytes(std::ostream &out, double bytes) {
+  const char *const kUnits[] = {"B", "KiB", "MiB", "GiB", "TiB", "PiB"};
+  std::size_t unit = 0;
+  for (; bytes >= 1024.0 && unit + 1 < sizeof(kUnits) / sizeof(const char*); ++unit) {
+    bytes /= 1024.0;
+  }
+  out << bytes << ' ' << kUnits[unit];
+}
+} // namespace
 
 const char kProgressBanner[] = "----5---10---15---20---25---30---35---40---45---50---55---60---65---70---75---80---85---90---95--100\n";
 
-ErsatzProgress::ErsatzProgress() : current_(0), next_(std::numeric_limits<uint64_t>::max()), complete_(next_), out_(NULL) {}
+ErsatzProgress::ErsatzProgress() : current_(0), next_(std::numeric_limits<uint64_t>::max()), complete_(next_), out_(NULL), bytes_(false), drawn_(0) {}
 
 ErsatzProgress::~ErsatzProgress() {
   if (out_) Finished();
 }
 
-ErsatzProgress::ErsatzProgress(uint64_t complete, std::ostream *to, const std::string &message)
-  : current_(0), next_(complete / kWidth), complete_(complete), stones_written_(0), out_(to) {
+ErsatzProgress::ErsatzProgress(uint64_t complete, std::ostream *to, const std::string &message, bool bytes)
+  : current_(0), next_(complete / kWidth), complete_(complete), stones_written_(0), out_(to), bytes_(bytes), start_(std::chrono::steady_clock::now()), drawn_(0) {
   if (!out_) {
     next_ = std::numeric_limits<uint64_t>::max();
     return;
@@ -32,8 +46,15 @@ void ErsatzProgress::Milestone() {
   if (!complete_) return;
   unsigned char stone = std::min(static_cast<uint64_t>(kWidth), (current_ * kWidth) / complete_);
 
-  for (; stones_written_ < stone; ++stones_written_) {
-    (*out_) << '*';
+  if (bytes_) {
+    if (stone > stones_written_ || stone == kWidth) {
+      stones_written_ = stone;
+      DrawBytes(stone == kWidth);
+    }
+  } else {
+    for (; stones_written_ < stone; ++stones_written_) {
+      (*out_) << '*';
+    }
   }
   if (stone == kWidth) {
     (*out_) << std::endl;
@@ -44,4 +65,25 @@ void ErsatzProgress::Milestone() {
   }
 }
 
+void ErsatzProgress::DrawBytes(bool finished) {
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+  std::ostringstream text;
+  text << std::fixed << std::setprecision(1);
+  if (finished) {
+    PrintBytes(text, static_cast<double>(complete_));
+    text << " in " << std::setprecision(2) << seconds << std::setprecision(1) << " s";
+    if (seconds > 0.0) text << " = ";
+  }
+  if (seconds > 0.0) {
+    PrintBytes(text, static_cast<double>(current_) / seconds);
+    text << "/s";
+  }
+  std::string rate(text.str());
+  std::size_t width = stones_written_ + 1 + rate.size();
+  (*out_) << '\r' << std::string(stones_written_, '*') << ' ' << rate;
+  if (width < drawn_) (*out_) << std::string(drawn_ - width, ' ');
+  drawn_ = width;
+  out_->flush();
+}
+
 } // namespace util
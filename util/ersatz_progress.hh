@@ -1,6 +1,7 @@
 #ifndef UTIL_ERSATZ_PROGRESS_H
 #define UTIL_ERSATZ_PROGRESS_H
 
+#include <chrono>
 #include <iostream>
 #include <string>
 #include <stdint.h>
@@ -18,10 +19,13 @@ class ErsatzProgress {
     ErsatzProgress();
 
     // Null means no output.  The null value is useful for passing along the ostream pointer from another caller.
-    explicit ErsatzProgress(uint64_t complete, std::ostream *to = &std::cerr, const std::string &message = "");
+    // If bytes is set, the rate so far is shown after the bar, which is
+    // redrawn with a carriage return at each milestone, and the amount and
+    // overall rate are shown on completion.
+    explicit ErsatzProgress(uint64_t complete, std::ostream *to = &std::cerr, const std::string &message = "", bool bytes = false);
 
 #if __cplusplus >= 201103L
-    ErsatzProgress(ErsatzProgress &&from) noexcept : current_(from.current_), next_(from.next_), complete_(from.complete_), stones_written_(from.stones_written_), out_(from.out_) {
+    ErsatzProgress(ErsatzProgress &&from) noexcept : current_(from.current_), next_(from.next_), complete_(from.complete_), stones_written_(from.stones_written_), out_(from.out_), bytes_(from.bytes_), start_(from.start_), drawn_(from.drawn_) {
       from.out_ = nullptr;
       from.next_ = (uint64_t)-1;
     }
@@ -50,10 +54,18 @@ class ErsatzProgress {
   private:
     void Milestone();
 
+    // Redraw the bar with the byte rate after it.
+    void DrawBytes(bool finished);
+
     uint64_t current_, next_, complete_;
     unsigned char stones_written_;
     std::ostream *out_;
 
+    bool bytes_;
+    std::chrono::steady_clock::time_point start_;
+    // Width of the last line DrawBytes wrote, to blank out leftovers.
+    std::size_t drawn_;
+
     // noncopyable
     ErsatzProgress(const ErsatzProgress &other);
     ErsatzProgress &operator=(const ErsatzProgress &other);
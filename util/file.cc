@@ -4,6 +4,7 @@
 #include "util/file.hh"
 
 #include "util/exception.hh"
+#include "util/trace.hh"
 
 #include <algorithm>
 #include <cstdlib>
@@ -162,6 +163,7 @@ const std::size_t kMaxDWORD = static_cast<std::size_t>(4294967295UL);
 #endif
 
 std::size_t PartialRead(int fd, void *to, std::size_t amount) {
+  UTIL_TRACE_SPAN("read");
 #if defined(_WIN32) || defined(_WIN64)
     DWORD ret;
     HANDLE file_handle = reinterpret_cast<HANDLE>(_get_osfhandle(fd));
@@ -208,6 +210,7 @@ std::size_t ReadOrEOF(int fd, void *to_void, std::size_t amount) {
 }
 
 void WriteOrThrow(int fd, const void *data_void, std::size_t size) {
+  UTIL_TRACE_SPAN("write");
   const uint8_t *data = static_cast<const uint8_t*>(data_void);
   while (size) {
 #if defined(_WIN32) || defined(_WIN64)
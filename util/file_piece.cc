@@ -4,6 +4,8 @@
 #include "util/exception.hh"
 #include "util/file.hh"
 #include "util/mmap.hh"
+#include "util/string_to_integer.hh"
+#include "util/trace.hh"
 
 #if defined(_WIN32) || defined(_WIN64)
 #include <io.h>
@@ -30,7 +32,17 @@
 
 namespace util {
 
-namespace { const uint64_t kPageSize = SizePage(); }
+namespace {
+const uint64_t kPageSize = SizePage();
+
+// Sequential scans double the mmap window up to this.
+const std::size_t kMaxMapWindow = 64 << 20;
+// When no more than this remains, map it all at once and prefault.
+const uint64_t kPopulateLimit = 16 << 20;
+// Files at least this big drop pages behind the reader from the page cache,
+// so a long scan does not evict everything else.
+const uint64_t kDropBehindSize = 1ULL << 30;
+} // namespace
 
 ParseNumberException::ParseNumberException(StringPiece value) throw() {
   *this << "Could not parse \"" << value << "\" into a ";
@@ -44,7 +56,7 @@ LineIterator &LineIterator::operator++() {
 
 FilePiece::FilePiece(const char *name, std::ostream *show_progress, std::size_t min_buffer) :
   file_(OpenReadOrThrow(name)), total_size_(SizeFile(file_.get())),
-  progress_(total_size_, total_size_ == kBadSize ? NULL : show_progress, std::string("Reading ") + name) {
+  progress_(total_size_, total_size_ == kBadSize ? NULL : show_progress, std::string("Reading ") + name, true) {
   Initialize(name, show_progress, min_buffer);
 }
 
@@ -57,7 +69,7 @@ std::string NamePossiblyFind(int fd, const char *name) {
 
 FilePiece::FilePiece(int fd, const char *name, std::ostream *show_progress, std::size_t min_buffer) :
   file_(fd), total_size_(SizeFile(file_.get())),
-  progress_(total_size_, total_size_ == kBadSize ? NULL : show_progress, std::string("Reading ") + NamePossiblyFind(fd, name)) {
+  progress_(total_size_, total_size_ == kBadSize ? NULL : show_progress, std::string("Reading ") + NamePossiblyFind(fd, name), true) {
   Initialize(NamePossiblyFind(fd, name).c_str(), show_progress, min_buffer);
 }
 
@@ -199,6 +211,18 @@ const char *ParseNumber(StringPiece str, double &out) {
   return str.data() + count;
 }
 const char *ParseNumber(StringPiece str, long int &out) {
+  // Fast path for plain decimal numbers.
+  const char *begin = str.data(), *stop = str.data() + str.size();
+  bool negative = begin != stop && *begin == '-';
+  if (stop - begin > negative && begin[negative] >= '0' && begin[negative] <= '9') {
+    uint64_t value;
+    const char *parsed = ParseDecimal(begin + negative, stop, value);
+    if (parsed && value <= static_cast<uint64_t>(std::numeric_limits<long int>::max())) {
+      out = negative ? -static_cast<long int>(value) : static_cast<long int>(value);
+      return parsed;
+    }
+  }
+  // Leading spaces, plus sign, and overflow.
   char *end;
   errno = 0;
   out = strtol(str.data(), &end, 10);
@@ -206,6 +230,16 @@ const char *ParseNumber(StringPiece str, long int &out) {
   return end;
 }
 const char *ParseNumber(StringPiece str, unsigned long int &out) {
+  const char *begin = str.data(), *stop = str.data() + str.size();
+  if (begin != stop && *begin >= '0' && *begin <= '9') {
+    uint64_t value;
+    const char *parsed = ParseDecimal(begin, stop, value);
+    if (parsed && value <= std::numeric_limits<unsigned long int>::max()) {
+      out = value;
+      return parsed;
+    }
+  }
+  // Leading spaces, signs, and overflow.
   char *end;
   errno = 0;
   out = strtoul(str.data(), &end, 10);
@@ -271,27 +305,37 @@ void FilePiece::UpdateProgress() {
 }
 
 void FilePiece::MMapShift(uint64_t desired_begin) {
+  UTIL_TRACE_SPAN("FilePiece mmap");
   // Use mmap.
   uint64_t ignore = desired_begin % kPageSize;
-  // Duplicate request for Shift means give more data.
   if (position_ == data_.begin() + ignore && position_) {
+    // Duplicate request for Shift means give more data.
     default_map_size_ *= 2;
+  } else if (position_) {
+    // Moving forward: remap less often.
+    default_map_size_ = std::max(default_map_size_, std::min(default_map_size_ * 2, kMaxMapWindow));
   }
   // Local version so that in case of failure it doesn't overwrite the class variable.
   uint64_t mapped_offset = desired_begin - ignore;
 
   uint64_t mapped_size;
-  if (default_map_size_ >= static_cast<std::size_t>(total_size_ - mapped_offset)) {
+  uint64_t remaining = total_size_ - mapped_offset;
+  bool populate = remaining <= kPopulateLimit;
+  if (populate || default_map_size_ >= remaining) {
     at_end_ = true;
-    mapped_size = total_size_ - mapped_offset;
+    mapped_size = remaining;
   } else {
     mapped_size = default_map_size_;
   }
 
   // Forcibly clear the existing mmap first.
+  bool had_map = data_.get() != NULL;
   data_.reset();
+  if (had_map && total_size_ >= kDropBehindSize && mapped_offset > mapped_offset_) {
+    AdviseFile(*file_, mapped_offset_, mapped_offset - mapped_offset_, ADVISE_DONTNEED);
+  }
   try {
-    MapRead(POPULATE_OR_LAZY, *file_, mapped_offset, mapped_size, data_);
+    MapRead(populate ? POPULATE_OR_LAZY : LAZY, *file_, mapped_offset, mapped_size, data_);
   } catch (const util::ErrnoException &e) {
     if (desired_begin) {
       SeekOrThrow(*file_, desired_begin);
@@ -301,6 +345,11 @@ void FilePiece::MMapShift(uint64_t desired_begin) {
     TransitionToRead();
     return;
   }
+  if (!populate) {
+    AdviseMemory(data_.get(), mapped_size, ADVISE_SEQUENTIAL);
+    // Read this window and the next one in the background.
+    AdviseFile(*file_, mapped_offset, mapped_size + std::min<uint64_t>(kMaxMapWindow, remaining - mapped_size), ADVISE_WILLNEED);
+  }
   mapped_offset_ = mapped_offset;
   position_ = data_.begin() + ignore;
   position_end_ = data_.begin() + mapped_size;
@@ -317,7 +366,11 @@ void FilePiece::TransitionToRead() {
   position_end_ = position_;
 
   try {
-    fell_back_.Reset(file_.release());
+    if (DefaultReadBackend() == THREAD_READ_AHEAD) {
+      read_ahead_.reset(new ReadAhead(file_.release()));
+    } else {
+      fell_back_.Reset(file_.release());
+    }
   } catch (util::Exception &e) {
     e << " in file " << file_name_;
     throw;
@@ -355,8 +408,14 @@ void FilePiece::ReadShift() {
     }
   }
 
-  std::size_t read_return = fell_back_.Read(static_cast<uint8_t*>(data_.get()) + already_read, default_map_size_ - already_read);
-  progress_.Set(fell_back_.RawAmount());
+  std::size_t read_return;
+  if (read_ahead_) {
+    read_return = read_ahead_->Read(static_cast<uint8_t*>(data_.get()) + already_read, default_map_size_ - already_read);
+    progress_.Set(read_ahead_->RawAmount());
+  } else {
+    read_return = fell_back_.Read(static_cast<uint8_t*>(data_.get()) + already_read, default_map_size_ - already_read);
+    progress_.Set(fell_back_.RawAmount());
+  }
 
   if (read_return == 0) {
     at_end_ = true;
@@ -6,11 +6,13 @@
 #include "util/exception.hh"
 #include "util/file.hh"
 #include "util/mmap.hh"
+#include "util/read_ahead.hh"
 #include "util/spaces.hh"
 #include "util/string_piece.hh"
 
 #include <cstddef>
 #include <iosfwd>
+#include <memory>
 #include <string>
 #include <cassert>
 #include <stdint.h>
@@ -216,6 +218,9 @@ class FilePiece {
     std::string file_name_;
 
     ReadCompressed fell_back_;
+
+    // Used instead of fell_back_ with THREAD_READ_AHEAD.
+    std::unique_ptr<ReadAhead> read_ahead_;
 };
 
 } // namespace util
@@ -3,6 +3,7 @@
 
 #include "util/file_stream.hh"
 #include "util/file.hh"
+#include "util/read_ahead.hh"
 #include "util/scoped.hh"
 
 #define BOOST_TEST_MODULE FilePieceTest
@@ -13,6 +14,9 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 
+#include <poll.h>
+#include <unistd.h>
+
 namespace util {
 namespace {
 
@@ -53,6 +57,26 @@ BOOST_AUTO_TEST_CASE(MMapReadLine) {
   BOOST_CHECK_THROW(test.get(), EndOfFileException);
 }
 
+/* Too big to map at once, so the window slides and grows. */
+BOOST_AUTO_TEST_CASE(MMapWindows) {
+  scoped_fd file(MakeTemp(FileLocation()));
+  const unsigned kLines = 500000;
+  {
+    util::FileStream writing(file.get());
+    for (unsigned i = 0; i < kLines; ++i) {
+      writing << i << ' ' << std::string(i % 71, 'x') << '\n';
+    }
+  }
+  SeekOrThrow(file.get(), 0);
+  FilePiece test(file.release(), NULL, NULL, 1);
+  for (unsigned i = 0; i < kLines; ++i) {
+    BOOST_REQUIRE_EQUAL(i, test.ReadULong());
+    BOOST_REQUIRE_EQUAL(' ', test.get());
+    BOOST_REQUIRE_EQUAL(std::string(i % 71, 'x'), test.ReadLine());
+  }
+  BOOST_CHECK_THROW(test.get(), EndOfFileException);
+}
+
 /* mmap with seek beforehand */
 BOOST_AUTO_TEST_CASE(MMapSeek) {
   std::fstream ref(FileLocation().c_str(), std::ios::in);
@@ -76,7 +100,7 @@ BOOST_AUTO_TEST_CASE(MMapSeek) {
  * reimplement popen.  This is an issue with the test.
  */
 /* read() implementation */
-BOOST_AUTO_TEST_CASE(StreamReadLine) {
+void CheckStreamReadLine() {
   std::fstream ref(FileLocation().c_str(), std::ios::in);
 
   std::string popen_args = "cat \"";
@@ -98,6 +122,45 @@ BOOST_AUTO_TEST_CASE(StreamReadLine) {
   BOOST_CHECK_THROW(test.get(), EndOfFileException);
   BOOST_REQUIRE(!pclose(catter));
 }
+
+BOOST_AUTO_TEST_CASE(StreamReadLine) {
+  CheckStreamReadLine();
+}
+
+BOOST_AUTO_TEST_CASE(StreamReadLineBlocking) {
+  ReadBackend original = DefaultReadBackend();
+  SetDefaultReadBackend(BLOCKING_READ);
+  CheckStreamReadLine();
+  SetDefaultReadBackend(original);
+}
+
+BOOST_AUTO_TEST_CASE(StreamReadLineReadAhead) {
+  ReadBackend original = DefaultReadBackend();
+  SetDefaultReadBackend(THREAD_READ_AHEAD);
+  CheckStreamReadLine();
+  SetDefaultReadBackend(original);
+}
+
+// Once ReadAhead is gone, its thread must not start new reads that would keep
+// the pipe open.
+BOOST_AUTO_TEST_CASE(ReadAheadStops) {
+  int fds[2];
+  BOOST_REQUIRE(!pipe(fds));
+  scoped_fd writing(fds[1]);
+  // The constructor reads enough to detect compression.
+  std::string data(4096, 'a');
+  WriteOrThrow(writing.get(), data.data(), data.size());
+  delete new ReadAhead(fds[0]);
+  // Let any read in progress finish, but give no data for further reads.
+  WriteOrThrow(writing.get(), data.data(), data.size());
+  pollfd closed;
+  closed.fd = writing.get();
+  closed.events = 0;
+  closed.revents = 0;
+  // POLLERR once the read end is closed.
+  BOOST_CHECK_EQUAL(1, poll(&closed, 1, 10000));
+  BOOST_CHECK(closed.revents & POLLERR);
+}
 #endif
 
 #ifdef HAVE_ZLIB
@@ -0,0 +1,39 @@
+#include "util/file_stream.hh"
+
+#include "util/async_writer.hh"
+
+namespace util {
+
+FileStream::FileStream(int out, std::size_t buffer_size, AsyncWriter &writer)
+  : buf_(util::MallocOrThrow(std::max<std::size_t>(buffer_size, kToStringMaxBytes))),
+    spare_(util::MallocOrThrow(std::max<std::size_t>(buffer_size, kToStringMaxBytes))),
+    current_(static_cast<char*>(buf_.get())),
+    end_(current_ + std::max<std::size_t>(buffer_size, kToStringMaxBytes)),
+    fd_(out), writer_(&writer), pending_(new detail::PendingWrite()) {}
+
+void FileStream::AsyncSwap() {
+  if (current_ == buf_.get()) return;
+  std::size_t size = end_ - static_cast<char*>(buf_.get());
+  std::size_t used = current_ - static_cast<char*>(buf_.get());
+  // Wait for the spare buffer to finish writing.
+  pending_->WaitIdle();
+  void *full = buf_.release();
+  buf_.reset(spare_.release());
+  spare_.reset(full);
+  current_ = static_cast<char*>(buf_.get());
+  end_ = current_ + size;
+  writer_->Submit(fd_, full, used, *pending_);
+}
+
+void FileStream::AsyncFlush() {
+  AsyncSwap();
+  pending_->WaitIdle();
+  pending_->MarkIdle();
+}
+
+void FileStream::DeletePending() {
+  delete pending_;
+  pending_ = NULL;
+}
+
+} // namespace util
@@ -1,5 +1,7 @@
 /* Like std::ofstream but without being incredibly slow.  Backed by a raw fd.
  * Supports most of the built-in types except for long double.
+ * Optionally, full buffers are written by an AsyncWriter while the next one
+ * fills.
  */
 #ifndef UTIL_FILE_STREAM_H
 #define UTIL_FILE_STREAM_H
@@ -15,23 +17,32 @@
 
 namespace util {
 
+class AsyncWriter;
+namespace detail { class PendingWrite; }
+
 class FileStream : public FakeOStream<FileStream> {
   public:
     explicit FileStream(int out = -1, std::size_t buffer_size = 8192)
       : buf_(util::MallocOrThrow(std::max<std::size_t>(buffer_size, kToStringMaxBytes))),
         current_(static_cast<char*>(buf_.get())),
         end_(current_ + std::max<std::size_t>(buffer_size, kToStringMaxBytes)),
-        fd_(out) {}
+        fd_(out), writer_(NULL), pending_(NULL) {}
+
+    // Full buffers are handed to writer, which must outlive this stream.
+    FileStream(int out, std::size_t buffer_size, AsyncWriter &writer);
 
 #if __cplusplus >= 201103L
-    FileStream(FileStream &&from) noexcept : buf_(from.buf_.release()), current_(from.current_), end_(from.end_), fd_(from.fd_) {
+    FileStream(FileStream &&from) noexcept : buf_(from.buf_.release()), spare_(from.spare_.release()), current_(from.current_), end_(from.end_), fd_(from.fd_), writer_(from.writer_), pending_(from.pending_) {
       from.end_ = reinterpret_cast<char*>(from.buf_.get());
       from.current_ = from.end_;
+      from.writer_ = NULL;
+      from.pending_ = NULL;
     }
 #endif
 
     ~FileStream() {
       flush();
+      if (pending_) DeletePending();
     }
 
     void SetFD(int to) {
@@ -39,8 +50,11 @@ class FileStream : public FakeOStream<FileStream> {
       fd_ = to;
     }
 
+    // Returns once everything is written, even in asynchronous mode.
     FileStream &flush() {
-      if (current_ != buf_.get()) {
+      if (UTIL_UNLIKELY(writer_ != NULL)) {
+        AsyncFlush();
+      } else if (current_ != buf_.get()) {
         util::WriteOrThrow(fd_, buf_.get(), current_ - (char*)buf_.get());
         current_ = static_cast<char*>(buf_.get());
       }
@@ -54,11 +68,12 @@ class FileStream : public FakeOStream<FileStream> {
         current_ += length;
         return *this;
       }
-      flush();
+      Drain();
       if (current_ + length <= end_) {
         std::memcpy(current_, data, length);
         current_ += length;
       } else {
+        flush();
         util::WriteOrThrow(fd_, data, length);
       }
       return *this;
@@ -75,7 +90,7 @@ class FileStream : public FakeOStream<FileStream> {
     // For writes directly to buffer guaranteed to have amount < buffer size.
     char *Ensure(std::size_t amount) {
       if (UTIL_UNLIKELY(current_ + amount > end_)) {
-        flush();
+        Drain();
         assert(current_ + amount <= end_);
       }
       return current_;
@@ -87,9 +102,28 @@ class FileStream : public FakeOStream<FileStream> {
     }
 
   private:
+    // Make room in the buffer.  Unlike flush, this does not wait for asynchronous writes.
+    void Drain() {
+      if (UTIL_UNLIKELY(writer_ != NULL)) {
+        AsyncSwap();
+      } else {
+        flush();
+      }
+    }
+
+    // Asynchronous mode, in file_stream.cc.
+    void AsyncSwap();
+    void AsyncFlush();
+    void DeletePending();
+
     util::scoped_malloc buf_;
+    // Buffer being written by writer_.
+    util::scoped_malloc spare_;
     char *current_, *end_;
     int fd_;
+
+    AsyncWriter *writer_;
+    detail::PendingWrite *pending_;
 };
 
 } // namespace
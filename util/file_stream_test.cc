@@ -0,0 +1,80 @@
+#define BOOST_TEST_MODULE FileStreamTest
+
+#include "util/async_writer.hh"
+#include "util/file_stream.hh"
+#include "util/file.hh"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+namespace util { namespace {
+
+std::string ReadBack(int fd) {
+  std::string ret(SizeOrThrow(fd), 0);
+  if (!ret.empty()) ErsatzPRead(fd, &ret[0], ret.size(), 0);
+  return ret;
+}
+
+// Writes lines of varying length, plus one write that exceeds the buffer.
+template <class Stream> std::string Fill(Stream &out) {
+  std::string expect;
+  for (unsigned i = 0; i < 5000; ++i) {
+    std::string line(i % 97, 'a' + i % 26);
+    out << line << ' ' << i << '\n';
+    expect += line + ' ' + std::to_string(i) + '\n';
+  }
+  std::string big(100000, 'z');
+  out << big;
+  expect += big;
+  out << "end\n";
+  expect += "end\n";
+  return expect;
+}
+
+BOOST_AUTO_TEST_CASE(Synchronous) {
+  scoped_fd file(MakeTemp("file_stream_test"));
+  std::string expect;
+  {
+    FileStream out(file.get(), 100);
+    expect = Fill(out);
+  }
+  BOOST_CHECK(expect == ReadBack(file.get()));
+}
+
+BOOST_AUTO_TEST_CASE(Asynchronous) {
+  scoped_fd file0(MakeTemp("file_stream_test")), file1(MakeTemp("file_stream_test"));
+  std::string expect0, expect1;
+  AsyncWriter writer(2);
+  {
+    FileStream out0(file0.get(), 100, writer), out1(file1.get(), 4096, writer);
+    expect0 = Fill(out0);
+    expect1 = Fill(out1);
+  }
+  BOOST_CHECK(expect0 == ReadBack(file0.get()));
+  BOOST_CHECK(expect1 == ReadBack(file1.get()));
+}
+
+BOOST_AUTO_TEST_CASE(AsynchronousFlush) {
+  scoped_fd file(MakeTemp("file_stream_test"));
+  AsyncWriter writer;
+  FileStream out(file.get(), 100, writer);
+  out << "hello\n";
+  out.flush();
+  BOOST_CHECK_EQUAL("hello\n", ReadBack(file.get()));
+  out << std::string(1000, 'x');
+  out.flush();
+  BOOST_CHECK_EQUAL(1006U, SizeOrThrow(file.get()));
+}
+
+BOOST_AUTO_TEST_CASE(AsynchronousError) {
+  AsyncWriter writer;
+  // Not open for writing.
+  scoped_fd read_only(OpenReadOrThrow("/dev/null"));
+  FileStream out(read_only.get(), 100, writer);
+  out << "line\n";
+  // The error happens in the writer thread and is reported here.
+  BOOST_CHECK_THROW(out.flush(), FDException);
+}
+
+}} // namespaces
@@ -0,0 +1,158 @@
+#include "util/microbench.hh"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace util {
+namespace microbench {
+
+namespace {
+struct Entry {
+  const char *name;
+  Function function;
+};
+
+std::vector<Entry> &Registry() {
+  static std::vector<Entry> registry;
+  return registry;
+}
+
+uint64_t NowNanoseconds() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Time stamp counter ticks, which track wall time at a fixed rate rather than
+// core cycles on modern x86.  0 elsewhere.
+uint64_t NowCycles() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+std::vector<std::size_t> ParseSizes(const char *arg) {
+  std::vector<std::size_t> ret;
+  while (*arg) {
+    char *end;
+    ret.push_back(strtoull(arg, &end, 10));
+    // Suffixes k and m for powers of 1024.
+    if (*end == 'k' || *end == 'K') { ret.back() <<= 10; ++end; }
+    if (*end == 'm' || *end == 'M') { ret.back() <<= 20; ++end; }
+    UTIL_THROW_IF2(end == arg || (*end && *end != ','), "Bad --sizes " << arg);
+    arg = *end ? end + 1 : end;
+  }
+  return ret;
+}
+
+void Pin(int cpu) {
+#if defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  int ret = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+  UTIL_THROW_IF2(ret, "Could not pin to CPU " << cpu << ": " << strerror(ret));
+#else
+  UTIL_THROW(Exception, "Pinning to a CPU is only supported on Linux");
+#endif
+}
+} // namespace
+
+Run::Run(std::size_t size, double min_seconds)
+  : size_(size), min_seconds_(min_seconds), bytes_(size), remaining_(0), batch_(1), iterations_(0), started_(false),
+    start_ns_(0), start_cycles_(0), seconds_(0.0), cycles_(0) {}
+
+bool Run::Refill() {
+  uint64_t now_cycles = NowCycles();
+  uint64_t now_ns = NowNanoseconds();
+  if (!started_) {
+    started_ = true;
+    start_ns_ = now_ns;
+    start_cycles_ = now_cycles;
+    iterations_ = 1;
+    return true;
+  }
+  seconds_ = static_cast<double>(now_ns - start_ns_) * 1e-9;
+  cycles_ = now_cycles - start_cycles_;
+  if (seconds_ >= min_seconds_) return false;
+  // Check the clock rarely once iterations are fast.
+  batch_ *= 2;
+  iterations_ += batch_;
+  remaining_ = batch_ - 1;
+  return true;
+}
+
+Registration::Registration(const char *name, Function function) {
+  Entry entry;
+  entry.name = name;
+  entry.function = function;
+  Registry().push_back(entry);
+}
+
+int Main(int argc, char *argv[]) {
+  std::vector<std::size_t> sizes = ParseSizes("64,4k,1m");
+  const char *filter = "";
+  double min_seconds = 0.5;
+  bool json = false;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--sizes") && i + 1 < argc) {
+      sizes = ParseSizes(argv[++i]);
+    } else if (!strcmp(argv[i], "--filter") && i + 1 < argc) {
+      filter = argv[++i];
+    } else if (!strcmp(argv[i], "--min-time") && i + 1 < argc) {
+      min_seconds = strtod(argv[++i], NULL);
+    } else if (!strcmp(argv[i], "--cpu") && i + 1 < argc) {
+      Pin(atoi(argv[++i]));
+    } else if (!strcmp(argv[i], "--json")) {
+      json = true;
+    } else {
+      std::cerr << "Usage: " << argv[0] << " [--sizes 64,4k,1m] [--filter text] [--min-time seconds] [--cpu N] [--json]\n"
+        "Cycles are time stamp counter ticks; pin with --cpu and fix the\n"
+        "clock frequency for stable numbers.\nBenchmarks:";
+      for (const Entry &e : Registry()) std::cerr << ' ' << e.name;
+      std::cerr << std::endl;
+      return 1;
+    }
+  }
+  if (!json) {
+    std::cout << std::left << std::setw(28) << "name" << std::right << std::setw(10) << "size" << std::setw(14) << "iterations"
+      << std::setw(14) << "ns/iter" << std::setw(12) << "MB/s" << std::setw(14) << "cycles/byte" << '\n';
+  }
+  for (const Entry &e : Registry()) {
+    if (!strstr(e.name, filter)) continue;
+    for (std::size_t size : sizes) {
+      Run run(size, min_seconds);
+      e.function(run);
+      if (!run.Iterations()) continue;
+      double ns = run.Seconds() * 1e9 / run.Iterations();
+      double total_bytes = static_cast<double>(run.Bytes()) * run.Iterations();
+      double mb = run.Seconds() > 0 ? total_bytes / run.Seconds() / 1e6 : 0.0;
+      double cycles_per_byte = total_bytes > 0 ? run.Cycles() / total_bytes : 0.0;
+      if (json) {
+        std::cout << "{\"name\":\"" << e.name << "\",\"size\":" << size << ",\"iterations\":" << run.Iterations()
+          << ",\"ns_per_iteration\":" << ns << ",\"mb_per_second\":" << mb << ",\"cycles_per_byte\":" << cycles_per_byte << "}\n";
+      } else {
+        std::cout << std::left << std::setw(28) << e.name << std::right << std::setw(10) << size << std::setw(14) << run.Iterations()
+          << std::setw(14) << std::fixed << std::setprecision(1) << ns << std::setw(12) << mb << std::setw(14) << std::setprecision(3) << cycles_per_byte << '\n';
+      }
+      std::cout.flush();
+    }
+  }
+  return 0;
+}
+
+} // namespace microbench
+} // namespace util
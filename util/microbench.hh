@@ -0,0 +1,107 @@
+#ifndef UTIL_MICROBENCH_H
+#define UTIL_MICROBENCH_H
+
+/* Microbenchmarks for hot primitives.  Define one with
+ *
+ * UTIL_MICROBENCH(murmur_hash) {
+ *   std::string data(run.Size(), 'x');
+ *   run.SetBytes(data.size());
+ *   while (run.Next()) {
+ *     util::microbench::DoNotOptimize(util::MurmurHashNative(data.data(), data.size()));
+ *   }
+ * }
+ *
+ * in an executable whose main calls util::microbench::Main, as
+ * bench/microbench_main.cc does.  Each is run once per --sizes value,
+ * repeating until --min-time passes, and reports ns per iteration, MB/s, and
+ * cycles per byte.
+ */
+
+#include "util/exception.hh"
+
+#include <cstddef>
+#include <string>
+
+#include <stdint.h>
+
+namespace util {
+namespace microbench {
+
+class Run {
+  public:
+    Run(std::size_t size, double min_seconds);
+
+    // The size parameter from --sizes.
+    std::size_t Size() const { return size_; }
+
+    // Bytes processed per iteration.  Defaults to Size().
+    void SetBytes(uint64_t bytes) { bytes_ = bytes; }
+
+    // Loop condition.  Timing starts with the first call, so setup before the
+    // loop is not counted.
+    bool Next() {
+      if (UTIL_LIKELY(remaining_)) {
+        --remaining_;
+        return true;
+      }
+      return Refill();
+    }
+
+    uint64_t Iterations() const { return iterations_; }
+    uint64_t Bytes() const { return bytes_; }
+    double Seconds() const { return seconds_; }
+    uint64_t Cycles() const { return cycles_; }
+
+  private:
+    bool Refill();
+
+    const std::size_t size_;
+    const double min_seconds_;
+    uint64_t bytes_;
+
+    uint64_t remaining_;
+    uint64_t batch_;
+    uint64_t iterations_;
+    bool started_;
+
+    // Measurements, accumulated over batches.
+    uint64_t start_ns_, start_cycles_;
+    double seconds_;
+    uint64_t cycles_;
+};
+
+typedef void (*Function)(Run &run);
+
+// Used by UTIL_MICROBENCH.
+struct Registration {
+  Registration(const char *name, Function function);
+};
+
+// Keep the compiler from optimizing away a computation.
+template <class T> inline void DoNotOptimize(const T &value) {
+#if defined(__GNUC__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void *sink;
+  sink = &value;
+#endif
+}
+
+/* Runs the registered benchmarks.  Options:
+ *   --sizes 64,4096,1048576  size parameters
+ *   --filter text            only names containing text
+ *   --min-time 0.5           seconds per measurement
+ *   --cpu N                  pin the benchmark thread to CPU N (Linux)
+ *   --json                   print JSON lines instead of a table
+ */
+int Main(int argc, char *argv[]);
+
+} // namespace microbench
+} // namespace util
+
+#define UTIL_MICROBENCH(name) \
+  static void UtilMicrobench_##name(util::microbench::Run &run); \
+  static util::microbench::Registration UtilMicrobenchRegistration_##name(#name, &UtilMicrobench_##name); \
+  static void UtilMicrobench_##name(util::microbench::Run &run)
+
+#endif // UTIL_MICROBENCH_H
@@ -299,6 +299,46 @@ void HugeRealloc(std::size_t to, bool zero_new, scoped_memory &mem) {
   }
 }
 
+void AdviseMemory(void *start, std::size_t size, AccessAdvice advice) {
+#if !defined(_WIN32) && !defined(_WIN64)
+  int flag;
+  switch (advice) {
+    case ADVISE_SEQUENTIAL:
+      flag = MADV_SEQUENTIAL;
+      break;
+    case ADVISE_WILLNEED:
+      flag = MADV_WILLNEED;
+      break;
+    case ADVISE_DONTNEED:
+      flag = MADV_DONTNEED;
+      break;
+    default:
+      return;
+  }
+  madvise(start, size, flag);
+#endif
+}
+
+void AdviseFile(int fd, uint64_t offset, uint64_t size, AccessAdvice advice) {
+#if defined(POSIX_FADV_SEQUENTIAL)
+  int flag;
+  switch (advice) {
+    case ADVISE_SEQUENTIAL:
+      flag = POSIX_FADV_SEQUENTIAL;
+      break;
+    case ADVISE_WILLNEED:
+      flag = POSIX_FADV_WILLNEED;
+      break;
+    case ADVISE_DONTNEED:
+      flag = POSIX_FADV_DONTNEED;
+      break;
+    default:
+      return;
+  }
+  posix_fadvise(fd, offset, size, flag);
+#endif
+}
+
 void MapRead(LoadMethod method, int fd, uint64_t offset, std::size_t size, scoped_memory &out) {
   switch (method) {
     case LAZY:
@@ -142,6 +142,24 @@ void HugeMalloc(std::size_t size, bool zeroed, scoped_memory &to);
 // this.
 void HugeRealloc(std::size_t size, bool new_zeroed, scoped_memory &mem);
 
+// Hints about how memory or a file will be accessed.  Failures are ignored and
+// these do nothing on platforms without madvise/posix_fadvise.
+enum AccessAdvice {
+  // Read in order, so read ahead aggressively.
+  ADVISE_SEQUENTIAL,
+  // Start reading this in now.
+  ADVISE_WILLNEED,
+  // Done with it; pages can be dropped.
+  ADVISE_DONTNEED,
+};
+
+// start must be page aligned, e.g. the beginning of a mapping.
+void AdviseMemory(void *start, std::size_t size, AccessAdvice advice);
+
+// Advice for the page cache of a file.  ADVISE_DONTNEED only drops pages that
+// are not mapped.
+void AdviseFile(int fd, uint64_t offset, uint64_t size, AccessAdvice advice);
+
 enum LoadMethod {
   // mmap with no prepopulate
   LAZY,
@@ -2,6 +2,7 @@
 #define UTIL_PCQUEUE_H
 
 #include "util/exception.hh"
+#include "util/trace.hh"
 
 #include <algorithm>
 #include <cerrno>
@@ -127,7 +128,10 @@ template <class T> class PCQueue {
 
   // Add a value to the queue.
   void Produce(const T &val) {
-    WaitSemaphore(empty_);
+    {
+      UTIL_TRACE_SPAN("PCQueue produce wait");
+      WaitSemaphore(empty_);
+    }
     {
       std::lock_guard<std::mutex> produce_lock(produce_at_mutex_);
       try {
@@ -143,7 +147,10 @@ template <class T> class PCQueue {
 
   // Add a value to the queue, but swap it into place.
   void ProduceSwap(T &val) {
-    WaitSemaphore(empty_);
+    {
+      UTIL_TRACE_SPAN("PCQueue produce wait");
+      WaitSemaphore(empty_);
+    }
     {
       std::lock_guard<std::mutex> produce_lock(produce_at_mutex_);
       try {
@@ -160,7 +167,10 @@ template <class T> class PCQueue {
 
   // Consume a value, assigning it to out.
   T& Consume(T &out) {
-    WaitSemaphore(used_);
+    {
+      UTIL_TRACE_SPAN("PCQueue consume wait");
+      WaitSemaphore(used_);
+    }
     {
       std::lock_guard<std::mutex> consume_lock(consume_at_mutex_);
       try {
@@ -177,7 +187,10 @@ template <class T> class PCQueue {
 
   // Consume a value, swapping it to out.
   T& ConsumeSwap(T &out) {
-    WaitSemaphore(used_);
+    {
+      UTIL_TRACE_SPAN("PCQueue consume wait");
+      WaitSemaphore(used_);
+    }
     {
       std::lock_guard<std::mutex> consume_lock(consume_at_mutex_);
       try {
@@ -248,7 +261,10 @@ template <class T> class UnboundedSingleQueue {
     }
 
     T& Consume(T &out) {
-      WaitSemaphore(valid_);
+      {
+        UTIL_TRACE_SPAN("UnboundedSingleQueue consume wait");
+        WaitSemaphore(valid_);
+      }
       if (reading_current_ == reading_end_) {
         SetReading(reading_->next);
       }
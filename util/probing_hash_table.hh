@@ -3,6 +3,7 @@
 
 #include "util/exception.hh"
 #include "util/mmap.hh"
+#include "util/trace.hh"
 
 #include <algorithm>
 #include <cstddef>
@@ -397,6 +398,7 @@ template <class EntryT, class HashT, class EqualT = std::equal_to<typename Entry
     void DoubleIfNeeded() {
       if (UTIL_LIKELY(Size() < threshold_))
         return;
+      UTIL_TRACE_SPAN("AutoProbing double");
       HugeRealloc(backend_.DoubleTo(), KeyIsRawZero(backend_.invalid_), mem_);
       allocated_ = backend_.DoubleTo();
       backend_.Double(mem_.get(), !KeyIsRawZero(backend_.invalid_));
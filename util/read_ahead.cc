@@ -0,0 +1,134 @@
+#include "util/read_ahead.hh"
+
+#include "util/compress.hh"
+#include "util/exception.hh"
+#include "util/fixed_array.hh"
+#include "util/pcqueue.hh"
+#include "util/scoped.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <thread>
+
+namespace util {
+
+namespace {
+ReadBackend BackendFromEnvironment() {
+  const char *value = getenv("PREPROCESS_READ_BACKEND");
+  if (!value || !*value) {
+    // Reading ahead only helps if there is another core to do it.
+    return std::thread::hardware_concurrency() > 1 ? THREAD_READ_AHEAD : BLOCKING_READ;
+  }
+  if (!strcmp(value, "thread")) return THREAD_READ_AHEAD;
+  UTIL_THROW_IF2(strcmp(value, "blocking"), "PREPROCESS_READ_BACKEND should be blocking or thread, not " << value);
+  return BLOCKING_READ;
+}
+
+std::atomic<int> &DefaultBackendStorage() {
+  static std::atomic<int> backend(BackendFromEnvironment());
+  return backend;
+}
+} // namespace
+
+ReadBackend DefaultReadBackend() {
+  return static_cast<ReadBackend>(DefaultBackendStorage().load());
+}
+
+void SetDefaultReadBackend(ReadBackend to) {
+  DefaultBackendStorage().store(to);
+}
+
+struct ReadAhead::Chunk {
+  scoped_malloc memory;
+  std::size_t size;
+  uint64_t raw_amount;
+  std::exception_ptr error;
+};
+
+// Shared with the thread, which may outlive ReadAhead.
+struct ReadAhead::Shared {
+  Shared(int fd, std::size_t buffer_size_in, std::size_t buffers)
+    : reader(fd), buffer_size(buffer_size_in), chunks(buffers),
+      // One extra so the poison in ~ReadAhead never blocks.
+      free(buffers + 1), filled(buffers), stop(false) {
+    for (std::size_t i = 0; i < buffers; ++i) {
+      chunks.push_back();
+      chunks.back().memory.reset(MallocOrThrow(buffer_size));
+      free.Produce(&chunks.back());
+    }
+  }
+
+  ReadCompressed reader;
+  const std::size_t buffer_size;
+  FixedArray<Chunk> chunks;
+  // Empty chunks for the thread to fill.  NULL tells the thread to stop.
+  PCQueue<Chunk*> free;
+  // Chunks ready for Read.  Never blocks because there are only so many chunks.
+  PCQueue<Chunk*> filled;
+  // Set by ~ReadAhead so the thread starts no more reads even if free chunks
+  // are queued ahead of the NULL.
+  std::atomic<bool> stop;
+};
+
+ReadAhead::ReadAhead(int fd, std::size_t buffer_size, std::size_t buffers)
+  : shared_(new Shared(fd, buffer_size, std::max<std::size_t>(buffers, 2))), current_(NULL), offset_(0), raw_amount_(0), eof_(false) {
+  std::thread(&ReadAhead::Thread, shared_).detach();
+}
+
+ReadAhead::~ReadAhead() {
+  shared_->stop.store(true, std::memory_order_release);
+  shared_->free.Produce(NULL);
+}
+
+std::size_t ReadAhead::Read(void *to, std::size_t amount) {
+  if (eof_) return 0;
+  if (!current_) {
+    shared_->filled.Consume(current_);
+    offset_ = 0;
+    if (current_->error) {
+      eof_ = true;
+      std::rethrow_exception(current_->error);
+    }
+    raw_amount_ = current_->raw_amount;
+    if (!current_->size) {
+      eof_ = true;
+      return 0;
+    }
+  }
+  std::size_t ret = std::min(amount, current_->size - offset_);
+  memcpy(to, static_cast<const char*>(current_->memory.get()) + offset_, ret);
+  offset_ += ret;
+  if (offset_ == current_->size) {
+    shared_->free.Produce(current_);
+    current_ = NULL;
+  }
+  return ret;
+}
+
+uint64_t ReadAhead::RawAmount() const {
+  return raw_amount_;
+}
+
+void ReadAhead::Thread(std::shared_ptr<Shared> shared) {
+  Chunk *chunk;
+  while (true) {
+    shared->free.Consume(chunk);
+    if (!chunk || shared->stop.load(std::memory_order_acquire)) return;
+    try {
+      // A single read so that data from pipes is passed along as soon as it arrives.
+      chunk->size = shared->reader.Read(chunk->memory.get(), shared->buffer_size);
+      chunk->raw_amount = shared->reader.RawAmount();
+    } catch (...) {
+      chunk->error = std::current_exception();
+      shared->filled.Produce(chunk);
+      return;
+    }
+    shared->filled.Produce(chunk);
+    if (!chunk->size) return;
+  }
+}
+
+} // namespace util
@@ -0,0 +1,68 @@
+#ifndef UTIL_READ_AHEAD_H
+#define UTIL_READ_AHEAD_H
+
+#include <cstddef>
+#include <memory>
+
+#include <stdint.h>
+
+namespace util {
+
+// How FilePiece reads input it cannot mmap: pipes and compressed files.
+typedef enum {
+  // Read (and decompress) in the calling thread when the buffer runs dry.
+  BLOCKING_READ,
+  // A background thread keeps several buffers filled ahead of the parser.
+  THREAD_READ_AHEAD
+} ReadBackend;
+
+/* Default for new FilePiece instances.  Initially taken from the
+ * PREPROCESS_READ_BACKEND environment variable ("blocking" or "thread"), else
+ * THREAD_READ_AHEAD if there is more than one core.
+ */
+ReadBackend DefaultReadBackend();
+void SetDefaultReadBackend(ReadBackend to);
+
+/* Reads and decompresses a file descriptor like ReadCompressed, but on a
+ * background thread that keeps up to buffers chunks of buffer_size bytes
+ * ready.  Read copies out of the oldest ready chunk.
+ *
+ * If this is destroyed while the thread is blocked reading a pipe, the thread
+ * is left to finish that read on its own, then closes the file without
+ * starting another.
+ */
+class ReadAhead {
+  public:
+    // Takes ownership of fd.
+    explicit ReadAhead(int fd, std::size_t buffer_size = 1 << 20, std::size_t buffers = 4);
+
+    ~ReadAhead();
+
+    // Blocks until data is ready.  Returns 0 only at the end of the file.
+    // Errors from the background thread are rethrown here.
+    std::size_t Read(void *to, std::size_t amount);
+
+    // Raw (compressed) bytes read as of the chunk currently being returned.
+    uint64_t RawAmount() const;
+
+  private:
+    struct Chunk;
+    struct Shared;
+
+    static void Thread(std::shared_ptr<Shared> shared);
+
+    std::shared_ptr<Shared> shared_;
+
+    Chunk *current_;
+    std::size_t offset_;
+    uint64_t raw_amount_;
+    bool eof_;
+
+    // noncopyable
+    ReadAhead(const ReadAhead &);
+    ReadAhead &operator=(const ReadAhead &);
+};
+
+} // namespace util
+
+#endif // UTIL_READ_AHEAD_H
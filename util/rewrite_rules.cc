@@ -0,0 +1,1102 @@
+#include "util/rewrite_rules.hh"
+
+#include "util/exception.hh"
+#include "util/tokenize_piece.hh"
+
+#include <unicode/uchar.h>
+#include <unicode/uniset.h>
+#include <unicode/utf8.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <climits>
+#include <cstring>
+#include <set>
+#include <utility>
+
+#include <stdint.h>
+
+namespace util {
+
+using U_ICU_NAMESPACE::UnicodeSet;
+
+/* Members are code points in Unicode mode and bytes in byte mode.  Bytes that
+ * are not valid UTF-8 are looked up as U+FFFD, so only negated classes match
+ * them.
+ */
+class CharClass {
+  public:
+    CharClass(const UnicodeSet &members, bool unicode) : unicode_(unicode), set_(members) {
+      for (UChar32 c = 0; c < 256; ++c) {
+        table_[c] = set_.contains(c);
+      }
+      single_ = set_.size() == 1 ? set_.charAt(0) : -1;
+      set_.freeze();
+    }
+
+    bool Contains(UChar32 c) const {
+      if (c < 256) return table_[c];
+      // Byte mode only looks up bytes.
+      assert(unicode_);
+      return set_.contains(c);
+    }
+
+    // The only member or -1.
+    UChar32 Single() const { return single_; }
+
+  private:
+    bool table_[256];
+    bool unicode_;
+    UnicodeSet set_;
+    UChar32 single_;
+};
+
+namespace {
+
+const unsigned int kUnbounded = UINT_MAX;
+
+// Score for bytes of a literal when picking which one the automaton finds.
+// Letters, digits, and spaces are everywhere; punctuation is rarer.
+const unsigned int kCommonByte = 1;
+const unsigned int kRareByte = 4;
+
+inline char FoldASCII(char c) {
+  return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+}
+
+inline unsigned int ByteScore(char c) {
+  return (isalnum(static_cast<unsigned char>(c)) || c == ' ') ? kCommonByte : kRareByte;
+}
+
+// Mark c in set, in both ASCII cases if fold.
+inline void MarkByte(bool *set, char c, bool fold) {
+  set[static_cast<unsigned char>(c)] = true;
+  if (fold) {
+    set[static_cast<unsigned char>(FoldASCII(c))] = true;
+    set[toupper(static_cast<unsigned char>(c))] = true;
+  }
+}
+
+inline UChar32 NextUnit(const char *&pos, const char *end, bool unicode) {
+  unsigned char byte = *pos;
+  if (byte < 0x80 || !unicode) {
+    ++pos;
+    return byte;
+  }
+  int32_t offset = 0;
+  UChar32 c;
+  U8_NEXT(reinterpret_cast<const uint8_t*>(pos), offset, static_cast<int32_t>(end - pos), c);
+  pos += offset;
+  return c < 0 ? 0xFFFD : c;
+}
+
+inline UChar32 PrevUnit(const char *begin, const char *&pos, bool unicode) {
+  unsigned char byte = pos[-1];
+  if (byte < 0x80 || !unicode) {
+    --pos;
+    return byte;
+  }
+  int32_t offset = static_cast<int32_t>(pos - begin);
+  UChar32 c;
+  U8_PREV(reinterpret_cast<const uint8_t*>(begin), 0, offset, c);
+  pos = begin + offset;
+  return c < 0 ? 0xFFFD : c;
+}
+
+// One pattern element: a literal run of characters or a repeated class.
+struct Item {
+  Item() : cls(NULL), min(1), max(1), backtrack(false) {}
+
+  // Empty for a class.
+  std::string literal;
+  const CharClass *cls;
+  unsigned int min, max;
+  // When matching forward, try shorter runs if the rest fails.  Only needed
+  // when what follows could match what the run took.
+  bool backtrack;
+};
+
+struct Piece {
+  std::string literal;
+  // Group number or 0 for literal.
+  std::size_t capture;
+};
+
+// One alternative of a substitution, with alternations expanded.
+struct Rule {
+  std::vector<Item> items;
+  // Group n spans items [captures[n-1].first, captures[n-1].second).
+  std::vector<std::pair<std::size_t, std::size_t> > captures;
+  std::vector<Piece> replacement;
+  // Whether the replacement uses no groups, and then what it is.  Matches of
+  // exactly that text are left alone instead of copying the line.
+  bool constant;
+  std::string constant_text;
+  // Literal item the automaton finds; the items before it are matched
+  // backwards from there.  0 for rules in a scanning stage.
+  std::size_t anchor;
+  bool fold, global, begin, end;
+};
+
+bool LiteralAt(const std::string &literal, const char *pos, bool fold) {
+  if (!fold) return !memcmp(pos, literal.data(), literal.size());
+  for (std::size_t i = 0; i < literal.size(); ++i) {
+    if (FoldASCII(pos[i]) != FoldASCII(literal[i])) return false;
+  }
+  return true;
+}
+
+// Whether c or, for case-insensitive rules, its other ASCII case is in cls.
+bool ClassHas(const CharClass &cls, UChar32 c, bool fold) {
+  if (cls.Contains(c)) return true;
+  if (!fold || c >= 128) return false;
+  char other = (c >= 'a' && c <= 'z') ? c - ('a' - 'A') : FoldASCII(c);
+  return cls.Contains(static_cast<unsigned char>(other));
+}
+
+UChar32 FirstUnit(const std::string &literal, bool unicode) {
+  const char *pos = literal.data();
+  return NextUnit(pos, literal.data() + literal.size(), unicode);
+}
+
+UChar32 LastUnit(const std::string &literal, bool unicode) {
+  const char *pos = literal.data() + literal.size();
+  return PrevUnit(literal.data(), pos, unicode);
+}
+
+/* Add the code points of literal to out, with both ASCII cases if fold.  Even
+ * in byte mode, matches of valid UTF-8 literals can only overlap on whole code
+ * points, so this is what decides whether rules interact.  Returns false if
+ * literal is not valid UTF-8.
+ */
+bool CodePoints(const std::string &literal, bool fold, std::set<UChar32> &out) {
+  const uint8_t *text = reinterpret_cast<const uint8_t*>(literal.data());
+  for (int32_t i = 0; i < static_cast<int32_t>(literal.size());) {
+    UChar32 c;
+    U8_NEXT(text, i, static_cast<int32_t>(literal.size()), c);
+    if (c < 0) return false;
+    out.insert(c);
+    if (fold && c < 128) {
+      out.insert(static_cast<unsigned char>(FoldASCII(c)));
+      if (c >= 'a' && c <= 'z') out.insert(c - ('a' - 'A'));
+    }
+  }
+  return true;
+}
+
+/* Parses the pattern and replacement of a substitution.  Alternations are
+ * expanded into one Rule each, ordered as Perl tries them: the first group
+ * varies slowest.
+ */
+class Parser {
+  public:
+    Parser(StringPiece substitution, bool unicode, std::vector<std::unique_ptr<CharClass> > &classes)
+      : original_(substitution.data(), substitution.size()), unicode_(unicode), classes_(classes), groups_(0) {
+      Split(substitution);
+    }
+
+    void Expand(std::vector<Rule> &rules);
+
+  private:
+    struct Atom {
+      std::string literal;
+      const CharClass *cls;
+      unsigned int min, max;
+    };
+
+    // A capturing group, a non-capturing group, or a single atom with capture 0.
+    struct Group {
+      std::size_t capture;
+      std::vector<std::vector<Atom> > alternatives;
+    };
+
+    void Split(StringPiece substitution);
+
+    void ParsePattern();
+    void ParseAlternative(std::vector<Atom> &out);
+    bool ParseAtom(Atom &atom);
+    void ParseQuantifier(Atom &atom);
+    void ParseBracket(UnicodeSet &set);
+    // Add shorthand class \s \d or a complement to set.  Returns false for
+    // other letters.
+    bool Shorthand(char letter, UnicodeSet &set) const;
+    std::string ParseChar(char after_backslash) const;
+    void ParseReplacement(StringPiece replacement);
+
+    const CharClass *MakeClass(const UnicodeSet &set) {
+      classes_.push_back(std::unique_ptr<CharClass>(new CharClass(set, unicode_)));
+      return classes_.back().get();
+    }
+
+    void Complement(UnicodeSet &set) const {
+      if (unicode_) {
+        set.complement();
+      } else {
+        set.complement(0, 255);
+      }
+    }
+
+    void Fold(UnicodeSet &set) const {
+      if (unicode_) {
+        set.closeOver(USET_CASE_INSENSITIVE);
+        return;
+      }
+      for (UChar32 c = 'a'; c <= 'z'; ++c) {
+        if (set.contains(c) || set.contains(c - ('a' - 'A'))) {
+          set.add(c);
+          set.add(c - ('a' - 'A'));
+        }
+      }
+    }
+
+    void Build(const std::vector<const std::vector<Atom>*> &choice, Rule &rule) const;
+
+    bool AtEnd() const { return cur_ == end_; }
+
+    [[noreturn]] void Fail(const char *why) const {
+      UTIL_THROW(util::Exception, why << " in " << original_);
+    }
+
+    const std::string original_;
+    const bool unicode_;
+    std::vector<std::unique_ptr<CharClass> > &classes_;
+
+    std::string pattern_;
+    bool fold_, global_, begin_, end_anchor_;
+
+    std::vector<Group> sequence_;
+    std::size_t groups_;
+    std::vector<Piece> replacement_;
+
+    // Cursor into pattern_.
+    const char *cur_, *end_;
+};
+
+void Parser::Split(StringPiece substitution) {
+  const char *i = substitution.data(), *end = substitution.data() + substitution.size();
+  if (end - i < 2 || *i != 's') Fail("Expected s/pattern/replacement/");
+  const char delimiter = i[1];
+  i += 2;
+  StringPiece parts[2];
+  for (unsigned int p = 0; p < 2; ++p) {
+    const char *start = i;
+    for (; i != end && *i != delimiter; ++i) {
+      if (*i == '\\' && i + 1 != end) ++i;
+    }
+    if (i == end) Fail("Unterminated substitution");
+    parts[p] = StringPiece(start, i - start);
+    ++i;
+  }
+  fold_ = global_ = false;
+  for (; i != end; ++i) {
+    switch (*i) {
+      case 'g':
+        global_ = true;
+        break;
+      case 'i':
+        fold_ = true;
+        break;
+      default:
+        Fail("Unsupported flag");
+    }
+  }
+  pattern_.assign(parts[0].data(), parts[0].size());
+  ParsePattern();
+  ParseReplacement(parts[1]);
+}
+
+void Parser::ParsePattern() {
+  cur_ = pattern_.data();
+  end_ = pattern_.data() + pattern_.size();
+  begin_ = end_anchor_ = false;
+  if (!AtEnd() && *cur_ == '^') {
+    begin_ = true;
+    ++cur_;
+  }
+  while (!AtEnd()) {
+    if (*cur_ == '$' && cur_ + 1 == end_) {
+      end_anchor_ = true;
+      ++cur_;
+      break;
+    }
+    Group group;
+    if (*cur_ == '(') {
+      ++cur_;
+      if (end_ - cur_ >= 2 && cur_[0] == '?' && cur_[1] == ':') {
+        group.capture = 0;
+        cur_ += 2;
+      } else {
+        group.capture = ++groups_;
+      }
+      while (true) {
+        group.alternatives.resize(group.alternatives.size() + 1);
+        ParseAlternative(group.alternatives.back());
+        if (AtEnd()) Fail("Unterminated group");
+        if (*cur_++ == ')') break;
+      }
+      if (!AtEnd() && strchr("*+?{", *cur_)) Fail("Quantified groups are not supported");
+    } else {
+      group.capture = 0;
+      group.alternatives.resize(1);
+      Atom atom;
+      if (!ParseAtom(atom)) Fail("Unexpected character");
+      group.alternatives[0].push_back(atom);
+    }
+    sequence_.push_back(group);
+  }
+}
+
+// Atoms until | or ), which is left for the caller.
+void Parser::ParseAlternative(std::vector<Atom> &out) {
+  while (!AtEnd() && *cur_ != '|' && *cur_ != ')') {
+    Atom atom;
+    if (!ParseAtom(atom)) Fail("Nested groups are not supported");
+    out.push_back(atom);
+  }
+}
+
+bool Parser::ParseAtom(Atom &atom) {
+  atom.cls = NULL;
+  atom.min = atom.max = 1;
+  UnicodeSet set;
+  char c = *cur_;
+  switch (c) {
+    case '(':
+    case ')':
+    case '|':
+      return false;
+    case '*':
+    case '+':
+    case '?':
+    case '^':
+    case '$':
+      Fail("Unsupported use of metacharacter");
+    case '[':
+      ++cur_;
+      ParseBracket(set);
+      atom.cls = MakeClass(set);
+      break;
+    case '.':
+      ++cur_;
+      set.add('\n');
+      Complement(set);
+      atom.cls = MakeClass(set);
+      break;
+    case '\\':
+      if (cur_ + 1 == end_) Fail("Trailing backslash");
+      cur_ += 2;
+      if (Shorthand(cur_[-1], set)) {
+        atom.cls = MakeClass(set);
+      } else {
+        atom.literal = ParseChar(cur_[-1]);
+      }
+      break;
+    default:
+      {
+        const char *start = cur_;
+        NextUnit(cur_, end_, unicode_);
+        atom.literal.assign(start, cur_ - start);
+      }
+  }
+  if (!atom.cls && fold_ && unicode_) {
+    /* Perl folds non-ASCII letters too, and k and s also match the Kelvin sign
+     * and long s.  Those become classes; other ASCII is compared
+     * case-insensitively as a literal.
+     */
+    set.add(FirstUnit(atom.literal, true));
+    Fold(set);
+    if (set.size() > 1 && set.getRangeEnd(set.getRangeCount() - 1) >= 128) {
+      atom.cls = MakeClass(set);
+      atom.literal.clear();
+    }
+  }
+  ParseQuantifier(atom);
+  return true;
+}
+
+void Parser::ParseQuantifier(Atom &atom) {
+  if (AtEnd()) return;
+  switch (*cur_) {
+    case '*':
+      atom.min = 0;
+      atom.max = kUnbounded;
+      ++cur_;
+      break;
+    case '+':
+      atom.min = 1;
+      atom.max = kUnbounded;
+      ++cur_;
+      break;
+    case '?':
+      atom.min = 0;
+      atom.max = 1;
+      ++cur_;
+      break;
+    case '{':
+      {
+        const char *i = cur_ + 1;
+        if (i == end_ || !isdigit(*i)) return; // Literal {, as in Perl.
+        atom.min = strtoul(i, const_cast<char**>(&i), 10);
+        atom.max = atom.min;
+        if (i != end_ && *i == ',') {
+          ++i;
+          atom.max = (i != end_ && isdigit(*i)) ? strtoul(i, const_cast<char**>(&i), 10) : kUnbounded;
+        }
+        if (i == end_ || *i != '}') Fail("Bad {n,m} quantifier");
+        cur_ = i + 1;
+      }
+      break;
+    default:
+      return;
+  }
+  if (!AtEnd() && (*cur_ == '?' || *cur_ == '+')) Fail("Lazy and possessive quantifiers are not supported");
+  if (!atom.cls) {
+    // Quantifiers apply to one character, so make it a class.
+    UnicodeSet set;
+    set.add(FirstUnit(atom.literal, unicode_));
+    if (fold_) Fold(set);
+    atom.cls = MakeClass(set);
+    atom.literal.clear();
+  }
+}
+
+bool Parser::Shorthand(char letter, UnicodeSet &set) const {
+  UnicodeSet members;
+  UErrorCode err = U_ZERO_ERROR;
+  switch (letter) {
+    case 's':
+    case 'S':
+      if (unicode_) {
+        members.applyPropertyAlias(UNICODE_STRING_SIMPLE("White_Space"), UNICODE_STRING_SIMPLE(""), err);
+        UTIL_THROW_IF(U_FAILURE(err), util::Exception, "ICU failed to make \\s: " << u_errorName(err));
+      } else {
+        members.add('\t', '\r');
+        members.add(' ');
+      }
+      break;
+    case 'd':
+    case 'D':
+      if (unicode_) {
+        members.applyIntPropertyValue(UCHAR_GENERAL_CATEGORY_MASK, U_GC_ND_MASK, err);
+        UTIL_THROW_IF(U_FAILURE(err), util::Exception, "ICU failed to make \\d: " << u_errorName(err));
+      } else {
+        members.add('0', '9');
+      }
+      break;
+    default:
+      return false;
+  }
+  if (letter == 'S' || letter == 'D') Complement(members);
+  set.addAll(members);
+  return true;
+}
+
+// A character after a backslash, outside the shorthand classes.
+std::string Parser::ParseChar(char after_backslash) const {
+  switch (after_backslash) {
+    case 't':
+      return "\t";
+    case 'n':
+      return "\n";
+    case 'r':
+      return "\r";
+  }
+  if (isalnum(static_cast<unsigned char>(after_backslash))) Fail("Unsupported escape");
+  return std::string(1, after_backslash);
+}
+
+// After the [.  Leaves cur_ after the ].
+void Parser::ParseBracket(UnicodeSet &set) {
+  bool negate = false;
+  if (!AtEnd() && *cur_ == '^') {
+    negate = true;
+    ++cur_;
+  }
+  while (true) {
+    if (AtEnd()) Fail("Unterminated character class");
+    if (*cur_ == ']') {
+      ++cur_;
+      break;
+    }
+    UChar32 low;
+    if (*cur_ == '\\') {
+      if (cur_ + 1 == end_) Fail("Trailing backslash");
+      cur_ += 2;
+      if (Shorthand(cur_[-1], set)) continue;
+      low = static_cast<unsigned char>(ParseChar(cur_[-1])[0]);
+    } else {
+      low = NextUnit(cur_, end_, unicode_);
+    }
+    UChar32 high = low;
+    if (end_ - cur_ >= 2 && *cur_ == '-' && cur_[1] != ']') {
+      ++cur_;
+      if (*cur_ == '\\') {
+        if (cur_ + 1 == end_) Fail("Trailing backslash");
+        cur_ += 2;
+        high = static_cast<unsigned char>(ParseChar(cur_[-1])[0]);
+      } else {
+        high = NextUnit(cur_, end_, unicode_);
+      }
+      if (high < low) Fail("Bad range in character class");
+    }
+    set.add(low, high);
+  }
+  if (fold_) Fold(set);
+  if (negate) Complement(set);
+}
+
+void Parser::ParseReplacement(StringPiece replacement) {
+  Piece literal;
+  literal.capture = 0;
+  for (const char *i = replacement.data(), *end = replacement.data() + replacement.size(); i != end;) {
+    std::size_t group = 0;
+    if ((*i == '$' || *i == '\\') && i + 1 != end && isdigit(static_cast<unsigned char>(i[1]))) {
+      // $1 or \1
+      group = i[1] - '0';
+      i += 2;
+    } else if (*i == '$' && end - i >= 4 && i[1] == '{' && isdigit(static_cast<unsigned char>(i[2])) && i[3] == '}') {
+      group = i[2] - '0';
+      i += 4;
+    } else if (*i == '$') {
+      Fail("Unsupported variable in replacement");
+    } else if (*i == '\\' && i + 1 != end) {
+      literal.literal += ParseChar(i[1]);
+      i += 2;
+      continue;
+    } else {
+      literal.literal += *i++;
+      continue;
+    }
+    if (group == 0 || group > groups_) Fail("Replacement refers to a missing group");
+    if (!literal.literal.empty()) replacement_.push_back(literal);
+    literal.literal.clear();
+    Piece capture;
+    capture.capture = group;
+    replacement_.push_back(capture);
+  }
+  if (!literal.literal.empty()) replacement_.push_back(literal);
+}
+
+void Parser::Build(const std::vector<const std::vector<Atom>*> &choice, Rule &rule) const {
+  rule.captures.resize(groups_);
+  rule.fold = fold_;
+  rule.global = global_;
+  rule.begin = begin_;
+  rule.end = end_anchor_;
+  rule.replacement = replacement_;
+  rule.constant = true;
+  for (const Piece &piece : replacement_) {
+    if (piece.capture) rule.constant = false;
+    rule.constant_text += piece.literal;
+  }
+  // Literal items are merged unless a group starts or ends between them.
+  bool merge = false;
+  for (std::size_t g = 0; g < sequence_.size(); ++g) {
+    std::size_t capture = sequence_[g].capture;
+    if (capture) {
+      merge = false;
+      rule.captures[capture - 1].first = rule.items.size();
+    }
+    for (const Atom &atom : *choice[g]) {
+      std::string literal = atom.literal;
+      unsigned int min = atom.min, max = atom.max;
+      if (atom.cls && atom.cls->Single() != -1 && (min >= 1 || min == max)) {
+        // Required repetitions of a single character are literal, which gives
+        // the automaton something to find.
+        char encoded[U8_MAX_LENGTH];
+        int32_t length = 0;
+        if (unicode_) {
+          U8_APPEND_UNSAFE(encoded, length, atom.cls->Single());
+        } else {
+          encoded[length++] = static_cast<char>(atom.cls->Single());
+        }
+        for (unsigned int i = 0; i < min; ++i) literal.append(encoded, length);
+        max = (max == kUnbounded) ? kUnbounded : max - min;
+        min = 0;
+      }
+      if (!literal.empty()) {
+        if (merge && !rule.items.back().literal.empty()) {
+          rule.items.back().literal += literal;
+        } else {
+          rule.items.push_back(Item());
+          rule.items.back().literal = literal;
+        }
+        merge = true;
+      }
+      if (atom.cls && max) {
+        rule.items.push_back(Item());
+        Item &item = rule.items.back();
+        item.cls = atom.cls;
+        item.min = min;
+        item.max = max;
+        merge = false;
+      }
+    }
+    if (capture) {
+      merge = false;
+      rule.captures[capture - 1].second = rule.items.size();
+    }
+  }
+  std::size_t length = 0;
+  for (const Item &item : rule.items) {
+    length += item.literal.empty() ? item.min : item.literal.size();
+  }
+  if (!length) Fail("Pattern can match the empty string");
+  for (std::size_t i = 0; i < rule.items.size(); ++i) {
+    Item &item = rule.items[i];
+    if (item.literal.empty() && item.max != item.min && i + 1 < rule.items.size()) {
+      const Item &next = rule.items[i + 1];
+      if (!next.literal.empty()) {
+        item.backtrack = ClassHas(*item.cls, FirstUnit(next.literal, unicode_), fold_);
+      } else {
+        item.backtrack = !next.min || item.cls->Single() == -1 || next.cls->Contains(item.cls->Single());
+      }
+    }
+  }
+}
+
+void Parser::Expand(std::vector<Rule> &rules) {
+  std::vector<std::size_t> index(sequence_.size(), 0);
+  std::vector<const std::vector<Atom>*> choice(sequence_.size());
+  while (true) {
+    for (std::size_t g = 0; g < sequence_.size(); ++g) {
+      choice[g] = &sequence_[g].alternatives[index[g]];
+    }
+    rules.resize(rules.size() + 1);
+    Build(choice, rules.back());
+    // Odometer with the last group fastest.
+    std::size_t g = sequence_.size();
+    while (g && ++index[g - 1] == sequence_[g - 1].alternatives.size()) {
+      index[--g] = 0;
+    }
+    if (!g) return;
+  }
+}
+
+/* Pick the literal the automaton finds.  Items before it are matched backwards
+ * without backtracking, which agrees with Perl's leftmost match when every run
+ * before the anchor is first or follows a literal that it cannot match.  The
+ * anchor must not be matchable by those runs either, so a later anchor cannot
+ * produce a match that starts earlier.  Returns false if no literal qualifies.
+ */
+bool ChooseAnchor(Rule &rule, bool unicode) {
+  unsigned int best_score = 0;
+  for (std::size_t a = 0; a < rule.items.size(); ++a) {
+    const std::string &literal = rule.items[a].literal;
+    if (literal.empty()) continue;
+    UChar32 first = FirstUnit(literal, unicode);
+    bool valid = true;
+    for (std::size_t i = 0; i < a && valid; ++i) {
+      const Item &item = rule.items[i];
+      if (!item.literal.empty() || item.min == item.max) continue;
+      if (ClassHas(*item.cls, first, rule.fold)) valid = false;
+      if (i) {
+        const Item &before = rule.items[i - 1];
+        if (before.literal.empty() || ClassHas(*item.cls, LastUnit(before.literal, unicode), rule.fold)) valid = false;
+      }
+    }
+    if (!valid) continue;
+    unsigned int score = 0;
+    for (char c : literal) {
+      score += ByteScore(c);
+    }
+    if (score > best_score) {
+      best_score = score;
+      rule.anchor = a;
+    }
+  }
+  return best_score;
+}
+
+} // namespace
+
+/* Rules applied together in one pass over the text.  Either every rule has an
+ * anchor, found with one Aho-Corasick automaton, or the stage scans: it tries
+ * its rules at every position.
+ */
+class RewriteStage {
+  public:
+    RewriteStage(bool unicode, bool scan) : unicode_(unicode), scan_(scan), mergeable_(false), deletes_(false) {}
+
+    // Add the alternatives of one substitution.  Returns false if they must
+    // go in a new stage.
+    bool Merge(std::vector<Rule> &rules);
+
+    // Returns false and leaves out alone if no rule matched.
+    bool Apply(StringPiece text, std::string &out) const;
+
+  private:
+    struct Candidate {
+      const char *start, *anchor;
+      std::size_t rule;
+      // Offset of this match's item boundaries in the bounds array.
+      std::size_t bounds;
+
+      bool operator<(const Candidate &other) const {
+        if (start != other.start) return start < other.start;
+        if (rule != other.rule) return rule < other.rule;
+        return anchor < other.anchor;
+      }
+    };
+
+    void Build();
+
+    // Set first_ to the bytes that can begin a match of a scanning stage.
+    void BuildScanFirst();
+
+    // Match rule with its anchor at anchor and nothing before bound.  Sets
+    // bounds[i] to where item i starts and bounds[items] to the end.
+    bool Match(const Rule &rule, const char *anchor, const char *bound, const char *begin, const char *end, const char **bounds) const;
+
+    bool Forward(const Rule &rule, std::size_t item, const char *pos, const char *end, const char **bounds) const;
+
+    // Append the text since copied and the replacement of the match to out,
+    // clearing out first if nothing has changed yet.  Does nothing if the
+    // replacement is the matched text.
+    void Replace(const Rule &rule, const char *const *bounds, const char *&copied, bool &changed, std::string &out) const;
+
+    const bool unicode_;
+    const bool scan_;
+
+    std::vector<Rule> rules_;
+
+    // For deciding whether another substitution can join: whether all rules
+    // are global UTF-8 literals, the code points they match and write, and
+    // whether any deletes.
+    bool mergeable_;
+    std::set<UChar32> matches_, writes_;
+    bool deletes_;
+
+    // Automaton over bytes, ASCII lowercased if fold_.  State s goes to
+    // next_[s * 256 + byte]; outputs_[output_begin_[s], output_begin_[s+1])
+    // are the rules whose anchor ends there.
+    bool fold_;
+    std::vector<uint32_t> next_;
+    std::vector<uint32_t> output_begin_;
+    std::vector<uint32_t> outputs_;
+    // Bytes that begin an anchor or, when scanning, a match.  Text without
+    // them is skipped.
+    ByteSet first_;
+    // For the automaton, one byte of each anchor.  Text must have one of them.
+    ByteSet required_;
+    std::size_t max_items_;
+};
+
+bool RewriteStage::Merge(std::vector<Rule> &rules) {
+  bool mergeable = true, deletes = false, single = true;
+  std::set<UChar32> matches, writes;
+  for (const Rule &rule : rules) {
+    std::string whole;
+    for (const Item &item : rule.items) {
+      if (item.literal.empty()) mergeable = false;
+      whole += item.literal;
+    }
+    // Without g, a rule stops its pass after one replacement.
+    if (rule.begin || rule.end || !rule.global) mergeable = false;
+    if (!mergeable || !CodePoints(whole, rule.fold, matches)) {
+      mergeable = false;
+      break;
+    }
+    int32_t first = 0;
+    UChar32 c;
+    U8_NEXT(reinterpret_cast<const uint8_t*>(whole.data()), first, static_cast<int32_t>(whole.size()), c);
+    if (static_cast<std::size_t>(first) != whole.size()) single = false;
+    bool writes_something = false;
+    for (const Piece &piece : rule.replacement) {
+      if (!CodePoints(piece.literal, false, writes)) mergeable = false;
+      if (piece.capture || !piece.literal.empty()) writes_something = true;
+    }
+    if (!writes_something) deletes = true;
+  }
+  if (!rules_.empty()) {
+    if (scan_ || !mergeable_ || !mergeable) return false;
+    // Rules that touch different characters cannot see each other's effects,
+    // so matching them together agrees with applying them in order.  Deleting
+    // text can join its neighbors into a match of more than one character.
+    for (UChar32 c : matches) {
+      if (matches_.count(c) || writes_.count(c)) return false;
+    }
+    if (deletes_ && !single) return false;
+  } else {
+    mergeable_ = mergeable;
+  }
+  matches_.insert(matches.begin(), matches.end());
+  writes_.insert(writes.begin(), writes.end());
+  deletes_ = deletes_ || deletes;
+  rules_.insert(rules_.end(), rules.begin(), rules.end());
+  Build();
+  return true;
+}
+
+void RewriteStage::Build() {
+  max_items_ = 0;
+  fold_ = false;
+  for (const Rule &rule : rules_) {
+    max_items_ = std::max(max_items_, rule.items.size());
+    fold_ = fold_ || rule.fold;
+  }
+  if (scan_) {
+    BuildScanFirst();
+    return;
+  }
+
+  // Trie of the anchors.
+  next_.assign(256, 0);
+  std::vector<std::vector<uint32_t> > outputs(1);
+  bool first[256], required[256];
+  memset(first, 0, sizeof(first));
+  memset(required, 0, sizeof(required));
+  for (std::size_t r = 0; r < rules_.size(); ++r) {
+    const std::string &anchor = rules_[r].items[rules_[r].anchor].literal;
+    MarkByte(first, anchor[0], fold_);
+    // Every match has the rarest byte of its anchor; lines with none of
+    // these skip the stage.
+    char rarest = anchor[0];
+    for (char c : anchor) {
+      if (ByteScore(c) > ByteScore(rarest)) rarest = c;
+    }
+    MarkByte(required, rarest, fold_);
+    uint32_t state = 0;
+    for (char c : anchor) {
+      unsigned char byte = fold_ ? FoldASCII(c) : c;
+      if (!next_[state * 256 + byte]) {
+        next_[state * 256 + byte] = outputs.size();
+        outputs.resize(outputs.size() + 1);
+        next_.resize(next_.size() + 256, 0);
+      }
+      state = next_[state * 256 + byte];
+    }
+    outputs[state].push_back(r);
+  }
+  first_ = ByteSet(first);
+  required_ = ByteSet(required);
+
+  // Breadth-first to fill in failure transitions.
+  std::vector<uint32_t> fail(outputs.size(), 0);
+  std::vector<uint32_t> queue;
+  for (unsigned int byte = 0; byte < 256; ++byte) {
+    if (next_[byte]) queue.push_back(next_[byte]);
+  }
+  for (std::size_t q = 0; q < queue.size(); ++q) {
+    uint32_t state = queue[q];
+    for (unsigned int byte = 0; byte < 256; ++byte) {
+      uint32_t &to = next_[state * 256 + byte];
+      if (to) {
+        fail[to] = next_[fail[state] * 256 + byte];
+        outputs[to].insert(outputs[to].end(), outputs[fail[to]].begin(), outputs[fail[to]].end());
+        queue.push_back(to);
+      } else {
+        to = next_[fail[state] * 256 + byte];
+      }
+    }
+  }
+  if (fold_) {
+    for (std::size_t state = 0; state < outputs.size(); ++state) {
+      for (unsigned int upper = 'A'; upper <= 'Z'; ++upper) {
+        next_[state * 256 + upper] = next_[state * 256 + FoldASCII(upper)];
+      }
+    }
+  }
+  output_begin_.clear();
+  outputs_.clear();
+  for (const std::vector<uint32_t> &out : outputs) {
+    output_begin_.push_back(outputs_.size());
+    outputs_.insert(outputs_.end(), out.begin(), out.end());
+  }
+  output_begin_.push_back(outputs_.size());
+}
+
+void RewriteStage::BuildScanFirst() {
+  bool first[256];
+  memset(first, 0, sizeof(first));
+  for (const Rule &rule : rules_) {
+    // Items that may match nothing let the next one begin the match.
+    for (const Item &item : rule.items) {
+      if (!item.literal.empty()) {
+        MarkByte(first, item.literal[0], rule.fold);
+        break;
+      }
+      for (unsigned int byte = 0; byte < 256; ++byte) {
+        // Any non-ASCII byte may begin a code point, even an invalid one.
+        if ((byte >= 0x80 && unicode_) || item.cls->Contains(byte)) first[byte] = true;
+      }
+      if (item.min) break;
+    }
+  }
+  first_ = ByteSet(first);
+}
+
+bool RewriteStage::Forward(const Rule &rule, std::size_t item, const char *pos, const char *end, const char **bounds) const {
+  for (; item < rule.items.size(); ++item) {
+    bounds[item] = pos;
+    const Item &it = rule.items[item];
+    if (!it.literal.empty()) {
+      if (static_cast<std::size_t>(end - pos) < it.literal.size() || !LiteralAt(it.literal, pos, rule.fold)) return false;
+      pos += it.literal.size();
+      continue;
+    }
+    if (it.backtrack) {
+      // Try the longest run first, then give characters back like Perl.
+      std::vector<const char*> ends(1, pos);
+      for (const char *i = pos; ends.size() <= it.max && i != end;) {
+        if (!it.cls->Contains(NextUnit(i, end, unicode_))) break;
+        ends.push_back(i);
+      }
+      for (std::size_t count = ends.size(); count-- > it.min;) {
+        if (Forward(rule, item + 1, ends[count], end, bounds)) {
+          bounds[item] = pos;
+          return true;
+        }
+      }
+      return false;
+    }
+    unsigned int count = 0;
+    for (const char *i = pos; count < it.max && i != end; ++count) {
+      if (!it.cls->Contains(NextUnit(i, end, unicode_))) break;
+      pos = i;
+    }
+    if (count < it.min) return false;
+  }
+  bounds[rule.items.size()] = pos;
+  // Like Perl, $ also matches before a final newline.
+  return !rule.end || pos == end || (pos + 1 == end && *pos == '\n');
+}
+
+bool RewriteStage::Match(const Rule &rule, const char *anchor, const char *bound, const char *begin, const char *end, const char **bounds) const {
+  const char *pos = anchor;
+  for (std::size_t item = rule.anchor; item-- > 0;) {
+    const Item &it = rule.items[item];
+    if (!it.literal.empty()) {
+      if (static_cast<std::size_t>(pos - bound) < it.literal.size() || !LiteralAt(it.literal, pos - it.literal.size(), rule.fold)) return false;
+      pos -= it.literal.size();
+    } else {
+      unsigned int count = 0;
+      for (; count < it.max && pos > bound; ++count) {
+        const char *prev = pos;
+        if (!it.cls->Contains(PrevUnit(begin, prev, unicode_)) || prev < bound) break;
+        pos = prev;
+      }
+      if (count < it.min) return false;
+    }
+    bounds[item] = pos;
+  }
+  if (rule.begin && pos != begin) return false;
+  return Forward(rule, rule.anchor, anchor, end, bounds);
+}
+
+void RewriteStage::Replace(const Rule &rule, const char *const *bounds, const char *&copied, bool &changed, std::string &out) const {
+  const char *start = bounds[0], *stop = bounds[rule.items.size()];
+  if (rule.constant && rule.constant_text.size() == static_cast<std::size_t>(stop - start) && !memcmp(start, rule.constant_text.data(), stop - start)) return;
+  if (!changed) {
+    out.clear();
+    changed = true;
+  }
+  out.append(copied, start - copied);
+  for (const Piece &piece : rule.replacement) {
+    if (piece.capture) {
+      const std::pair<std::size_t, std::size_t> &span = rule.captures[piece.capture - 1];
+      out.append(bounds[span.first], bounds[span.second] - bounds[span.first]);
+    } else {
+      out += piece.literal;
+    }
+  }
+  copied = stop;
+}
+
+bool RewriteStage::Apply(StringPiece text, std::string &out) const {
+  const char *const begin = text.data(), *const end = text.data() + text.size();
+  if ((scan_ ? first_ : required_).Find(begin, end) == end) return false;
+  std::vector<const char*> bounds;
+  // Text up to here is in out.
+  const char *copied = begin;
+  bool changed = false;
+  if (scan_) {
+    bounds.resize(max_items_ + 1);
+    for (const char *pos = begin; (pos = first_.Find(pos, end)) != end;) {
+      bool matched = false;
+      for (const Rule &rule : rules_) {
+        if ((!rule.begin || pos == begin) && Forward(rule, 0, pos, end, &bounds[0])) {
+          matched = true;
+          Replace(rule, &bounds[0], copied, changed, out);
+          pos = bounds[rule.items.size()];
+          if (!rule.global) pos = end;
+          break;
+        }
+      }
+      if (!matched) NextUnit(pos, end, unicode_);
+    }
+  } else {
+    std::vector<Candidate> candidates;
+    uint32_t state = 0;
+    for (const char *i = begin; i != end; ++i) {
+      // From the root, only a byte that begins an anchor goes anywhere.
+      if (!state && (i = first_.Find(i, end)) == end) break;
+      state = next_[state * 256 + static_cast<unsigned char>(*i)];
+      for (uint32_t o = output_begin_[state]; o != output_begin_[state + 1]; ++o) {
+        const Rule &rule = rules_[outputs_[o]];
+        const std::string &literal = rule.items[rule.anchor].literal;
+        Candidate c;
+        c.anchor = i + 1 - literal.size();
+        // The automaton folds case if any rule in the stage does.
+        if (fold_ && !rule.fold && memcmp(c.anchor, literal.data(), literal.size())) continue;
+        c.rule = outputs_[o];
+        c.bounds = bounds.size();
+        bounds.resize(bounds.size() + rule.items.size() + 1);
+        if (!Match(rule, c.anchor, begin, begin, end, &bounds[c.bounds])) {
+          bounds.resize(c.bounds);
+          continue;
+        }
+        c.start = bounds[c.bounds];
+        candidates.push_back(c);
+      }
+    }
+    // Leftmost first, then in Perl's order of alternatives.
+    std::sort(candidates.begin(), candidates.end());
+    const char *cursor = begin;
+    for (const Candidate &c : candidates) {
+      if (c.anchor < cursor) continue;
+      const Rule &rule = rules_[c.rule];
+      const char **match = &bounds[c.bounds];
+      // A run before the anchor may still match from the end of the last
+      // match, as Perl resumes there.
+      if (c.start < cursor && !Match(rule, c.anchor, cursor, begin, end, match)) continue;
+      Replace(rule, match, copied, changed, out);
+      cursor = match[rule.items.size()];
+      if (!rule.global) break;
+    }
+  }
+  if (changed) out.append(copied, end - copied);
+  return changed;
+}
+
+RewriteRules::RewriteRules(Mode mode) : mode_(mode) {}
+
+RewriteRules::~RewriteRules() {}
+
+void RewriteRules::Add(StringPiece substitution) {
+  const bool unicode = mode_ == kUnicode;
+  Parser parser(substitution, unicode, classes_);
+  std::vector<Rule> rules;
+  parser.Expand(rules);
+  bool scan = false;
+  for (Rule &rule : rules) {
+    rule.anchor = 0;
+    if (!ChooseAnchor(rule, unicode)) scan = true;
+  }
+  if (scan) {
+    for (Rule &rule : rules) rule.anchor = 0;
+  }
+  if (scan || stages_.empty() || !stages_.back()->Merge(rules)) {
+    stages_.push_back(std::unique_ptr<RewriteStage>(new RewriteStage(unicode, scan)));
+    stages_.back()->Merge(rules);
+  }
+}
+
+void RewriteRules::Apply(std::string &text, std::string &scratch) const {
+  for (const std::unique_ptr<RewriteStage> &stage : stages_) {
+    if (stage->Apply(text, scratch)) text.swap(scratch);
+  }
+}
+
+} // namespace util
@@ -0,0 +1,70 @@
+#ifndef UTIL_REWRITE_RULES_H
+#define UTIL_REWRITE_RULES_H
+
+/* Perl-style s/pattern/replacement/ rules without a regex engine, for ports of
+ * normalization scripts that are long lists of substitutions.
+ *
+ * Patterns are the subset those scripts use: literal text, character classes
+ * (\s \S \d \D . and [...]) with * + ? {n,m}, capturing groups whose
+ * alternatives are sequences of those, ^ and $.  Flags are g and i.  Unlike
+ * Perl, i does no multi-character folds, so "ss" misses "\u00DF"; in byte
+ * mode it only folds ASCII, as Perl does on byte strings.  Each alternative
+ * becomes its own rule, tried in Perl's order.
+ *
+ * A rule is located by its most distinctive literal, found with an
+ * Aho-Corasick automaton; the classes around it are checked as guards.  Rules
+ * with no usable literal are tried at every position.  Consecutive rules of
+ * plain literal text share one automaton, and so one pass, when they cannot
+ * interact: neither can match characters the other matches or writes.  The
+ * result is the same as applying the rules one after another as Perl does.
+ */
+
+#include "util/string_piece.hh"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace util {
+
+class CharClass;
+class RewriteStage;
+
+class RewriteRules {
+  public:
+    enum Mode {
+      // Classes match bytes and only know ASCII, like Perl on byte strings.
+      kBytes,
+      // Classes match UTF-8 code points with Unicode properties, like Perl
+      // under use utf8 and :utf8 I/O.
+      kUnicode
+    };
+
+    explicit RewriteRules(Mode mode);
+
+    ~RewriteRules();
+
+    // Append a rule written as in Perl, e.g. "s/(\\d) \\%/$1\\%/g".  Throws
+    // util::Exception for syntax outside the subset above.
+    void Add(StringPiece substitution);
+
+    // Apply every rule in order.  scratch is working space.
+    void Apply(std::string &text, std::string &scratch) const;
+
+    // Number of passes over the text Apply may make.
+    std::size_t Passes() const { return stages_.size(); }
+
+  private:
+    RewriteRules(const RewriteRules &) = delete;
+    RewriteRules &operator=(const RewriteRules &) = delete;
+
+    const Mode mode_;
+
+    std::vector<std::unique_ptr<CharClass> > classes_;
+    std::vector<std::unique_ptr<RewriteStage> > stages_;
+};
+
+} // namespace util
+
+#endif // UTIL_REWRITE_RULES_H
@@ -0,0 +1,99 @@
+#include "util/rewrite_rules.hh"
+#include "util/exception.hh"
+
+#define BOOST_TEST_MODULE RewriteRulesTest
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+namespace util {
+namespace {
+
+std::string Run(const RewriteRules &rules, const char *text) {
+  std::string str(text), scratch;
+  rules.Apply(str, scratch);
+  return str;
+}
+
+BOOST_AUTO_TEST_CASE(literal) {
+  RewriteRules rules(RewriteRules::kBytes);
+  rules.Add("s/ dlrs / \\$ /g");
+  BOOST_CHECK_EQUAL(" $ and $ ", Run(rules, " dlrs and dlrs "));
+  BOOST_CHECK_EQUAL(" dlrs", Run(rules, " dlrs"));
+}
+
+BOOST_AUTO_TEST_CASE(not_global) {
+  RewriteRules rules(RewriteRules::kBytes);
+  rules.Add("s/a/b/");
+  BOOST_CHECK_EQUAL("xbaa", Run(rules, "xaaa"));
+}
+
+BOOST_AUTO_TEST_CASE(captures) {
+  RewriteRules rules(RewriteRules::kBytes);
+  rules.Add("s/(\\d) \\%/$1\\%/g");
+  rules.Add("s/([^-])--+([^-])/$1 - ${2}/g");
+  BOOST_CHECK_EQUAL("5% and 6%", Run(rules, "5 % and 6 %"));
+  BOOST_CHECK_EQUAL("a - b--c x - y", Run(rules, "a--b--c x----y"));
+}
+
+// Neighbouring matches must not share characters, as in Perl.
+BOOST_AUTO_TEST_CASE(leftmost) {
+  RewriteRules rules(RewriteRules::kBytes);
+  rules.Add("s/(\\D)\\+/$1 +/g");
+  BOOST_CHECK_EQUAL("a ++b", Run(rules, "a++b"));
+}
+
+BOOST_AUTO_TEST_CASE(backtrack) {
+  RewriteRules rules(RewriteRules::kBytes);
+  rules.Add("s/(\\.+)\"(\\s*[^<])/\"$1$2/g");
+  BOOST_CHECK_EQUAL("end\".\n", Run(rules, "end.\"\n"));
+  BOOST_CHECK_EQUAL("\"...  x", Run(rules, "...\"  x"));
+}
+
+BOOST_AUTO_TEST_CASE(alternatives) {
+  RewriteRules rules(RewriteRules::kUnicode);
+  rules.Add("s/ (s|at) & (t|p) / $1&$2 /ig");
+  rules.Add("s/ (vis|viz) - (.|..) - (vis|viz) / vis-\xC3\xA0-vis /ig");
+  BOOST_CHECK_EQUAL(" AT&T and S&p ", Run(rules, " AT & T and S & p "));
+  BOOST_CHECK_EQUAL(" vis-\xC3\xA0-vis ", Run(rules, " viz - \xC3\xA0 - VIS "));
+}
+
+BOOST_AUTO_TEST_CASE(unicode_fold) {
+  RewriteRules rules(RewriteRules::kUnicode);
+  rules.Add("s/ \xC3\xA9lite / elite /gi");
+  BOOST_CHECK_EQUAL(" elite  elite ", Run(rules, " \xC3\x89LITE  \xC3\xA9lite "));
+  // The space between is consumed by the first match.
+  BOOST_CHECK_EQUAL(" elite \xC3\xA9lite ", Run(rules, " \xC3\xA9lite \xC3\xA9lite "));
+}
+
+BOOST_AUTO_TEST_CASE(anchors) {
+  RewriteRules rules(RewriteRules::kUnicode);
+  rules.Add("s/\\s+/ /g");
+  rules.Add("s/^\\s+//");
+  rules.Add("s/\\s+$//");
+  BOOST_CHECK_EQUAL("a b", Run(rules, " \t a \xE2\x80\x83 b  "));
+}
+
+// Literal rules on distinct characters share a pass; rules that could see each
+// other's output do not.
+BOOST_AUTO_TEST_CASE(merge) {
+  RewriteRules rules(RewriteRules::kBytes);
+  rules.Add("s/\\(/ \\(/g");
+  rules.Add("s/\\)/\\) /g");
+  BOOST_CHECK_EQUAL(1U, rules.Passes());
+  rules.Add("s/ \\)/\\)/g");
+  BOOST_CHECK_EQUAL(2U, rules.Passes());
+  BOOST_CHECK_EQUAL("a (b) c", Run(rules, "a(b )c"));
+}
+
+BOOST_AUTO_TEST_CASE(unsupported) {
+  RewriteRules rules(RewriteRules::kBytes);
+  BOOST_CHECK_THROW(rules.Add("s/(a(b))/c/"), util::Exception);
+  BOOST_CHECK_THROW(rules.Add("s/a*/b/g"), util::Exception);
+  BOOST_CHECK_THROW(rules.Add("s/a/$2/g"), util::Exception);
+  BOOST_CHECK_THROW(rules.Add("s/a+?/b/g"), util::Exception);
+  BOOST_CHECK_THROW(rules.Add("s/a/b/e"), util::Exception);
+}
+
+} // namespace
+} // namespace util
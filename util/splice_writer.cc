@@ -0,0 +1,108 @@
+#include "util/splice_writer.hh"
+
+#include "util/exception.hh"
+#include "util/file.hh"
+#include "util/trace.hh"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#endif
+
+namespace util {
+
+std::size_t SetPipeSize(int fd, std::size_t size) {
+#if defined(__linux__) && defined(F_SETPIPE_SZ)
+  int ret = fcntl(fd, F_SETPIPE_SZ, static_cast<int>(size));
+  if (ret != -1) return ret;
+  if (errno == EPERM) {
+    // Over the unprivileged limit; settle for the limit.
+    try {
+      scoped_fd limit_file(OpenReadOrThrow("/proc/sys/fs/pipe-max-size"));
+      char buf[32];
+      std::size_t got = ReadOrEOF(limit_file.get(), buf, sizeof(buf) - 1);
+      buf[got] = 0;
+      unsigned long limit = strtoul(buf, NULL, 10);
+      if (limit && limit < size && (ret = fcntl(fd, F_SETPIPE_SZ, static_cast<int>(limit))) != -1) return ret;
+    } catch (const util::Exception &) {}
+  }
+  ret = fcntl(fd, F_GETPIPE_SZ);
+  return ret == -1 ? 0 : ret;
+#else
+  return 0;
+#endif
+}
+
+SpliceWriter::SpliceWriter(int fd, bool splice) : fd_(fd), splice_(false), written_(0) {
+#if defined(__linux__)
+  struct stat info;
+  splice_ = splice && !fstat(fd, &info) && S_ISFIFO(info.st_mode);
+#endif
+}
+
+SpliceWriter::~SpliceWriter() {
+#if defined(__linux__)
+  // The pipe still points into held_; wait for the reader to empty it.  There
+  // is no event for that, so poll with a backoff up to 100 ms.
+  for (int wait_ms = 1; !held_.empty(); wait_ms = std::min(wait_ms * 2, 100)) {
+    Release();
+    if (held_.empty()) break;
+    struct pollfd poll_fd;
+    poll_fd.fd = fd_;
+    poll_fd.events = 0;
+    // POLLERR means the reader closed, so nobody will look at the memory.
+    if (poll(&poll_fd, 1, wait_ms) == 1 && (poll_fd.revents & (POLLERR | POLLNVAL))) break;
+  }
+#endif
+}
+
+void SpliceWriter::Write(std::string &data) {
+  UTIL_TRACE_SPAN("SpliceWriter write");
+#if defined(__linux__)
+  if (splice_ && data.size() >= kMinSplice) {
+    struct iovec vec;
+    vec.iov_base = &data[0];
+    vec.iov_len = data.size();
+    while (vec.iov_len) {
+      ssize_t ret = vmsplice(fd_, &vec, 1, 0);
+      if (ret == -1) {
+        UTIL_THROW_IF_ARG(errno != EINTR, FDException, (fd_), "vmsplice of " << vec.iov_len << " bytes failed");
+        continue;
+      }
+      vec.iov_base = static_cast<char*>(vec.iov_base) + ret;
+      vec.iov_len -= ret;
+    }
+    written_ += data.size();
+    held_.resize(held_.size() + 1);
+    held_.back().data.swap(data);
+    held_.back().end = written_;
+    Release();
+    data.clear();
+    return;
+  }
+#endif
+  WriteOrThrow(fd_, data.data(), data.size());
+  written_ += data.size();
+  data.clear();
+}
+
+void SpliceWriter::Release() {
+#if defined(__linux__)
+  if (held_.empty()) return;
+  int unread;
+  UTIL_THROW_IF_ARG(ioctl(fd_, FIONREAD, &unread), FDException, (fd_), "FIONREAD on pipe");
+  uint64_t consumed = written_ - static_cast<uint64_t>(unread);
+  while (!held_.empty() && held_.front().end <= consumed) {
+    held_.pop_front();
+  }
+#endif
+}
+
+} // namespace util
@@ -0,0 +1,71 @@
+#ifndef UTIL_SPLICE_WRITER_H
+#define UTIL_SPLICE_WRITER_H
+
+#include <cstddef>
+#include <deque>
+#include <string>
+
+#include <stdint.h>
+
+namespace util {
+
+// Default for SetPipeSize: room for a few large records.
+const std::size_t kPipeSize = 1 << 20;
+
+/* Ask the kernel to grow a pipe's buffer to size bytes with F_SETPIPE_SZ.
+ * Best effort: returns the resulting size, or 0 if the size is unknown (not
+ * Linux, or not a pipe).  Unprivileged processes are capped at
+ * /proc/sys/fs/pipe-max-size, in which case the pipe is grown to that.
+ */
+std::size_t SetPipeSize(int fd, std::size_t size);
+
+/* Writes strings to a pipe.  If splice is set, large strings are handed to the
+ * kernel with vmsplice instead of being copied into the pipe.  The pipe then
+ * refers to the string's memory, so Write takes the string (leaving the caller
+ * an empty one) and holds on to it until the reader has consumed it.
+ *
+ * Consumed is judged by FIONREAD, which only shows the data has left this
+ * pipe.  If the reader passes its input on with splice or tee, the pages are
+ * still referenced downstream after the string is freed and reused, which
+ * corrupts what the next process sees.  So only set splice when the reader is
+ * known to read or copy its input.
+ *
+ * Without splice, if fd is not a pipe, or on other platforms, this is write.
+ */
+class SpliceWriter {
+  public:
+    // Strings shorter than this are copied with write.
+    static const std::size_t kMinSplice = 1 << 16;
+
+    explicit SpliceWriter(int fd, bool splice = false);
+
+    /* Waits for the reader to consume everything spliced, so it blocks for as
+     * long as the reader stalls, unless the reader closes the pipe.  Does not
+     * close fd.
+     */
+    ~SpliceWriter();
+
+    // Swaps the contents of data out.
+    void Write(std::string &data);
+
+  private:
+    // Free strings the reader has consumed.
+    void Release();
+
+    int fd_;
+    bool splice_;
+
+    // Total bytes written to the pipe.
+    uint64_t written_;
+
+    struct Held {
+      std::string data;
+      // Value of written_ after data.
+      uint64_t end;
+    };
+    std::deque<Held> held_;
+};
+
+} // namespace util
+
+#endif // UTIL_SPLICE_WRITER_H
@@ -0,0 +1,58 @@
+#define BOOST_TEST_MODULE SpliceWriterTest
+
+#include "util/splice_writer.hh"
+#include "util/file.hh"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+namespace util { namespace {
+
+void ReadAll(int fd, std::string *to) {
+  char buf[4096];
+  std::size_t got;
+  while ((got = ReadOrEOF(fd, buf, sizeof(buf)))) {
+    to->append(buf, got);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Pipe) {
+  int fds[2];
+  BOOST_REQUIRE(!pipe(fds));
+  scoped_fd read_end(fds[0]), write_end(fds[1]);
+  SetPipeSize(write_end.get(), kPipeSize);
+  std::string got;
+  std::thread reader(ReadAll, read_end.get(), &got);
+  std::string expect;
+  {
+    SpliceWriter writer(write_end.get(), true);
+    std::string data;
+    for (unsigned i = 0; i < 50; ++i) {
+      // Alternate between copied and spliced sizes.
+      data.assign((i % 3) * SpliceWriter::kMinSplice + i, 'a' + i % 26);
+      expect += data;
+      writer.Write(data);
+      BOOST_CHECK(data.empty());
+    }
+  }
+  write_end.reset();
+  reader.join();
+  BOOST_CHECK_EQUAL(expect.size(), got.size());
+  BOOST_CHECK(expect == got);
+}
+
+BOOST_AUTO_TEST_CASE(File) {
+  scoped_fd file(MakeTemp("splice_writer_test"));
+  std::string data(3 * SpliceWriter::kMinSplice, 'x');
+  {
+    SpliceWriter writer(file.get(), true);
+    writer.Write(data);
+  }
+  BOOST_CHECK_EQUAL(3 * SpliceWriter::kMinSplice, SizeOrThrow(file.get()));
+}
+
+}} // namespaces
@@ -0,0 +1,100 @@
+#include "util/stats.hh"
+
+#include "util/exception.hh"
+#include "util/file.hh"
+#include "util/string_stream.hh"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace util {
+
+Stats::Stats() : start_(std::chrono::steady_clock::now()), stop_(false) {}
+
+Stats::~Stats() {
+  if (!reporter_.joinable()) return;
+  {
+    std::lock_guard<std::mutex> lock(stop_mutex_);
+    stop_ = true;
+  }
+  stop_cond_.notify_one();
+  reporter_.join();
+  try {
+    Write();
+  } catch (const std::exception &e) {
+    std::cerr << "Could not write final statistics: " << e.what() << std::endl;
+  }
+}
+
+StatsCounter &Stats::Counter(const std::string &name) {
+  std::lock_guard<std::mutex> lock(counters_mutex_);
+  for (std::deque<Named>::iterator i = counters_.begin(); i != counters_.end(); ++i) {
+    if (i->name == name) return i->counter;
+  }
+  counters_.emplace_back(name);
+  return counters_.back().counter;
+}
+
+void Stats::Snapshot(std::string &out) const {
+  StringStream stream;
+  stream << "{\"elapsed\":" << std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+  {
+    std::lock_guard<std::mutex> lock(counters_mutex_);
+    for (std::deque<Named>::const_iterator i = counters_.begin(); i != counters_.end(); ++i) {
+      stream << ",\"";
+      // Names are chosen by programmers, but keep the output valid JSON anyway.
+      for (std::string::const_iterator c = i->name.begin(); c != i->name.end(); ++c) {
+        if (*c == '"' || *c == '\\') stream << '\\';
+        stream << *c;
+      }
+      stream << "\":" << i->counter.Get();
+    }
+  }
+  stream << "}\n";
+  out += stream.str();
+}
+
+void Stats::Report(int fd, double interval) {
+  UTIL_THROW_IF2(reporter_.joinable(), "Statistics are already being reported");
+  report_.reset(fd);
+  reporter_ = std::thread(&Stats::ReportThread, this, interval);
+}
+
+void Stats::ReportFromEnvironment() {
+  const char *to = getenv("PREPROCESS_STATS");
+  if (!to || !*to) return;
+  double interval = 10.0;
+  if (const char *interval_str = getenv("PREPROCESS_STATS_INTERVAL")) {
+    char *end;
+    interval = strtod(interval_str, &end);
+    UTIL_THROW_IF2(*end || interval <= 0.0, "PREPROCESS_STATS_INTERVAL should be a positive number of seconds, not " << interval_str);
+  }
+  char *end;
+  long fd = strtol(to, &end, 10);
+  if (!*end && fd >= 0) {
+    // Duplicate so closing ours does not close the caller's.
+    Report(DupOrThrow(static_cast<int>(fd)), interval);
+  } else {
+    Report(CreateOrThrow(to), interval);
+  }
+}
+
+void Stats::ReportThread(double interval) {
+  std::unique_lock<std::mutex> lock(stop_mutex_);
+  while (!stop_cond_.wait_for(lock, std::chrono::duration<double>(interval), [this] { return stop_; })) {
+    try {
+      Write();
+    } catch (const std::exception &e) {
+      std::cerr << "Could not write statistics: " << e.what() << std::endl;
+      return;
+    }
+  }
+}
+
+void Stats::Write() {
+  std::string line;
+  Snapshot(line);
+  WriteOrThrow(report_.get(), line.data(), line.size());
+}
+
+} // namespace util
@@ -0,0 +1,140 @@
+#ifndef UTIL_STATS_H
+#define UTIL_STATS_H
+
+#include "util/file.hh"
+#include "util/string_piece.hh"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <stdint.h>
+
+/* Counters and timers for instrumenting tools.  Counters are registered by
+ * name and can be updated from any thread.  Snapshots are written as JSON
+ * lines like
+ * {"elapsed":1.5,"lines_read":1000,"bytes_read":43210}
+ * so throughput and drop reasons can be followed while a job runs.
+ */
+
+namespace util {
+
+class StatsCounter {
+  public:
+    StatsCounter() : value_(0) {}
+
+    void Add(uint64_t amount) { value_.fetch_add(amount, std::memory_order_relaxed); }
+
+    StatsCounter &operator++() {
+      Add(1);
+      return *this;
+    }
+
+    StatsCounter &operator+=(uint64_t amount) {
+      Add(amount);
+      return *this;
+    }
+
+    // For gauges like hash table size or queue depth.
+    void Set(uint64_t to) { value_.store(to, std::memory_order_relaxed); }
+
+    uint64_t Get() const { return value_.load(std::memory_order_relaxed); }
+
+  private:
+    std::atomic<uint64_t> value_;
+};
+
+// Adds the wall time of its lifetime, in nanoseconds, to a counter.
+class StatsTimer {
+  public:
+    explicit StatsTimer(StatsCounter &to) : to_(to), start_(std::chrono::steady_clock::now()) {}
+
+    ~StatsTimer() {
+      to_ += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count();
+    }
+
+  private:
+    StatsCounter &to_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+class Stats {
+  public:
+    Stats();
+
+    // Stops reporting after writing a final snapshot.
+    ~Stats();
+
+    // Find or create the counter with this name.  The reference is valid for
+    // the lifetime of Stats.  Call this outside inner loops.
+    StatsCounter &Counter(const std::string &name);
+
+    // Append a JSON line with every counter to out.
+    void Snapshot(std::string &out) const;
+
+    // Write a snapshot to fd every interval seconds on a background thread and
+    // once more on destruction.  Takes ownership of fd.
+    void Report(int fd, double interval);
+
+    /* Report if the PREPROCESS_STATS environment variable is set.  Its value
+     * is a file to write to or, if it is a number, a file descriptor.
+     * PREPROCESS_STATS_INTERVAL sets the interval in seconds (default 10).
+     */
+    void ReportFromEnvironment();
+
+  private:
+    void ReportThread(double interval);
+
+    void Write();
+
+    struct Named {
+      explicit Named(const std::string &name_in) : name(name_in) {}
+      std::string name;
+      StatsCounter counter;
+    };
+
+    // deque does not move existing elements on push_back.
+    std::deque<Named> counters_;
+    mutable std::mutex counters_mutex_;
+
+    const std::chrono::steady_clock::time_point start_;
+
+    scoped_fd report_;
+    std::thread reporter_;
+    std::mutex stop_mutex_;
+    std::condition_variable stop_cond_;
+    bool stop_;
+};
+
+/* The counters every line-oriented tool keeps: lines_read, bytes_read,
+ * lines_written and bytes_written.  Bytes include the newline.  Copies made
+ * from the same Stats share counters, so a reader and writer thread can each
+ * have one.
+ */
+class LineCounters {
+  public:
+    explicit LineCounters(Stats &stats)
+      : lines_read_(stats.Counter("lines_read")), bytes_read_(stats.Counter("bytes_read")),
+        lines_written_(stats.Counter("lines_written")), bytes_written_(stats.Counter("bytes_written")) {}
+
+    void Read(StringPiece line) {
+      ++lines_read_;
+      bytes_read_ += line.size() + 1;
+    }
+
+    void Wrote(StringPiece line) {
+      ++lines_written_;
+      bytes_written_ += line.size() + 1;
+    }
+
+  private:
+    StatsCounter &lines_read_, &bytes_read_, &lines_written_, &bytes_written_;
+};
+
+} // namespace util
+
+#endif // UTIL_STATS_H
@@ -0,0 +1,85 @@
+#define BOOST_TEST_MODULE StatsTest
+#include "util/stats.hh"
+
+#include "util/file.hh"
+#include "util/file_piece.hh"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace util { namespace {
+
+BOOST_AUTO_TEST_CASE(SameName) {
+  Stats stats;
+  StatsCounter &first = stats.Counter("lines");
+  BOOST_CHECK_EQUAL(&first, &stats.Counter("lines"));
+  BOOST_CHECK(&first != &stats.Counter("bytes"));
+}
+
+BOOST_AUTO_TEST_CASE(Snapshot) {
+  Stats stats;
+  stats.Counter("lines_read") += 3;
+  ++stats.Counter("dropped \"bad\"");
+  stats.Counter("queue_depth").Set(7);
+  std::string line;
+  stats.Snapshot(line);
+  BOOST_REQUIRE(!line.empty());
+  BOOST_CHECK_EQUAL('\n', line[line.size() - 1]);
+  BOOST_CHECK_EQUAL(0, line.find("{\"elapsed\":"));
+  BOOST_CHECK(line.find(",\"lines_read\":3,\"dropped \\\"bad\\\"\":1,\"queue_depth\":7}\n") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(Lines) {
+  Stats stats;
+  LineCounters counters(stats), other(stats);
+  counters.Read("hello");
+  counters.Read("");
+  other.Wrote("hello");
+  BOOST_CHECK_EQUAL(2U, stats.Counter("lines_read").Get());
+  BOOST_CHECK_EQUAL(7U, stats.Counter("bytes_read").Get());
+  BOOST_CHECK_EQUAL(1U, stats.Counter("lines_written").Get());
+  BOOST_CHECK_EQUAL(6U, stats.Counter("bytes_written").Get());
+}
+
+BOOST_AUTO_TEST_CASE(Threads) {
+  Stats stats;
+  StatsCounter &counter = stats.Counter("count");
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.push_back(std::thread([&counter] {
+      for (int i = 0; i < 10000; ++i) ++counter;
+    }));
+  }
+  for (std::thread &t : threads) t.join();
+  BOOST_CHECK_EQUAL(40000U, counter.Get());
+}
+
+BOOST_AUTO_TEST_CASE(Timer) {
+  StatsCounter counter;
+  {
+    StatsTimer timer(counter);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  BOOST_CHECK(counter.Get() >= 2000000);
+}
+
+BOOST_AUTO_TEST_CASE(ReportFinal) {
+  scoped_fd file(MakeTemp(DefaultTempDirectory() + "stats"));
+  {
+    Stats stats;
+    stats.Counter("lines") += 2;
+    // Long interval: only the final snapshot is written.
+    stats.Report(DupOrThrow(file.get()), 3600.0);
+  }
+  SeekOrThrow(file.get(), 0);
+  FilePiece in(file.release());
+  StringPiece line = in.ReadLine();
+  BOOST_CHECK(line.size() > 10);
+  BOOST_CHECK_EQUAL(",\"lines\":2}", StringPiece(line.data() + line.size() - 11, 11));
+  BOOST_CHECK_THROW(in.ReadLine(), EndOfFileException);
+}
+
+}} // namespaces
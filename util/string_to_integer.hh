@@ -0,0 +1,68 @@
+#ifndef UTIL_STRING_TO_INTEGER_H
+#define UTIL_STRING_TO_INTEGER_H
+
+/* Parse unsigned decimal integers, the inverse of ToString.  On little-endian
+ * machines with at least 8 readable bytes, up to 8 digits are converted at a
+ * time with SWAR (SIMD within a register) arithmetic instead of one by one.
+ */
+
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+#include <stdint.h>
+
+namespace util {
+
+namespace detail {
+const uint64_t kDecimalPowers[9] = {1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL};
+
+// Convert 8 bytes of digit values 0-9, most significant first in memory.
+inline uint64_t EightDigits(uint64_t chunk) {
+  chunk = (chunk * 10) + (chunk >> 8);
+  chunk = (((chunk & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) + (((chunk >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+  return chunk;
+}
+} // namespace detail
+
+/* Parse the digits at the start of [begin, end) into out.  Returns the end of
+ * the digits, which is begin if there are none, or NULL if the value does not
+ * fit in 64 bits.  No signs or spaces.
+ */
+inline const char *ParseDecimal(const char *begin, const char *end, uint64_t &out) {
+  uint64_t value = 0;
+  const char *i = begin;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  // At most 16 digits this way, so value cannot overflow.
+  while (end - i >= 8 && i - begin <= 8) {
+    uint64_t chunk;
+    std::memcpy(&chunk, i, 8);
+    // A byte is a digit if its high nibble is 3 and adding 6 keeps it so.
+    uint64_t non_digit = ((chunk & 0xF0F0F0F0F0F0F0F0ULL) ^ 0x3030303030303030ULL) | (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) ^ 0x3030303030303030ULL);
+    unsigned digits = non_digit ? __builtin_ctzll(non_digit) / 8 : 8;
+    if (!digits) {
+      out = value;
+      return i;
+    }
+    // Shifting out the non-digits also discards any borrows they caused.
+    chunk = (chunk - 0x3030303030303030ULL) << (8 * (8 - digits));
+    value = value * detail::kDecimalPowers[digits] + detail::EightDigits(chunk);
+    i += digits;
+    if (digits != 8) {
+      out = value;
+      return i;
+    }
+  }
+#endif
+  for (; i != end && *i >= '0' && *i <= '9'; ++i) {
+    uint64_t digit = *i - '0';
+    if (value > (std::numeric_limits<uint64_t>::max() - digit) / 10) return NULL;
+    value = value * 10 + digit;
+  }
+  out = value;
+  return i;
+}
+
+} // namespace util
+
+#endif // UTIL_STRING_TO_INTEGER_H
@@ -0,0 +1,64 @@
+#include "util/string_to_integer.hh"
+#include "util/integer_to_string.hh"
+#include "util/string_piece.hh"
+
+#define BOOST_TEST_MODULE StringToIntegerTest
+#include <boost/test/unit_test.hpp>
+
+#include <limits>
+#include <string>
+
+namespace util {
+namespace {
+
+// Parse value written by ToString followed by suffix.
+void TestValue(uint64_t value, const std::string &suffix) {
+  char buf[ToStringBuf<uint64_t>::kBytes];
+  std::string str(buf, ToString(value, buf) - buf);
+  std::size_t digits = str.size();
+  str += suffix;
+  uint64_t out;
+  const char *end = ParseDecimal(str.data(), str.data() + str.size(), out);
+  BOOST_REQUIRE(end);
+  BOOST_CHECK_EQUAL(value, out);
+  BOOST_CHECK_EQUAL(digits, static_cast<std::size_t>(end - str.data()));
+}
+
+void TestSuffixes(uint64_t value) {
+  TestValue(value, "");
+  TestValue(value, " ");
+  TestValue(value, "\tabcdefghijklmnop");
+  TestValue(value, "/");
+  TestValue(value, ":0123456789");
+}
+
+BOOST_AUTO_TEST_CASE(Tens) {
+  for (uint64_t i = 1; i < std::numeric_limits<uint64_t>::max() / 10; i *= 10) {
+    TestSuffixes(i - 1);
+    TestSuffixes(i);
+    TestSuffixes(i + 1);
+  }
+  TestSuffixes(std::numeric_limits<uint64_t>::max());
+}
+
+BOOST_AUTO_TEST_CASE(Small) {
+  for (uint64_t i = 0; i < 100000; ++i) {
+    TestValue(i, " 1234567");
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Invalid) {
+  uint64_t out;
+  StringPiece empty;
+  BOOST_CHECK(empty.data() == ParseDecimal(empty.data(), empty.data(), out));
+  StringPiece letters("abcdefghijk");
+  BOOST_CHECK(letters.data() == ParseDecimal(letters.data(), letters.data() + letters.size(), out));
+  StringPiece overflow("18446744073709551616");
+  BOOST_CHECK(!ParseDecimal(overflow.data(), overflow.data() + overflow.size(), out));
+  StringPiece zeros("00000000000000000000000000042 ");
+  BOOST_CHECK_EQUAL(zeros.data() + 29, ParseDecimal(zeros.data(), zeros.data() + zeros.size(), out));
+  BOOST_CHECK_EQUAL(42U, out);
+}
+
+} // namespace
+} // namespace util
@@ -0,0 +1,167 @@
+#include "util/tokenize_piece.hh"
+
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#define UTIL_TOKENIZE_X86
+#endif
+
+namespace util {
+
+namespace {
+
+#ifdef UTIL_TOKENIZE_X86
+bool DetectSSSE3() {
+  // Static initializers may run before the CPU model is.
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("ssse3");
+}
+
+const bool kHaveSSSE3 = DetectSSSE3();
+
+// Bit i is set if begin[i] is in the set described by low and high.
+__attribute__((target("ssse3"))) inline unsigned int Classify(__m128i low, __m128i high, const char *begin) {
+  const __m128i nibble = _mm_set1_epi8(0x0f);
+  __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+  __m128i low_bits = _mm_shuffle_epi8(low, _mm_and_si128(bytes, nibble));
+  __m128i high_bits = _mm_shuffle_epi8(high, _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble));
+  __m128i none = _mm_cmpeq_epi8(_mm_and_si128(low_bits, high_bits), _mm_setzero_si128());
+  return ~_mm_movemask_epi8(none) & 0xffff;
+}
+
+// Returns the first member or where fewer than 16 bytes remain.
+__attribute__((target("ssse3"))) const char *FindSSSE3(const uint8_t *low_table, const uint8_t *high_table, const char *begin, const char *end) {
+  __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(low_table));
+  __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(high_table));
+  for (; end - begin >= 16; begin += 16) {
+    unsigned int found = Classify(low, high, begin);
+    if (found) return begin + __builtin_ctz(found);
+  }
+  return begin;
+}
+
+// Appends tokens ending before the last 16 bytes.  Returns where the current
+// token starts and sets scanned to where classification stopped.
+__attribute__((target("ssse3"))) const char *TokenizeSSSE3(const uint8_t *low_table, const uint8_t *high_table, const char *token, const char *end, const char *&scanned, std::vector<StringPiece> &out) {
+  __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(low_table));
+  __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(high_table));
+  const char *i = token;
+  // Tokens are collected without branching on whether they are empty.
+  StringPiece block[16];
+  for (; end - i >= 16; i += 16) {
+    std::size_t count = 0;
+    for (unsigned int found = Classify(low, high, i); found; found &= found - 1) {
+      const char *delimiter = i + __builtin_ctz(found);
+      block[count] = StringPiece(token, delimiter - token);
+      count += (delimiter != token);
+      token = delimiter + 1;
+    }
+    out.insert(out.end(), block, block + count);
+  }
+  scanned = i;
+  return token;
+}
+#endif
+
+} // namespace
+
+ByteSet::ByteSet(const bool *members) : exact_(true) {
+  memcpy(members_, members, sizeof(members_));
+  memset(low_, 0, sizeof(low_));
+  memset(high_, 0, sizeof(high_));
+  for (unsigned int c = 0; c < 256; ++c) {
+    if (members[c]) Add(c);
+  }
+}
+
+ByteSet::ByteSet(const StringPiece &chars) : exact_(true) {
+  memset(members_, 0, sizeof(members_));
+  memset(low_, 0, sizeof(low_));
+  memset(high_, 0, sizeof(high_));
+  for (int i = 0; i < chars.size(); ++i) {
+    members_[static_cast<unsigned char>(chars.data()[i])] = true;
+    Add(chars.data()[i]);
+  }
+}
+
+void ByteSet::Add(unsigned char c) {
+  if (!exact_) return;
+  unsigned int high = c >> 4;
+  if (!high_[high]) {
+    // Bits already given to other high nibbles.
+    unsigned int used = 0;
+    for (unsigned int i = 0; i < 16; ++i) used |= high_[i];
+    if (used == 0xff) {
+      exact_ = false;
+      return;
+    }
+    high_[high] = (used + 1) & ~used;
+  }
+  low_[c & 15] |= high_[high];
+}
+
+const char *ByteSet::FindLong(const char *begin, const char *end) const {
+#ifdef UTIL_TOKENIZE_X86
+  if (exact_ && kHaveSSSE3) begin = FindSSSE3(low_, high_, begin, end);
+#endif
+  for (; begin != end; ++begin) {
+    if (Contains(*begin)) return begin;
+  }
+  return end;
+}
+
+const ByteSet &ByteSet::Spaces() {
+  static const ByteSet spaces(kSpaces);
+  return spaces;
+}
+
+void Tokenize(const StringPiece &str, const ByteSet &delimiters, std::vector<StringPiece> &out) {
+  out.clear();
+  const char *token = str.data();
+  const char *i = token;
+  const char *const end = str.data() + str.size();
+#ifdef UTIL_TOKENIZE_X86
+  if (delimiters.exact_ && kHaveSSSE3) token = TokenizeSSSE3(delimiters.low_, delimiters.high_, token, end, i, out);
+#endif
+  for (; i != end; ++i) {
+    if (delimiters.Contains(*i)) {
+      if (i != token) out.push_back(StringPiece(token, i - token));
+      token = i + 1;
+    }
+  }
+  if (end != token) out.push_back(StringPiece(token, end - token));
+}
+
+const char *FindSubstring(const char *begin, const char *end, const char *needle, std::size_t length) {
+  if (length == 0) return begin;
+  if (static_cast<std::size_t>(end - begin) < length) return end;
+  if (length == 1) {
+    const void *found = memchr(begin, *needle, end - begin);
+    return found ? static_cast<const char*>(found) : end;
+  }
+  // Last position where the needle could start.
+  const char *const last = end - length;
+  const char *i = begin;
+#ifdef UTIL_TOKENIZE_X86
+  // Candidates match the first two bytes of the needle.
+  const __m128i first = _mm_set1_epi8(needle[0]), second = _mm_set1_epi8(needle[1]);
+  for (; last - i >= 16; i += 16) {
+    __m128i at = _mm_loadu_si128(reinterpret_cast<const __m128i*>(i));
+    __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(i + 1));
+    unsigned int candidates = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(at, first), _mm_cmpeq_epi8(next, second)));
+    for (; candidates; candidates &= candidates - 1) {
+      const char *start = i + __builtin_ctz(candidates);
+      if (!memcmp(start + 2, needle + 2, length - 2)) return start;
+    }
+  }
+#endif
+  for (; i <= last; ++i) {
+    const void *found = memchr(i, needle[0], last - i + 1);
+    if (!found) return end;
+    i = static_cast<const char*>(found);
+    if (!memcmp(i + 1, needle + 1, length - 1)) return i;
+  }
+  return end;
+}
+
+} // namespace util
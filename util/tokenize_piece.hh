@@ -8,6 +8,9 @@
 #include <algorithm>
 #include <cstring>
 #include <iterator>
+#include <vector>
+
+#include <stdint.h>
 
 namespace util {
 
@@ -18,13 +21,72 @@ class OutOfTokens : public Exception {
     ~OutOfTokens() throw() {}
 };
 
+/* A set of bytes that can be searched for many bytes at a time.  Besides a
+ * plain table, byte b is a member if low_[b & 15] & high_[b >> 4] is nonzero,
+ * which lets SSSE3 classify 16 bytes with two shuffles.  That is exact when the
+ * members have at most 8 distinct high nibbles, which covers ASCII punctuation
+ * and whitespace; larger sets are searched a byte at a time.
+ */
+class ByteSet {
+  public:
+    ByteSet() {}
+
+    // members is a 256-entry table like kSpaces.
+    explicit ByteSet(const bool *members);
+
+    explicit ByteSet(const StringPiece &chars);
+
+    bool Contains(unsigned char c) const { return members_[c]; }
+
+    // First member in [begin, end) or end.
+    const char *Find(const char *begin, const char *end) const {
+      // Tokens are usually short, so check a few bytes before paying for a call.
+      const char *stop = begin + std::min<std::size_t>(end - begin, kInlineBytes);
+      for (; begin != stop; ++begin) {
+        if (Contains(*begin)) return begin;
+      }
+      return begin == end ? end : FindLong(begin, end);
+    }
+
+    // The set for kSpaces, built once.
+    static const ByteSet &Spaces();
+
+  private:
+    friend void Tokenize(const StringPiece &str, const ByteSet &delimiters, std::vector<StringPiece> &out);
+
+    static const std::size_t kInlineBytes = 16;
+
+    void Add(unsigned char c);
+
+    const char *FindLong(const char *begin, const char *end) const;
+
+    bool members_[256];
+    uint8_t low_[16], high_[16];
+    bool exact_;
+};
+
+/* Split str at any delimiter, skipping empty tokens, and replace out with the
+ * tokens.  Same result as TokenIter<BoolCharacter, true> but classifies the
+ * whole string in bulk instead of searching once per token.
+ */
+void Tokenize(const StringPiece &str, const ByteSet &delimiters, std::vector<StringPiece> &out);
+
+// Like std::search.  Vectorized search for the first two bytes of needle.
+const char *FindSubstring(const char *begin, const char *end, const char *needle, std::size_t length);
+
 class SingleCharacter {
   public:
     SingleCharacter() {}
     explicit SingleCharacter(char delim) : delim_(delim) {}
 
     StringPiece Find(const StringPiece &in) const {
-      return StringPiece(std::find(in.data(), in.data() + in.size(), delim_), 1);
+      const char *end = in.data() + in.size();
+      // Tokens are usually short, so check a few bytes before calling memchr.
+      const char *stop = in.data() + std::min<std::size_t>(in.size(), 16);
+      const char *i = std::find(in.data(), stop, delim_);
+      if (i != stop || i == end) return StringPiece(i, 1);
+      const void *found = memchr(i, delim_, end - i);
+      return StringPiece(found ? static_cast<const char*>(found) : end, 1);
     }
 
   private:
@@ -38,7 +100,7 @@ class MultiCharacter {
     explicit MultiCharacter(const StringPiece &delimiter) : delimiter_(delimiter) {}
 
     StringPiece Find(const StringPiece &in) const {
-      return StringPiece(std::search(in.data(), in.data() + in.size(), delimiter_.data(), delimiter_.data() + delimiter_.size()), delimiter_.size());
+      return StringPiece(FindSubstring(in.data(), in.data() + in.size(), delimiter_.data(), delimiter_.size()), delimiter_.size());
     }
 
   private:
@@ -51,24 +113,28 @@ class AnyCharacter {
     explicit AnyCharacter(const StringPiece &chars) : chars_(chars) {}
 
     StringPiece Find(const StringPiece &in) const {
-      return StringPiece(std::find_first_of(in.data(), in.data() + in.size(), chars_.data(), chars_.data() + chars_.size()), 1);
+      return StringPiece(chars_.Find(in.data(), in.data() + in.size()), 1);
     }
 
   private:
-    StringPiece chars_;
+    ByteSet chars_;
 };
 
 class BoolCharacter {
   public:
     BoolCharacter() {}
 
-    explicit BoolCharacter(const bool *delimiter = kSpaces) { delimiter_ = delimiter; }
+    explicit BoolCharacter(const bool *delimiter = kSpaces) : delimiter_(delimiter), set_(delimiter == kSpaces ? &ByteSet::Spaces() : NULL) {}
 
     StringPiece Find(const StringPiece &in) const {
-      for (const char *i = in.data(); i != in.data() + in.size(); ++i) {
-        if (delimiter_[static_cast<unsigned char>(*i)]) return StringPiece(i, 1);
+      const char *end = in.data() + in.size();
+      const char *i = in.data();
+      if (set_) {
+        i = set_->Find(i, end);
+      } else {
+        for (; i != end && !delimiter_[static_cast<unsigned char>(*i)]; ++i) {}
       }
-      return StringPiece(in.data() + in.size(), 0);
+      return StringPiece(i, i == end ? 0 : 1);
     }
 
     template <unsigned Length> static void Build(const char (&characters)[Length], bool (&out)[256]) {
@@ -80,6 +146,8 @@ class BoolCharacter {
 
   private:
     const bool *delimiter_;
+    // Vectorized search for kSpaces; other tables are searched a byte at a time.
+    const ByteSet *set_;
 };
 
 class AnyCharacterLast {
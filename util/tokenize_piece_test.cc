@@ -4,7 +4,10 @@
 #define BOOST_TEST_MODULE TokenIteratorTest
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
 #include <iostream>
+#include <string>
+#include <vector>
 
 namespace util {
 namespace {
@@ -44,5 +47,71 @@ BOOST_AUTO_TEST_CASE(remove_empty_keep) {
   BOOST_CHECK(!it);
 }
 
+BOOST_AUTO_TEST_CASE(single_character_trailing) {
+  const char str[] = "ab cd  ef ";
+  std::vector<StringPiece> tokens;
+  for (TokenIter<SingleCharacter, true> it(str, ' '); it; ++it) tokens.push_back(*it);
+  BOOST_REQUIRE_EQUAL(3, tokens.size());
+  BOOST_CHECK_EQUAL("ab", tokens[0]);
+  BOOST_CHECK_EQUAL("cd", tokens[1]);
+  BOOST_CHECK_EQUAL("ef", tokens[2]);
+}
+
+// Deterministic text drawn from alphabet.
+std::string RandomText(const std::string &alphabet, std::size_t length, uint64_t seed) {
+  std::string ret;
+  for (std::size_t i = 0; i < length; ++i) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    ret += alphabet[(seed >> 33) % alphabet.size()];
+  }
+  return ret;
+}
+
+BOOST_AUTO_TEST_CASE(byte_set_matches_find_first_of) {
+  const std::string sets[] = {" ", " \t|", "aeiou", "\x80\xFF", "\x01\x11\x21\x31\x41\x51\x61\x71\x81\x91"};
+  for (const std::string &chars : sets) {
+    ByteSet set(chars);
+    for (std::size_t length = 0; length < 100; ++length) {
+      std::string text(RandomText("abcdefghijklmnopqrst\x80" + chars, length, length));
+      for (std::size_t start = 0; start <= text.size(); ++start) {
+        const char *begin = text.data() + start, *end = text.data() + text.size();
+        BOOST_CHECK(std::find_first_of(begin, end, chars.data(), chars.data() + chars.size()) == set.Find(begin, end));
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(byte_set_table) {
+  bool all_high[256];
+  for (unsigned int i = 0; i < 256; ++i) all_high[i] = (i >= 0x80) || i == ' ';
+  ByteSet set(all_high);
+  for (unsigned int i = 0; i < 256; ++i) BOOST_CHECK_EQUAL(all_high[i], set.Contains(i));
+  ByteSet spaces(ByteSet::Spaces());
+  for (unsigned int i = 0; i < 256; ++i) BOOST_CHECK_EQUAL(kSpaces[i], spaces.Contains(i));
+}
+
+BOOST_AUTO_TEST_CASE(tokenize_matches_iterator) {
+  std::vector<StringPiece> bulk;
+  for (std::size_t length = 0; length < 200; ++length) {
+    std::string text(RandomText("ab \t\n", length, length + 7));
+    Tokenize(text, ByteSet::Spaces(), bulk);
+    std::vector<StringPiece> iterated;
+    for (TokenIter<BoolCharacter, true> i(text, kSpaces); i; ++i) iterated.push_back(*i);
+    BOOST_CHECK_EQUAL(iterated.size(), bulk.size());
+    BOOST_CHECK(iterated == bulk);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(find_substring_matches_search) {
+  const std::string needles[] = {"", "a", "ab", "aab", "|||", "abababab", "baaaaaaaaaaaaaaaaaab"};
+  for (const std::string &needle : needles) {
+    for (std::size_t length = 0; length < 80; ++length) {
+      std::string text(RandomText("ab|", length, length * 3));
+      const char *begin = text.data(), *end = text.data() + text.size();
+      BOOST_CHECK(std::search(begin, end, needle.data(), needle.data() + needle.size()) == FindSubstring(begin, end, needle.data(), needle.size()));
+    }
+  }
+}
+
 } // namespace
 } // namespace util
@@ -0,0 +1,243 @@
+#include "util/trace.hh"
+
+#include "util/exception.hh"
+#include "util/file.hh"
+#include "util/file_stream.hh"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+
+namespace util {
+namespace trace {
+
+namespace detail {
+bool gEnabled = false;
+} // namespace detail
+
+namespace {
+
+struct Event {
+  const char *name;
+  uint64_t time;
+  int64_t value;
+  char phase;
+};
+
+struct Buffer {
+  explicit Buffer(uint32_t id_in) : written(0), id(id_in) {}
+
+  // Total events recorded; the last kEventsPerThread are in events.
+  std::atomic<uint64_t> written;
+  const uint32_t id;
+  // Guarded by State::mutex.
+  std::string name;
+  Event events[kEventsPerThread];
+};
+
+struct State {
+  State() : start(detail::Now()) {}
+
+  std::mutex mutex;
+  // Buffers are never freed so that threads which exited are still dumped.
+  std::vector<Buffer*> buffers;
+  std::string file;
+  const uint64_t start;
+};
+
+// Write end of the pipe DumpOnSignal pokes.
+int gSignalPipe = -1;
+
+State &GetState() {
+  static State *state = new State();
+  return *state;
+}
+
+thread_local Buffer *gLocal = NULL;
+
+Buffer &Local() {
+  if (UTIL_UNLIKELY(!gLocal)) {
+    State &state = GetState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    gLocal = new Buffer(state.buffers.size() + 1);
+    state.buffers.push_back(gLocal);
+  }
+  return *gLocal;
+}
+
+std::string FileName(const std::string &pattern) {
+  std::string ret;
+  for (std::size_t i = 0; i < pattern.size(); ++i) {
+    if (pattern[i] == '%' && i + 1 < pattern.size() && pattern[i + 1] == 'p') {
+      ret += std::to_string(getpid());
+      ++i;
+    } else {
+      ret += pattern[i];
+    }
+  }
+  return ret;
+}
+
+void WriteString(FileStream &out, const std::string &str) {
+  out << '"';
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      out << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      out << ' ';
+    } else {
+      out << c;
+    }
+  }
+  out << '"';
+}
+
+// Chrome wants microseconds.
+void WriteMicroseconds(FileStream &out, uint64_t ns) {
+  out << (ns / 1000) << '.';
+  unsigned int fraction = ns % 1000;
+  out << static_cast<char>('0' + fraction / 100) << static_cast<char>('0' + fraction / 10 % 10) << static_cast<char>('0' + fraction % 10);
+}
+
+void DumpLocked(State &state) {
+  std::string name(FileName(state.file));
+  std::string temp(name + ".tmp");
+  pid_t pid = getpid();
+  {
+    FileStream out(CreateOrThrow(temp.c_str()));
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    bool first = true;
+    for (const Buffer *buffer : state.buffers) {
+      if (!buffer->name.empty()) {
+        if (!first) out << ",\n";
+        first = false;
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << buffer->id << ",\"args\":{\"name\":";
+        WriteString(out, buffer->name);
+        out << "}}";
+      }
+      uint64_t end = buffer->written.load(std::memory_order_acquire);
+      uint64_t begin = end > kEventsPerThread ? end - kEventsPerThread : 0;
+      for (uint64_t i = begin; i < end; ++i) {
+        const Event &event = buffer->events[i % kEventsPerThread];
+        if (!first) out << ",\n";
+        first = false;
+        out << "{\"name\":";
+        WriteString(out, event.name);
+        out << ",\"ph\":\"" << event.phase << "\",\"pid\":" << pid << ",\"tid\":" << buffer->id << ",\"ts\":";
+        WriteMicroseconds(out, event.time - state.start);
+        if (event.phase == 'X') {
+          out << ",\"dur\":";
+          WriteMicroseconds(out, event.value);
+        } else {
+          out << ",\"args\":{\"value\":" << event.value << '}';
+        }
+        out << '}';
+      }
+    }
+    out << "\n]}\n";
+  }
+  UTIL_THROW_IF(rename(temp.c_str(), name.c_str()), ErrnoException, "Could not rename " << temp << " to " << name);
+}
+
+void DumpAtExit() {
+  try {
+    Dump();
+  } catch (const std::exception &e) {
+    std::cerr << "Writing trace failed: " << e.what() << std::endl;
+  }
+}
+
+extern "C" void DumpOnSignal(int) {
+  int saved = errno;
+  char c = 0;
+  // Only async-signal-safe work here; DumpThread does the rest.
+  if (write(gSignalPipe, &c, 1)) {}
+  errno = saved;
+}
+
+void DumpThread(int from) {
+  NameThread("trace dump");
+  char c;
+  while (true) {
+    ssize_t got = read(from, &c, 1);
+    if (got == -1 && errno == EINTR) continue;
+    if (got <= 0) return;
+    DumpAtExit();
+  }
+}
+
+struct StartFromEnvironment {
+  StartFromEnvironment() {
+    const char *file = getenv("PREPROCESS_TRACE");
+    if (file && *file) Start(file);
+  }
+} gStartFromEnvironment;
+
+} // namespace
+
+namespace detail {
+void Record(char phase, const char *name, uint64_t time, int64_t value) {
+  Buffer &buffer = Local();
+  uint64_t at = buffer.written.load(std::memory_order_relaxed);
+  Event &event = buffer.events[at % kEventsPerThread];
+  event.name = name;
+  event.time = time;
+  event.value = value;
+  event.phase = phase;
+  buffer.written.store(at + 1, std::memory_order_release);
+}
+} // namespace detail
+
+void Start(const char *file) {
+  State &state = GetState();
+  {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    UTIL_THROW_IF2(gSignalPipe != -1, "Tracing can only be started once");
+    state.file = file;
+    int fds[2];
+    UTIL_THROW_IF(pipe2(fds, O_CLOEXEC), ErrnoException, "Creating pipe for trace signals");
+    gSignalPipe = fds[1];
+    detail::gEnabled = true;
+    std::thread(DumpThread, fds[0]).detach();
+  }
+  struct sigaction action;
+  action.sa_handler = DumpOnSignal;
+  sigemptyset(&action.sa_mask);
+  action.sa_flags = SA_RESTART;
+  UTIL_THROW_IF(sigaction(SIGUSR2, &action, NULL), ErrnoException, "Installing SIGUSR2 handler for tracing");
+  atexit(DumpAtExit);
+}
+
+void Dump() {
+  State &state = GetState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  if (state.file.empty()) return;
+  DumpLocked(state);
+}
+
+void Stop() {
+  State &state = GetState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  detail::gEnabled = false;
+  state.file.clear();
+}
+
+void NameThread(const char *name) {
+  if (!Enabled()) return;
+  Buffer &buffer = Local();
+  std::lock_guard<std::mutex> lock(GetState().mutex);
+  buffer.name = name;
+}
+
+} // namespace trace
+} // namespace util
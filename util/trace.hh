@@ -0,0 +1,101 @@
+#ifndef UTIL_TRACE_H
+#define UTIL_TRACE_H
+
+/* Lightweight profiling spans for finding where a pipeline spends its time.
+ *
+ * Build with cmake -DENABLE_TRACE=ON to compile in the UTIL_TRACE_* macros;
+ * otherwise they expand to nothing.  Then run with
+ *   PREPROCESS_TRACE=trace.json warc_parallel -j 64 ./process.sh
+ * to record spans (reads, writes, queue waits, child I/O, ...) into per-thread
+ * ring buffers.  The trace is written in Chrome trace format, which
+ * chrome://tracing and https://ui.perfetto.dev open, at exit and whenever the
+ * process receives SIGUSR2.  %p in the file name is replaced with the process
+ * id, which keeps traced child processes from overwriting their parent's file.
+ *
+ * Timestamps are CLOCK_MONOTONIC, the clock perf record -k CLOCK_MONOTONIC
+ * uses, so spans can be lined up with perf samples.
+ */
+
+#include <cstddef>
+
+#include <stdint.h>
+#include <time.h>
+
+namespace util {
+namespace trace {
+
+namespace detail {
+// Set by Start.  Read without synchronization: spans that race with Start may
+// or may not be recorded.
+extern bool gEnabled;
+
+inline uint64_t Now() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+// phase is 'X' for a span with value = duration in ns or 'C' for a counter.
+void Record(char phase, const char *name, uint64_t time, int64_t value);
+} // namespace detail
+
+// Number of events each thread keeps; older ones are overwritten.
+const std::size_t kEventsPerThread = 1 << 14;
+
+// Start recording, writing to file (see %p above) at exit and on SIGUSR2.
+// Called before main with $PREPROCESS_TRACE if it is set.  Throws if called
+// twice.
+void Start(const char *file);
+
+inline bool Enabled() { return detail::gEnabled; }
+
+// Stop recording and do not write at exit or on SIGUSR2.  Start may not be
+// called again.
+void Stop();
+
+// Write the events recorded so far.  Threads keep recording while this runs,
+// so events from busy threads may be torn or missing.
+void Dump();
+
+// Label the calling thread in the trace.
+void NameThread(const char *name);
+
+// Records the time from construction to destruction.  name must outlive the
+// process, typically a string literal.
+class Span {
+  public:
+    explicit Span(const char *name) : name_(name), start_(Enabled() ? detail::Now() : 0) {}
+
+    ~Span() {
+      if (start_) detail::Record('X', name_, start_, detail::Now() - start_);
+    }
+
+  private:
+    Span(const Span &) = delete;
+    Span &operator=(const Span &) = delete;
+
+    const char *name_;
+    const uint64_t start_;
+};
+
+// Record the current value of a counter, plotted over time.
+inline void Counter(const char *name, int64_t value) {
+  if (Enabled()) detail::Record('C', name, detail::Now(), value);
+}
+
+} // namespace trace
+} // namespace util
+
+#ifdef UTIL_TRACE
+#define UTIL_TRACE_CONCAT_IMPL(a, b) a##b
+#define UTIL_TRACE_CONCAT(a, b) UTIL_TRACE_CONCAT_IMPL(a, b)
+#define UTIL_TRACE_SPAN(name) util::trace::Span UTIL_TRACE_CONCAT(util_trace_span_, __LINE__)(name)
+#define UTIL_TRACE_COUNTER(name, value) util::trace::Counter((name), (value))
+#define UTIL_TRACE_THREAD(name) util::trace::NameThread(name)
+#else
+#define UTIL_TRACE_SPAN(name) do {} while (0)
+#define UTIL_TRACE_COUNTER(name, value) do {} while (0)
+#define UTIL_TRACE_THREAD(name) do {} while (0)
+#endif
+
+#endif // UTIL_TRACE_H
@@ -0,0 +1,61 @@
+#define BOOST_TEST_MODULE TraceTest
+
+#include "util/trace.hh"
+#include "util/file.hh"
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <signal.h>
+#include <unistd.h>
+
+namespace util { namespace trace { namespace {
+
+std::string ReadFile(const std::string &name) {
+  scoped_fd file(OpenReadOrThrow(name.c_str()));
+  std::string ret(SizeOrThrow(file.get()), 0);
+  if (!ret.empty()) ReadOrThrow(file.get(), &ret[0], ret.size());
+  return ret;
+}
+
+BOOST_AUTO_TEST_CASE(SpansAndSignal) {
+  std::string pattern(DefaultTempDirectory() + "trace_test.%p.json");
+  std::string name(DefaultTempDirectory() + "trace_test." + std::to_string(getpid()) + ".json");
+  Start(pattern.c_str());
+  BOOST_CHECK(Enabled());
+  {
+    Span outer("outer span");
+    std::thread worker([] {
+      NameThread("worker \"one\"");
+      Span inner("inner span");
+      Counter("queue depth", 42);
+    });
+    worker.join();
+  }
+  Dump();
+  std::string trace(ReadFile(name));
+  BOOST_CHECK_EQUAL(0, trace.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+  BOOST_CHECK(trace.find("\"name\":\"outer span\",\"ph\":\"X\"") != std::string::npos);
+  BOOST_CHECK(trace.find("\"name\":\"inner span\",\"ph\":\"X\"") != std::string::npos);
+  BOOST_CHECK(trace.find("\"name\":\"queue depth\",\"ph\":\"C\"") != std::string::npos);
+  BOOST_CHECK(trace.find("\"args\":{\"value\":42}") != std::string::npos);
+  BOOST_CHECK(trace.find("\"args\":{\"name\":\"worker \\\"one\\\"\"}") != std::string::npos);
+  BOOST_CHECK_EQUAL("\n]}\n", trace.substr(trace.size() - 4));
+
+  // SIGUSR2 dumps from a background thread.
+  { Span after("after signal"); }
+  BOOST_REQUIRE_EQUAL(0, unlink(name.c_str()));
+  BOOST_REQUIRE_EQUAL(0, raise(SIGUSR2));
+  for (unsigned i = 0; i < 500 && access(name.c_str(), F_OK); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  BOOST_CHECK(ReadFile(name).find("\"name\":\"after signal\"") != std::string::npos);
+  Stop();
+  BOOST_CHECK(!Enabled());
+  unlink(name.c_str());
+}
+
+}}} // namespaces
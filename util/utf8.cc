@@ -10,18 +10,24 @@
 #include <boost/unordered_map.hpp>
 #include <boost/utility.hpp>
 
+#include <unicode/bytestream.h>
+#include <unicode/normalizer2.h>
 #include <unicode/normlzr.h>
 #include <unicode/ucasemap.h>
 #include <unicode/uchar.h>
 #include <unicode/unistr.h>
 #include <unicode/utf8.h>
 #include <unicode/utypes.h>
+#include <unicode/uvernum.h>
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <vector>
 
 #include <err.h>
+#include <stdint.h>
 
 using U_ICU_NAMESPACE::UnicodeString;
 
@@ -101,10 +107,51 @@ class CaseMapWrap : boost::noncopyable {
 
 CaseMapWrap kCaseMap;
 
+// Lowercase of every two-byte code point, U+0080 through U+07FF, as ICU
+// computes it for that code point alone.  This covers Latin-1, Latin Extended,
+// Greek, and Cyrillic.
+class TwoByteLower : boost::noncopyable {
+  public:
+    struct Entry {
+      // UTF-8.  Lowercase of a two-byte code point is at most three bytes.
+      char bytes[3];
+      // 0 if the answer depends on context, so ICU has to see the whole string.
+      unsigned char length;
+    };
+
+    void Init(const UCaseMap *csm) {
+      for (UChar32 c = 0x80; c < 0x800; ++c) {
+        Entry &entry = table_[c - 0x80];
+        entry.length = 0;
+        // Final sigma depends on the following letter.  Combining dot above
+        // depends on the preceding letter in Turkish and Lithuanian.
+        if (c == 0x3A3 || c == 0x307) continue;
+        char from[2] = {static_cast<char>(0xC0 | (c >> 6)), static_cast<char>(0x80 | (c & 0x3F))};
+        char to[8];
+        UErrorCode err = U_ZERO_ERROR;
+        int32_t length = ucasemap_utf8ToLower(csm, to, sizeof(to), from, sizeof(from), &err);
+        if (U_FAILURE(err) || length < 1 || length > 3) continue;
+        std::copy(to, to + length, entry.bytes);
+        entry.length = length;
+      }
+    }
+
+    // lead and trail are the bytes of a well-formed two-byte sequence.
+    const Entry &Get(unsigned char lead, unsigned char trail) const {
+      return table_[((lead & 0x1F) << 6 | (trail & 0x3F)) - 0x80];
+    }
+
+  private:
+    Entry table_[0x800 - 0x80];
+};
+
+TwoByteLower kTwoByteLower;
+
 boost::once_flag CaseMapFlag = BOOST_ONCE_INIT;
 
 void InitCaseMap() {
   kCaseMap.Init();
+  kTwoByteLower.Init(kCaseMap.Get());
 }
 
 const UCaseMap *GetCaseMap() {
@@ -112,25 +159,103 @@ const UCaseMap *GetCaseMap() {
   return kCaseMap.Get();
 }
 
+const uint64_t kHighBits = 0x8080808080808080ULL;
+
+// Lowercase ASCII eight bytes at a time.  Each byte is below 0x80, so adding to
+// it does not carry into the next byte.
+inline uint64_t LowerASCIIWord(uint64_t word) {
+  const uint64_t kOnes = 0x0101010101010101ULL;
+  // High bit set in bytes >= 'A'.
+  uint64_t at_least_a = word + kOnes * (0x80 - 'A');
+  // High bit set in bytes > 'Z'.
+  uint64_t above_z = word + kOnes * (0x80 - 'Z' - 1);
+  uint64_t upper = (at_least_a ^ above_z) & kHighBits;
+  return word | (upper >> 2);
+}
+
+// First byte with the high bit set, or end.
+const char *FirstNonASCII(const char *i, const char *end) {
+  uint64_t word;
+  for (; end - i >= 8; i += 8) {
+    std::memcpy(&word, i, 8);
+    if (word & kHighBits) break;
+  }
+  for (; i != end; ++i) {
+    if (*i & 0x80) return i;
+  }
+  return end;
+}
+
+// Lowercase with ICU, writing to [out, out + capacity).  Returns the length
+// of the lowercase, which is more than capacity if it did not fit.
+std::size_t ToLowerICU(const StringPiece &whole, const char *from, const char *from_end, char *out, std::size_t capacity) {
+  UErrorCode err = U_ZERO_ERROR;
+  int32_t need = ucasemap_utf8ToLower(GetCaseMap(), out, static_cast<int32_t>(std::min<std::size_t>(capacity, INT32_MAX)), from, from_end - from, &err);
+  if (U_FAILURE(err) && err != U_BUFFER_OVERFLOW_ERROR) throw NotUTF8Exception(whole, err);
+  return need;
+}
+
 } // namespace
 
-void ToLower(const StringPiece &in, std::string &out) {
-  const UCaseMap *csm = GetCaseMap();
-  while (true) {
-    UErrorCode err_lower = U_ZERO_ERROR;
-    size_t need = ucasemap_utf8ToLower(csm, &out[0], out.size(), in.data(), in.size(), &err_lower);
-    if (err_lower == U_BUFFER_OVERFLOW_ERROR) {
-      // Hopefully ensure convergence.
-      out.resize(std::max(out.size(), need) + 10);
-    } else if (U_FAILURE(err_lower)) {
-      throw NotUTF8Exception(in, err_lower);
-    } else if (need > out.size()) {
-      out.resize(need + 10);
-    } else {
-      out.resize(need);
-      return;
+std::size_t ToLower(const StringPiece &in, char *out, std::size_t capacity) {
+  // Also fills kTwoByteLower.
+  GetCaseMap();
+  const char *i = in.data();
+  const char *const end = i + in.size();
+  char *o = out;
+  char *const out_end = out + capacity;
+  while (i != end) {
+    // ASCII eight bytes at a time.
+    uint64_t word;
+    while (end - i >= 8 && out_end - o >= 8) {
+      std::memcpy(&word, i, 8);
+      if (word & kHighBits) break;
+      word = LowerASCIIWord(word);
+      std::memcpy(o, &word, 8);
+      i += 8;
+      o += 8;
+    }
+    if (i == end) break;
+    unsigned char c = *i;
+    if (c < 0x80) {
+      if (o == out_end) break;
+      *o++ = (c >= 'A' && c <= 'Z') ? (c + ('a' - 'A')) : c;
+      ++i;
+      continue;
+    }
+    if (c >= 0xC2 && c <= 0xDF && end - i >= 2 && (static_cast<unsigned char>(i[1]) & 0xC0) == 0x80) {
+      const TwoByteLower::Entry &entry = kTwoByteLower.Get(c, i[1]);
+      if (entry.length && out_end - o >= entry.length) {
+        o = std::copy(entry.bytes, entry.bytes + entry.length, o);
+        i += 2;
+        continue;
+      }
+      if (!entry.length) {
+        // Context matters, so ICU has to see all of it.
+        return ToLowerICU(in, in.data(), end, out, capacity);
+      }
+      break;
+    }
+    // Longer or invalid sequences go to ICU, unless the rest contains a
+    // capital sigma that would need to see what came before.
+    if (std::search(i, end, "\xCE\xA3", "\xCE\xA3" + 2) != end) {
+      return ToLowerICU(in, in.data(), end, out, capacity);
     }
+    return (o - out) + ToLowerICU(in, i, end, o, out_end - o);
+  }
+  if (i == end) return o - out;
+  // Out of space.  Ask ICU how much is needed.
+  return ToLowerICU(in, in.data(), end, NULL, 0);
+}
+
+void ToLower(const StringPiece &in, std::string &out) {
+  out.resize(in.size());
+  std::size_t need = ToLower(in, &out[0], out.size());
+  if (need > out.size()) {
+    out.resize(need);
+    need = ToLower(in, &out[0], out.size());
   }
+  out.resize(need);
 }
 
 void Normalize(const UnicodeString &in, UnicodeString &out) {
@@ -144,6 +269,28 @@ void Normalize(const UnicodeString &in, UnicodeString &out) {
 }
 
 void Normalize(const StringPiece &in, std::string &out) {
+  const char *const end = in.data() + in.size();
+  const char *non_ascii = FirstNonASCII(in.data(), end);
+  // ASCII is already NFKC.
+  if (non_ascii == end) {
+    out.assign(in.data(), in.size());
+    return;
+  }
+#if U_ICU_VERSION_MAJOR_NUM >= 60
+  // normalizeUTF8 copies spans that pass the quick check and only normalizes
+  // the rest.  It passes ill-formed bytes through where the UnicodeString
+  // path below replaces them with U+FFFD, so it only sees valid UTF-8.
+  if (IsUTF8(StringPiece(non_ascii, end - non_ascii))) {
+    UErrorCode err = U_ZERO_ERROR;
+    const U_ICU_NAMESPACE::Normalizer2 *nfkc = U_ICU_NAMESPACE::Normalizer2::getNFKCInstance(err);
+    if (U_FAILURE(err)) throw NormalizeException(in, err);
+    out.clear();
+    U_ICU_NAMESPACE::StringByteSink<std::string> sink(&out);
+    nfkc->normalizeUTF8(0, in, sink, NULL, err);
+    if (U_FAILURE(err)) throw NormalizeException(in, err);
+    return;
+  }
+#endif
   UnicodeString asuni(UnicodeString::fromUTF8(in));
   if (asuni.isBogus()) throw NotUTF8Exception(in);
   UnicodeString normalized;
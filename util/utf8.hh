@@ -5,6 +5,7 @@
 
 #include "util/string_piece.hh"
 
+#include <cstddef>
 #include <exception>
 #include <string>
 
@@ -68,7 +69,17 @@ bool IsPunctuation(const StringPiece &text);
 // TODO: Implement these in a way that doesn't botch Turkish.
 void ToLower(const StringPiece &in, std::string &out);
 
+/* Lowercase into a caller-provided buffer without allocating.  Returns the
+ * length of the lowercase text.  If that is more than capacity, the buffer
+ * holds an incomplete result and the call should be repeated with a larger
+ * buffer.  ASCII and two-byte characters are handled here; ICU sees text with
+ * longer characters.  Results are the same as ICU's.
+ */
+std::size_t ToLower(const StringPiece &in, char *out, std::size_t capacity);
+
 void Normalize(const U_ICU_NAMESPACE::UnicodeString &in, U_ICU_NAMESPACE::UnicodeString &out);
+// NFKC.  ASCII and text that is already normalized are copied without
+// converting to UTF-16.  Ill-formed UTF-8 becomes U+FFFD.
 void Normalize(const StringPiece &in, std::string &out);
 
 class FlattenData;
@@ -3,6 +3,11 @@
 #define BOOST_TEST_MODULE UTF8Test
 #include <boost/test/unit_test.hpp>
 
+#include <unicode/ucasemap.h>
+#include <unicode/unistr.h>
+
+#include <string>
+
 #define CHECK_LOWER(ref, from) { \
   std::string out; \
   ToLower(from, out); \
@@ -34,10 +39,81 @@ BOOST_AUTO_TEST_CASE(Accents) {
   CHECK_LOWER("ôæðø", "ôÆÐØ");
 }
 
+BOOST_AUTO_TEST_CASE(ASCIIThenAccents) {
+  CHECK_LOWER("foo ôæðø bar", "FOO ôÆÐØ BAR");
+  CHECK_LOWER("", "");
+}
+
 BOOST_AUTO_TEST_CASE(Thorn) {
   CHECK_LOWER("þ", "Þ");
 }
 
+// What ToLower did before it had fast paths.
+std::string ICULower(const std::string &in) {
+  UErrorCode err = U_ZERO_ERROR;
+  UCaseMap *csm = ucasemap_open(NULL, 0, &err);
+  BOOST_REQUIRE(U_SUCCESS(err));
+  std::string out(in.size() * 3 + 10, 0);
+  int32_t need = ucasemap_utf8ToLower(csm, &out[0], out.size(), in.data(), in.size(), &err);
+  ucasemap_close(csm);
+  BOOST_REQUIRE(U_SUCCESS(err));
+  out.resize(need);
+  return out;
+}
+
+std::string Encode(UChar32 c) {
+  char buf[4];
+  int32_t length = 0;
+  UBool error = false;
+  U8_APPEND(buf, length, 4, c, error);
+  BOOST_REQUIRE(!error);
+  return std::string(buf, length);
+}
+
+BOOST_AUTO_TEST_CASE(LongASCII) {
+  CHECK_LOWER("the quick brown fox jumps over the lazy dog @[`{ 0123456789", "THE QUICK Brown FOX jumps OVER the LAZY dog @[`{ 0123456789");
+}
+
+BOOST_AUTO_TEST_CASE(SpecialCasing) {
+  // Lowercase is longer than the input.
+  CHECK_LOWER("i\xCC\x87stanbul", "\xC4\xB0STANBUL");
+  CHECK_LOWER("\xE2\xB1\xA5", "\xC8\xBA");
+  // Final sigma.
+  CHECK_LOWER("\xCE\xBF\xCE\xB4\xCF\x8C\xCF\x82 \xCF\x83\xCE\xB1", "\xCE\x9F\xCE\x94\xCE\x8C\xCE\xA3 \xCE\xA3\xCE\x91");
+}
+
+BOOST_AUTO_TEST_CASE(MatchesICU) {
+  for (UChar32 c = 0x80; c < 0x800; ++c) {
+    const std::string encoded(Encode(c));
+    const std::string contexts[] = {encoded, "AB" + encoded + "CD", encoded + "\xCE\xA3", "\xCE\x91" + encoded + "\xE4\xB8\xAD" + encoded + "X", "\xE2\x84\xAA" + encoded + "\xCE\xA3 " + encoded};
+    for (const std::string &text : contexts) {
+      std::string out;
+      ToLower(text, out);
+      BOOST_CHECK_EQUAL(ICULower(text), out);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(CallerBuffer) {
+  const std::string text("ABC\xC3\x84\xC4\xB0xyz\xE4\xB8\xADQ");
+  const std::string expect(ICULower(text));
+  char buffer[64];
+  for (std::size_t capacity = 0; capacity <= expect.size(); ++capacity) {
+    BOOST_CHECK_EQUAL(expect.size(), ToLower(text, buffer, capacity));
+  }
+  BOOST_CHECK_EQUAL(expect, std::string(buffer, expect.size()));
+}
+
+// ICU passes ill-formed bytes through.
+BOOST_AUTO_TEST_CASE(LowerNotUTF8) {
+  const std::string texts[] = {"AB\xC3", "\xC3\xC3\x84", "\xC0\xAF\xFF\x80Z", "\xE4\xB8Z\xC3\x84"};
+  for (const std::string &text : texts) {
+    std::string out;
+    ToLower(text, out);
+    BOOST_CHECK_EQUAL(ICULower(text), out);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(NormalizeASCII) {
   CHECK_NORMALIZE("foo", "foo");
 }
@@ -55,6 +131,39 @@ BOOST_AUTO_TEST_CASE(NormalizeFive) {
   CHECK_NORMALIZE("5", "⁵");
 }
 
+// What Normalize did before it had fast paths.
+std::string ICUNormalize(const std::string &in) {
+  U_ICU_NAMESPACE::UnicodeString normalized;
+  Normalize(U_ICU_NAMESPACE::UnicodeString::fromUTF8(in), normalized);
+  std::string out;
+  normalized.toUTF8String(out);
+  return out;
+}
+
+BOOST_AUTO_TEST_CASE(NormalizeMatchesICU) {
+  std::string out;
+  for (UChar32 c = 0x80; c < 0x10000; ++c) {
+    if (c >= 0xD800 && c < 0xE000) continue;
+    const std::string encoded(Encode(c));
+    // With a combining acute accent and after a letter it may compose with.
+    const std::string contexts[] = {"x" + encoded + "y", encoded + "\xCC\x81", "e" + encoded};
+    for (const std::string &text : contexts) {
+      Normalize(text, out);
+      BOOST_CHECK_EQUAL(ICUNormalize(text), out);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(NormalizeNotUTF8) {
+  const std::string texts[] = {"a\xC3", "\xEF\xAC\x81\xFF", "\xC0\xAFx", "\xED\xA0\x80z"};
+  std::string out;
+  for (const std::string &text : texts) {
+    Normalize(text, out);
+    BOOST_CHECK_EQUAL(ICUNormalize(text), out);
+  }
+  CHECK_NORMALIZE("a\xEF\xBF\xBD", "a\xC3");
+}
+
 BOOST_AUTO_TEST_CASE(FlattenEnglish) {
   CHECK_FLATTEN("\"foo bar\" '", "«foo bar» '", "en");
 }